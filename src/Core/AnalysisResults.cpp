@@ -0,0 +1,220 @@
+#include "AnalysisResults.h"
+#include <QDir>
+#include <QDateTime>
+#include <QRegularExpression>
+#include <QtNumeric>
+#include <QDebug>
+
+namespace {
+
+// "[Parsed_astats_0 @ 0x6000...] Overall" → filter "astats", text "Overall"
+const QRegularExpression& prefixRe() {
+    static const QRegularExpression re(R"(^\[(?:Parsed_)?([a-z0-9]+?)(?:_\d+)? @ [^\]]*\]\s*(.*)$)");
+    return re;
+}
+
+// First number in a string ("-1.234567", "24/24", "-23.0 LUFS")
+bool leadingNumber(const QString& text, double* value) {
+    static const QRegularExpression numberRe(R"([-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?|[-+]?inf)");
+    auto match = numberRe.match(text);
+    if (!match.hasMatch()) return false;
+    QString token = match.captured(0);
+    if (token.endsWith("inf")) {
+        *value = token.startsWith('-') ? -qInf() : qInf();
+        return true;
+    }
+    bool ok = false;
+    *value = token.toDouble(&ok);
+    return ok;
+}
+
+// astats "Overall" labels → columns
+const QHash<QString, QString>& astatsColumns() {
+    static const QHash<QString, QString> map = {
+        {"DC offset",           "astats_dc_offset"},
+        {"Peak level dB",       "astats_peak_db"},
+        {"RMS level dB",        "astats_rms_db"},
+        {"RMS peak dB",         "astats_rms_peak_db"},
+        {"RMS trough dB",       "astats_rms_trough_db"},
+        {"Crest factor",        "astats_crest_factor"},
+        {"Flat factor",         "astats_flat_factor"},
+        {"Peak count",          "astats_peak_count"},
+        {"Noise floor dB",      "astats_noise_floor_db"},
+        {"Bit depth",           "astats_bit_depth"},
+        {"Dynamic range",       "astats_dynamic_range"},
+        {"Zero crossings rate", "astats_zero_crossings_rate"},
+        {"Number of samples",   "astats_samples"},
+    };
+    return map;
+}
+
+} // namespace
+
+// ========== PARSER ==========
+
+const QStringList& AnalysisResultParser::columns() {
+    static const QStringList cols = {
+        "astats_dc_offset", "astats_peak_db", "astats_rms_db", "astats_rms_peak_db",
+        "astats_rms_trough_db", "astats_crest_factor", "astats_flat_factor",
+        "astats_peak_count", "astats_noise_floor_db", "astats_bit_depth",
+        "astats_dynamic_range", "astats_zero_crossings_rate", "astats_samples",
+        "volume_mean_db", "volume_max_db",
+        "silence_count", "silence_total_s", "silence_first_start_s",
+        "dr_overall",
+        "replaygain_track_gain_db", "replaygain_track_peak",
+    };
+    return cols;
+}
+
+void AnalysisResultParser::feed(const QString& output) {
+    QString text = m_partial + output;
+    int lastNewline = text.lastIndexOf('\n');
+    if (lastNewline < 0) {
+        m_partial = text;
+        return;
+    }
+    m_partial = text.mid(lastNewline + 1);
+
+    const QStringList lines = text.left(lastNewline).split('\n');
+    for (const QString& line : lines) {
+        parseLine(line.trimmed());
+    }
+}
+
+QHash<QString, double> AnalysisResultParser::take() {
+    if (!m_partial.isEmpty()) {
+        parseLine(m_partial.trimmed());
+        m_partial.clear();
+    }
+    QHash<QString, double> result;
+    result.swap(m_values);
+    m_section = Section::None;
+    return result;
+}
+
+void AnalysisResultParser::parseLine(const QString& line) {
+    if (line.isEmpty()) return;
+
+    double value = 0.0;
+    auto match = prefixRe().match(line);
+
+    if (!match.hasMatch()) return;
+
+    const QString filter = match.captured(1);
+    const QString text = match.captured(2);
+
+    if (filter == "astats") {
+        if (text.startsWith("Channel:")) {
+            m_section = Section::AstatsChannel;
+        } else if (text == "Overall") {
+            m_section = Section::AstatsOverall;
+        } else if (m_section == Section::AstatsOverall) {
+            int colon = text.indexOf(':');
+            if (colon > 0) {
+                QString column = astatsColumns().value(text.left(colon).trimmed());
+                if (!column.isEmpty() && leadingNumber(text.mid(colon + 1), &value)) {
+                    m_values[column] = value;
+                }
+            }
+        }
+        return;
+    }
+
+    m_section = Section::None;
+
+    if (filter == "volumedetect") {
+        if (text.startsWith("mean_volume:") && leadingNumber(text.mid(12), &value)) {
+            m_values["volume_mean_db"] = value;
+        } else if (text.startsWith("max_volume:") && leadingNumber(text.mid(11), &value)) {
+            m_values["volume_max_db"] = value;
+        }
+    } else if (filter == "silencedetect") {
+        if (text.startsWith("silence_start:") && leadingNumber(text.mid(14), &value)) {
+            m_values["silence_count"] = m_values.value("silence_count") + 1;
+            if (!m_values.contains("silence_first_start_s")) {
+                m_values["silence_first_start_s"] = value;
+            }
+        } else {
+            int durationPos = text.indexOf("silence_duration:");
+            if (durationPos >= 0 && leadingNumber(text.mid(durationPos + 17), &value)) {
+                m_values["silence_total_s"] = m_values.value("silence_total_s") + value;
+            }
+        }
+    } else if (filter == "drmeter") {
+        if (text.startsWith("Overall DR:") && leadingNumber(text.mid(11), &value)) {
+            m_values["dr_overall"] = value;
+        }
+    } else if (filter == "replaygain") {
+        if (text.startsWith("track_gain") && leadingNumber(text.mid(text.indexOf('=') + 1), &value)) {
+            m_values["replaygain_track_gain_db"] = value;
+        } else if (text.startsWith("track_peak") && leadingNumber(text.mid(text.indexOf('=') + 1), &value)) {
+            m_values["replaygain_track_peak"] = value;
+        }
+    }
+}
+
+// ========== WRITER ==========
+
+AnalysisResultsWriter::AnalysisResultsWriter(QObject* parent)
+    : QObject(parent)
+{
+}
+
+AnalysisResultsWriter::~AnalysisResultsWriter() {
+    close();
+}
+
+bool AnalysisResultsWriter::open(const QString& outputFolder) {
+    close();
+
+    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd_HH-mm-ss");
+    m_filePath = QDir(outputFolder).filePath(QString("_FFAB_analysis_%1.csv").arg(timestamp));
+
+    m_file.setFileName(m_filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "AnalysisResultsWriter: Failed to open" << m_filePath;
+        m_filePath.clear();
+        return false;
+    }
+
+    m_stream.setDevice(&m_file);
+    m_stream << "file,output,status," << AnalysisResultParser::columns().join(',') << "\n";
+    m_rowCount = 0;
+
+    qDebug() << "AnalysisResultsWriter: Opened" << m_filePath;
+    return true;
+}
+
+void AnalysisResultsWriter::writeRecord(const AnalysisRecord& record) {
+    if (!m_file.isOpen()) return;
+
+    QStringList row;
+    row << csvField(record.inputFile)
+        << csvField(record.outputFile)
+        << (record.success ? "ok" : "failed");
+
+    for (const QString& column : AnalysisResultParser::columns()) {
+        auto it = record.values.constFind(column);
+        row << (it == record.values.constEnd() ? QString() : QString::number(it.value(), 'g', 10));
+    }
+
+    m_stream << row.join(',') << "\n";
+
+    // Flush periodically — a crash mid-batch still leaves usable rows
+    if (++m_rowCount % 64 == 0) m_stream.flush();
+}
+
+void AnalysisResultsWriter::close() {
+    if (m_file.isOpen()) {
+        m_stream.flush();
+        m_file.close();
+        qDebug() << "AnalysisResultsWriter: Closed" << m_filePath << "—" << m_rowCount << "rows";
+    }
+}
+
+QString AnalysisResultsWriter::csvField(const QString& text) {
+    if (!text.contains(',') && !text.contains('"') && !text.contains('\n')) return text;
+    QString escaped = text;
+    escaped.replace("\"", "\"\"");
+    return "\"" + escaped + "\"";
+}
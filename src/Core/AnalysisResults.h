@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QObject>
+#include <QFile>
+#include <QTextStream>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+/**
+ * AnalysisRecord - Typed measurements for one processed file
+ *
+ * Keys are the column names from AnalysisResultParser::columns(); missing
+ * measurements (filter not in the chain, or no output) are simply absent.
+ */
+struct AnalysisRecord {
+    QString inputFile;
+    QString outputFile;
+    bool success = false;
+    QHash<QString, double> values;
+
+    bool isEmpty() const { return values.isEmpty(); }
+};
+
+/**
+ * AnalysisResultParser - Extracts analysis filter results from FFmpeg stderr
+ *
+ * Fed incrementally with the same output chunks that go to LogFileWriter.
+ * Recognises the info-level reports of:
+ *   - astats         Overall section (peak/RMS/crest/noise floor/...)
+ *   - volumedetect   mean_volume, max_volume
+ *   - silencedetect  count, total duration, first start
+ *   - drmeter        Overall DR
+ *   - replaygain     track_gain, track_peak
+ *
+ * Batch commands for a chain with these filters run at log level info
+ * (FilterChain::hasAnalysisFilters).
+ */
+class AnalysisResultParser {
+public:
+    void feed(const QString& output);
+
+    // Measurements collected since the last take(); resets the parser
+    QHash<QString, double> take();
+
+    // Fixed column schema, in output order
+    static const QStringList& columns();
+
+private:
+    void parseLine(const QString& line);
+
+    enum class Section { None, AstatsChannel, AstatsOverall };
+
+    QHash<QString, double> m_values;
+    Section m_section = Section::None;
+    QString m_partial;  // incomplete trailing line from the last chunk
+};
+
+/**
+ * AnalysisResultsWriter - One CSV of analysis measurements per batch
+ *
+ * Written next to the batch log as _FFAB_analysis_<timestamp>.csv with a
+ * fixed header (file, output, status, then AnalysisResultParser::columns()),
+ * one row per finished job, streamed as jobs complete so a 100k-file run
+ * never holds the table in memory. Empty cells mean "not measured".
+ */
+class AnalysisResultsWriter : public QObject {
+    Q_OBJECT
+
+public:
+    explicit AnalysisResultsWriter(QObject* parent = nullptr);
+    ~AnalysisResultsWriter() override;
+
+    bool open(const QString& outputFolder);
+    void writeRecord(const AnalysisRecord& record);
+    void close();
+
+    bool isOpen() const { return m_file.isOpen(); }
+    QString filePath() const { return m_filePath; }
+
+private:
+    static QString csvField(const QString& text);
+
+    QFile m_file;
+    QTextStream m_stream;
+    QString m_filePath;
+    int m_rowCount = 0;
+};
@@ -1,5 +1,6 @@
 #include "AudioFileScanner.h"
 #include <QFileInfo>
+#include <QDateTime>
 #include <QDirIterator>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -63,7 +64,7 @@ QList<FileListWidget::AudioFileInfo> AudioFileScanner::scanFolder(const QString&
 }
 
 FileListWidget::AudioFileInfo AudioFileScanner::extractMetadata(const QString& filePath,
-                                                               const QString& ffprobePath) {
+                                                                const QString& ffprobePath) {
     FileListWidget::AudioFileInfo info;
     info.filePath = filePath;
     info.fileName = QFileInfo(filePath).fileName();
@@ -115,6 +116,57 @@ FileListWidget::AudioFileInfo AudioFileScanner::extractMetadata(const QString& f
     return parseFFprobeOutput(filePath, output);
 }
 
+// ========== PRESET FILE ENTRIES ==========
+
+QJsonObject AudioFileScanner::toPresetEntry(const FileListWidget::AudioFileInfo& info) {
+    QJsonObject entry;
+    entry["path"] = info.filePath;
+    entry["enabled"] = info.enabled;
+    
+    // Unprobed rows (scan disabled, or loaded from an older preset) carry
+    // only defaults — nothing worth caching
+    if (info.sampleRate <= 0) return entry;
+    
+    QFileInfo fi(info.filePath);
+    if (!fi.exists()) return entry;
+    
+    entry["format"] = info.format;
+    entry["duration"] = info.duration;
+    entry["sample_rate"] = info.sampleRate;
+    entry["bits_per_sample"] = info.bitsPerSample;
+    entry["channels"] = info.channels;
+    entry["bitrate"] = info.bitrate;
+    entry["size"] = fi.size();
+    entry["mtime"] = fi.lastModified().toMSecsSinceEpoch();
+    return entry;
+}
+
+AudioFileScanner::PresetEntry AudioFileScanner::fromPresetEntry(const QJsonObject& entry) {
+    PresetEntry result;
+    
+    // Defaults as for an unprobed file (empty ffprobe path = no process)
+    result.info = extractMetadata(entry["path"].toString(), QString());
+    result.info.enabled = entry["enabled"].toBool();
+    
+    QFileInfo fi(result.info.filePath);
+    result.exists = fi.exists();
+    if (!result.exists || !entry.contains("sample_rate")) return result;
+    
+    if (fi.size() != entry["size"].toInteger(-1)
+        || fi.lastModified().toMSecsSinceEpoch() != entry["mtime"].toInteger(-1)) {
+        return result;  // Changed since the preset was saved — re-probe
+    }
+    
+    result.info.format = entry["format"].toString(result.info.format);
+    result.info.duration = entry["duration"].toString(result.info.duration);
+    result.info.sampleRate = entry["sample_rate"].toInt();
+    result.info.bitsPerSample = entry["bits_per_sample"].toInt();
+    result.info.channels = entry["channels"].toInt();
+    result.info.bitrate = entry["bitrate"].toInt();
+    result.fresh = true;
+    return result;
+}
+
 FileListWidget::AudioFileInfo AudioFileScanner::parseFFprobeOutput(const QString& filePath, const QString& output) {
     FileListWidget::AudioFileInfo info;
     info.filePath = filePath;
@@ -4,6 +4,7 @@
 #include <QStringList>
 #include <QDir>
 #include <QProcess>
+#include <QJsonObject>
 #include <functional>
 #include "UI/FileListWidget.h"
 
@@ -36,6 +37,21 @@ public:
     // Get list of supported audio extensions
     static QStringList getSupportedExtensions();
     
+    // ========== Preset file entries ==========
+    // {"path", "enabled"} plus, for probed files, the metadata and the file's
+    // size/mtime so a later load can trust it without running ffprobe again
+    
+    struct PresetEntry {
+        FileListWidget::AudioFileInfo info;
+        bool exists = false;
+        bool fresh = false;    // stored metadata still matches the file on disk
+    };
+    
+    static QJsonObject toPresetEntry(const FileListWidget::AudioFileInfo& info);
+    
+    // Stats the file; no ffprobe. Safe to run in parallel.
+    static PresetEntry fromPresetEntry(const QJsonObject& entry);
+    
 private:
     // Parse FFprobe JSON output
     static FileListWidget::AudioFileInfo parseFFprobeOutput(const QString& filePath, const QString& output);
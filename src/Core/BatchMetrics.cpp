@@ -0,0 +1,264 @@
+#include "BatchMetrics.h"
+#include <QTimer>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QSettings>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QDebug>
+
+BatchMetrics::BatchMetrics(QObject* parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+{
+    m_timer->setInterval(1000);
+    connect(m_timer, &QTimer::timeout, this, &BatchMetrics::tick);
+}
+
+BatchMetrics::~BatchMetrics() = default;
+
+// ========== BATCH LIFECYCLE ==========
+
+void BatchMetrics::start(int totalJobs, int workerCount, double audioTotalSec,
+                         const QString& outputFolder) {
+    m_workers = QVector<Worker>(qMax(1, workerCount));
+    m_totalJobs = totalJobs;
+    m_completed = 0;
+    m_failed = 0;
+    m_queued = totalJobs;
+    m_waiting = 0;
+    m_audioTotalSec = audioTotalSec;
+    m_audioFinishedSec = 0.0;
+    m_pausedMs = 0;
+    m_pauseStartedMs = -1;
+    m_clock.start();
+    m_running = true;
+
+    m_format = QSettings().value("log/metricsFormat", "off").toString();
+    m_exportPath.clear();
+    if (!outputFolder.isEmpty()) {
+        if (m_format == "jsonl") {
+            QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd_HH-mm-ss");
+            m_exportPath = QDir(outputFolder).filePath(QString("_FFAB_metrics_%1.jsonl").arg(timestamp));
+        } else if (m_format == "prometheus") {
+            m_exportPath = QDir(outputFolder).filePath("_FFAB_metrics.prom");
+        }
+    }
+    if (!m_exportPath.isEmpty()) {
+        emit exportFileCreated(m_exportPath);
+    }
+
+    m_timer->start();
+    tick();
+}
+
+void BatchMetrics::stop() {
+    if (!m_running) return;
+    if (m_pauseStartedMs >= 0) resume();
+    m_timer->stop();
+    tick();  // final sample
+    m_running = false;
+}
+
+void BatchMetrics::pause() {
+    if (!m_running || m_pauseStartedMs >= 0) return;
+    m_pauseStartedMs = m_clock.elapsed();
+}
+
+void BatchMetrics::resume() {
+    if (m_pauseStartedMs < 0) return;
+    m_pausedMs += m_clock.elapsed() - m_pauseStartedMs;
+    m_pauseStartedMs = -1;
+}
+
+// ========== JOB LIFECYCLE ==========
+
+void BatchMetrics::jobStarted(int worker, double audioSec) {
+    if (worker < 0 || worker >= m_workers.size()) return;
+    Worker& w = m_workers[worker];
+    w.busy = true;
+    w.startedMs = activeMs();
+    w.audioSec = audioSec;
+    w.progressSec = 0.0;
+}
+
+void BatchMetrics::jobProgress(int worker, double currentSec) {
+    if (worker < 0 || worker >= m_workers.size()) return;
+    m_workers[worker].progressSec = currentSec;
+}
+
+void BatchMetrics::jobFinished(int worker, bool success) {
+    if (worker < 0 || worker >= m_workers.size()) return;
+    Worker& w = m_workers[worker];
+    if (!w.busy) return;
+
+    w.busy = false;
+    w.busyMs += activeMs() - w.startedMs;
+    m_audioFinishedSec += w.audioSec > 0.0 ? w.audioSec : 0.0;
+    if (success) ++m_completed; else ++m_failed;
+}
+
+void BatchMetrics::passFinished(int worker) {
+    if (worker < 0 || worker >= m_workers.size()) return;
+    Worker& w = m_workers[worker];
+    if (!w.busy) return;
+
+    // Busy time and audio like any job, but not one of the totalJobs
+    w.busy = false;
+    w.busyMs += activeMs() - w.startedMs;
+    m_audioFinishedSec += w.audioSec > 0.0 ? w.audioSec : 0.0;
+}
+
+void BatchMetrics::jobAborted(int worker) {
+    if (worker < 0 || worker >= m_workers.size()) return;
+    Worker& w = m_workers[worker];
+    if (!w.busy) return;
+
+    // The worker was busy, but the job runs again — its audio isn't done
+    w.busy = false;
+    w.busyMs += activeMs() - w.startedMs;
+}
+
+void BatchMetrics::jobsSkipped(int count, double audioSec) {
+    m_failed += count;
+    m_audioFinishedSec += audioSec;
+}
+
+void BatchMetrics::setQueueDepth(int queued, int waiting) {
+    m_queued = queued;
+    m_waiting = waiting;
+}
+
+// ========== SNAPSHOT ==========
+
+qint64 BatchMetrics::activeMs() const {
+    if (!m_clock.isValid()) return 0;
+    qint64 now = m_clock.elapsed();
+    qint64 paused = m_pausedMs + (m_pauseStartedMs >= 0 ? now - m_pauseStartedMs : 0);
+    return now - paused;
+}
+
+BatchMetricsSnapshot BatchMetrics::snapshot() const {
+    BatchMetricsSnapshot s;
+    const qint64 nowMs = activeMs();
+
+    s.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    s.elapsedSec = nowMs / 1000.0;
+    s.totalJobs = m_totalJobs;
+    s.completedJobs = m_completed;
+    s.failedJobs = m_failed;
+    s.queuedJobs = m_queued;
+    s.waitingJobs = m_waiting;
+    s.workerCount = m_workers.size();
+    s.audioTotalSec = m_audioTotalSec;
+    s.audioDoneSec = m_audioFinishedSec;
+
+    qint64 busyMs = 0;
+    for (const Worker& w : m_workers) {
+        busyMs += w.busyMs;
+        if (!w.busy) continue;
+        ++s.runningJobs;
+        busyMs += nowMs - w.startedMs;
+        s.audioDoneSec += w.audioSec > 0.0 ? qMin(w.progressSec, w.audioSec) : 0.0;
+    }
+
+    const int done = m_completed + m_failed;
+    if (nowMs > 0) {
+        s.realtimeFactor = s.audioDoneSec / s.elapsedSec;
+        s.filesPerMinute = done * 60.0 / s.elapsedSec;
+        qint64 capacityMs = nowMs * s.workerCount;
+        s.workerUtilization = qBound(0.0, static_cast<double>(busyMs) / capacityMs, 1.0);
+        s.workerIdleSec = qMax<qint64>(0, capacityMs - busyMs) / 1000.0;
+    }
+
+    if (done >= m_totalJobs) {
+        s.etaSec = 0.0;
+    } else if (m_audioTotalSec > 0.0 && s.realtimeFactor > 0.0) {
+        s.etaSec = qMax(0.0, m_audioTotalSec - s.audioDoneSec) / s.realtimeFactor;
+    } else if (done > 0) {
+        s.etaSec = (m_totalJobs - done) * s.elapsedSec / done;
+    }
+
+    return s;
+}
+
+void BatchMetrics::tick() {
+    BatchMetricsSnapshot s = snapshot();
+    emit updated(s);
+    writeExport(s);
+}
+
+// ========== EXPORT ==========
+
+void BatchMetrics::writeExport(const BatchMetricsSnapshot& s) {
+    if (m_exportPath.isEmpty()) return;
+
+    if (m_format == "jsonl") {
+        QFile file(m_exportPath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+            qWarning() << "BatchMetrics: Failed to open" << m_exportPath;
+            m_exportPath.clear();
+            return;
+        }
+        file.write(toJsonLine(s).toUtf8());
+    } else {
+        // Scrapers must never see a half-written file
+        QSaveFile file(m_exportPath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            qWarning() << "BatchMetrics: Failed to open" << m_exportPath;
+            m_exportPath.clear();
+            return;
+        }
+        file.write(toPrometheus(s).toUtf8());
+        file.commit();
+    }
+}
+
+QString BatchMetrics::toJsonLine(const BatchMetricsSnapshot& s) {
+    QJsonObject obj;
+    obj["timestamp_ms"] = s.timestampMs;
+    obj["elapsed_s"] = s.elapsedSec;
+    obj["jobs_total"] = s.totalJobs;
+    obj["jobs_completed"] = s.completedJobs;
+    obj["jobs_failed"] = s.failedJobs;
+    obj["jobs_running"] = s.runningJobs;
+    obj["jobs_queued"] = s.queuedJobs;
+    obj["jobs_waiting"] = s.waitingJobs;
+    obj["workers"] = s.workerCount;
+    obj["audio_total_s"] = s.audioTotalSec;
+    obj["audio_done_s"] = s.audioDoneSec;
+    obj["realtime_factor"] = s.realtimeFactor;
+    obj["files_per_minute"] = s.filesPerMinute;
+    obj["worker_utilization"] = s.workerUtilization;
+    obj["worker_idle_s"] = s.workerIdleSec;
+    obj["eta_s"] = s.etaSec;
+    return QString::fromUtf8(QJsonDocument(obj).toJson(QJsonDocument::Compact)) + "\n";
+}
+
+QString BatchMetrics::toPrometheus(const BatchMetricsSnapshot& s) {
+    QString out;
+    auto gauge = [&out](const QString& name, const QString& help, double value) {
+        out += QString("# HELP %1 %2\n# TYPE %1 gauge\n%1 %3\n").arg(name, help).arg(value, 0, 'g', 10);
+    };
+
+    out += "# HELP ffab_batch_jobs Batch jobs by state.\n# TYPE ffab_batch_jobs gauge\n";
+    out += QString("ffab_batch_jobs{state=\"total\"} %1\n").arg(s.totalJobs);
+    out += QString("ffab_batch_jobs{state=\"completed\"} %1\n").arg(s.completedJobs);
+    out += QString("ffab_batch_jobs{state=\"failed\"} %1\n").arg(s.failedJobs);
+    out += QString("ffab_batch_jobs{state=\"running\"} %1\n").arg(s.runningJobs);
+    out += QString("ffab_batch_jobs{state=\"queued\"} %1\n").arg(s.queuedJobs);
+    out += QString("ffab_batch_jobs{state=\"waiting\"} %1\n").arg(s.waitingJobs);
+
+    gauge("ffab_batch_workers", "FFmpeg worker processes in the pool.", s.workerCount);
+    gauge("ffab_batch_elapsed_seconds", "Batch running time, pauses excluded.", s.elapsedSec);
+    gauge("ffab_batch_audio_total_seconds", "Input audio duration of the whole batch.", s.audioTotalSec);
+    gauge("ffab_batch_audio_done_seconds", "Input audio duration processed so far.", s.audioDoneSec);
+    gauge("ffab_batch_realtime_factor", "Audio seconds processed per wall-clock second, all workers.", s.realtimeFactor);
+    gauge("ffab_batch_files_per_minute", "Finished jobs per minute.", s.filesPerMinute);
+    gauge("ffab_batch_worker_utilization", "Fraction of worker time spent running jobs.", s.workerUtilization);
+    gauge("ffab_batch_worker_idle_seconds", "Worker idle time summed over workers.", s.workerIdleSec);
+    gauge("ffab_batch_eta_seconds", "Estimated time to completion (-1 = unknown).", s.etaSec);
+    return out;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QElapsedTimer>
+
+class QTimer;
+
+/**
+ * BatchMetricsSnapshot - Aggregate batch throughput at one point in time
+ *
+ * "Audio" figures are input durations as scanned into the File List; jobs
+ * with an unknown duration count towards the file figures only.
+ */
+struct BatchMetricsSnapshot {
+    qint64 timestampMs = 0;        // wall clock, ms since epoch
+    double elapsedSec = 0.0;       // batch time, pauses excluded
+
+    int totalJobs = 0;
+    int completedJobs = 0;
+    int failedJobs = 0;
+    int runningJobs = 0;
+    int queuedJobs = 0;            // ready to dispatch
+    int waitingJobs = 0;           // blocked on a predecessor (Iterate cascade)
+    int workerCount = 0;
+
+    double audioTotalSec = 0.0;
+    double audioDoneSec = 0.0;     // finished jobs + in-flight progress
+
+    double realtimeFactor = 0.0;   // audio seconds processed per wall second, all workers
+    double filesPerMinute = 0.0;
+    double workerUtilization = 0.0;  // busy time / (workers × elapsed), 0-1
+    double workerIdleSec = 0.0;      // summed over workers
+    double etaSec = -1.0;            // -1 = not enough data yet
+};
+
+/**
+ * BatchMetrics - In-process throughput aggregator for BatchProcessor
+ *
+ * BatchProcessor reports job lifecycle events; once a second the
+ * aggregator emits a snapshot for the UI (BatchAdminPanel) and, when
+ * "log/metricsFormat" is set, exports it to the OUTPUT folder:
+ *
+ *   - "jsonl"       _FFAB_metrics_<timestamp>.jsonl — one object per second
+ *   - "prometheus"  _FFAB_metrics.prom — text exposition format, replaced
+ *                   atomically each tick (node_exporter textfile collector)
+ *
+ * ETA is based on remaining audio duration at the current realtime
+ * factor, falling back to remaining files at the current file rate.
+ */
+class BatchMetrics : public QObject {
+    Q_OBJECT
+
+public:
+    explicit BatchMetrics(QObject* parent = nullptr);
+    ~BatchMetrics() override;
+
+    void start(int totalJobs, int workerCount, double audioTotalSec, const QString& outputFolder);
+    void stop();
+    void pause();
+    void resume();
+
+    // ========== Job lifecycle (from BatchProcessor) ==========
+
+    void jobStarted(int worker, double audioSec);
+    void jobProgress(int worker, double currentSec);
+    void jobFinished(int worker, bool success);
+    void passFinished(int worker);                   // internal pass (loudnorm measurement) — not counted
+    void jobAborted(int worker);                     // re-queued (pause) — not counted
+    void jobsSkipped(int count, double audioSec);    // dependents of a failed job
+    void setQueueDepth(int queued, int waiting);
+
+    BatchMetricsSnapshot snapshot() const;
+    QString exportFilePath() const { return m_exportPath; }
+
+signals:
+    void updated(const BatchMetricsSnapshot& snapshot);
+    void exportFileCreated(const QString& filePath);
+
+private:
+    void tick();
+    void writeExport(const BatchMetricsSnapshot& s);
+    qint64 activeMs() const;
+
+    static QString toJsonLine(const BatchMetricsSnapshot& s);
+    static QString toPrometheus(const BatchMetricsSnapshot& s);
+
+    struct Worker {
+        bool busy = false;
+        qint64 startedMs = 0;      // activeMs() at job start
+        qint64 busyMs = 0;         // finished jobs only
+        double audioSec = 0.0;     // current job's input duration
+        double progressSec = 0.0;  // current job's position
+    };
+
+    QVector<Worker> m_workers;
+    QTimer* m_timer;
+    QElapsedTimer m_clock;
+    qint64 m_pausedMs = 0;
+    qint64 m_pauseStartedMs = -1;
+    bool m_running = false;
+
+    int m_totalJobs = 0;
+    int m_completed = 0;
+    int m_failed = 0;
+    int m_queued = 0;
+    int m_waiting = 0;
+    double m_audioTotalSec = 0.0;
+    double m_audioFinishedSec = 0.0;
+
+    QString m_format;       // "", "jsonl", "prometheus"
+    QString m_exportPath;
+};
@@ -2,14 +2,19 @@
 #include "LogFileWriter.h"
 #include "Core/FilterChain.h"
 #include "Filters/OutputFilter.h"
+#include "Core/LoudnormMeasurement.h"
 #include <QFileInfo>
 #include <QDir>
 #include <QDebug>
 #include <QSettings>
+#include <QThread>
+#include <algorithm>
 
 BatchProcessor::BatchProcessor(QObject* parent)
     : QObject(parent)
     , logWriter(new LogFileWriter(this))
+    , m_resultsWriter(new AnalysisResultsWriter(this))
+    , m_metrics(new BatchMetrics(this))
     , state(State::Idle)
     , totalFiles(0)
     , completedFiles(0)
@@ -63,23 +68,30 @@ void BatchProcessor::start(const QList<FileListWidget::AudioFileInfo>& files,
                                 filenameSuffix + "." + outputExtension;
         job.outputPath = QDir(outputFolder).filePath(outputFileName);
 
-        if (!sidechainFiles.isEmpty()) {
+        if (filterChain->isAnalysisOnly(mutedPositions)) {
+            job.analysisOnly = true;
+            job.command = filterChain->buildAnalysisCommand(
+                file.filePath, sidechainFiles, mutedPositions, logSettings);
+        } else if (!sidechainFiles.isEmpty()) {
             job.command = filterChain->buildCompleteCommand(
                 file.filePath, sidechainFiles, job.outputPath, mutedPositions, logSettings);
         } else {
             job.command = filterChain->buildCompleteCommand(
                 file.filePath, job.outputPath, mutedPositions, logSettings);
         }
+        job.branchOutputPaths = filterChain->branchOutputPaths(file.filePath, job.outputPath, mutedPositions);
 
         jobs.append(job);
     }
 
-    start(jobs, ffmpegPath_);
+    setAnalysisFilters(filterChain && filterChain->hasAnalysisFilters(mutedPositions));
+    start(jobs, ffmpegPath_, outputFolder);
 }
 
 // ========== NEW START (pre-built jobs from JobListBuilder) ==========
 
-void BatchProcessor::start(const QList<JobInfo>& jobs, const QString& ffmpegPath_) {
+void BatchProcessor::start(const QList<JobInfo>& jobs, const QString& ffmpegPath_,
+                           const QString& outputFolder) {
     if (state == State::Processing) {
         qWarning() << "BatchProcessor: Already processing";
         return;
@@ -87,24 +99,61 @@ void BatchProcessor::start(const QList<JobInfo>& jobs, const QString& ffmpegPath
 
     ffmpegPath = ffmpegPath_;
     jobQueue.clear();
+    m_waiting.clear();
     completedFiles = 0;
     failedFiles = 0;
     m_dispatched  = 0;
 
-    for (const auto& job : jobs) {
-        jobQueue.enqueue(job);
+    // Jobs with a predecessor wait until it succeeds; everything else is ready.
+    // Only earlier jobs can be predecessors, so the graph can't deadlock.
+    for (int id = 0; id < jobs.size(); ++id) {
+        JobInfo job = jobs[id];
+        job.jobId = id;
+        if (job.dependsOn >= 0 && job.dependsOn < id) {
+            m_waiting[job.dependsOn].append(job);
+        } else {
+            job.dependsOn = -1;
+            jobQueue.enqueue(job);
+        }
     }
-    totalFiles = jobQueue.size();
-
-    // Cascade guard: Iterate batches are inherently serial (each output feeds the next)
-    bool hasCascade = std::any_of(jobs.begin(), jobs.end(),
-                                  [](const JobInfo& j){ return j.isCascade; });
+    // Measurement passes are internal — the user-facing counts are the renders
+    totalFiles = std::count_if(jobs.begin(), jobs.end(),
+                               [](const JobInfo& j){ return !j.isMeasurement; });
 
     QSettings settings;
-    int maxConcurrent = settings.value("processing/maxConcurrent", 1).toInt();
-    if (hasCascade) maxConcurrent = 1;
+    int maxConcurrent = m_maxConcurrentOverride > 0
+        ? m_maxConcurrentOverride
+        : settings.value("processing/maxConcurrent", 1).toInt();
+
+    // Analysis-only batches never touch the output disk — decode-bound,
+    // so run one process per core
+    bool allAnalysis = !jobs.isEmpty() && std::all_of(jobs.begin(), jobs.end(),
+                                   [](const JobInfo& j){ return j.analysisOnly; });
+    if (allAnalysis) {
+        int analysisConcurrent = settings.value("processing/analysisConcurrent",
+                                                QThread::idealThreadCount()).toInt();
+        maxConcurrent = qMax(maxConcurrent, analysisConcurrent);
+    }
     maxConcurrent = qMax(1, maxConcurrent);
 
+    m_atomicOutput = settings.value("processing/atomicOutput", true).toBool();
+    m_preallocateOutput = settings.value("processing/preallocateOutput", false).toBool();
+
+    m_spaceHold = false;
+    m_createdFolders.clear();
+    m_admission.reset(maxConcurrent);
+    for (const auto& job : jobs) {
+        if (writesOutput(job)) m_admission.addPending(job.outputPath, outputBytes(job));
+    }
+
+    m_decodeWaiting.clear();
+    if (m_decodeCache.reset(settings.value("processing/decodeCache", false).toBool())) {
+        for (const auto& job : jobs) {
+            for (const auto& source : cachedSources(job)) m_decodeCache.addReference(source);
+        }
+        m_decodeCache.seal();
+    }
+
     // Progress pipe:2 lines are noise at low log levels; include only at verbose/debug/trace.
     const QString logLevel = settings.value("log/logLevel", "error").toString();
     const bool suppressProgress = !(logLevel == "verbose" || logLevel == "debug" || logLevel == "trace");
@@ -139,6 +188,11 @@ void BatchProcessor::start(const QList<JobInfo>& jobs, const QString& ffmpegPath
         // Log output
         connect(m_workers[i].runner, &FFmpegRunner::outputReceived,
                 this, [this, i](const QString& output) {
+                    if (m_workers[i].currentJob.isMeasurement) {
+                        m_workers[i].capturedOutput += output;
+                    } else if (m_resultsWriter->isOpen()) {
+                        m_workers[i].analysis.feed(output);
+                    }
                     if (logWriter->isOpen() && !m_workers[i].currentInputFileName.isEmpty()) {
                         logWriter->writeLines(m_workers[i].currentInputFileName, output);
                     }
@@ -148,7 +202,6 @@ void BatchProcessor::start(const QList<JobInfo>& jobs, const QString& ffmpegPath
     // Open batch log
     bool loggingEnabled = settings.value("log/saveToFile", false).toBool();
     if (loggingEnabled && !jobs.isEmpty()) {
-        QString outputFolder = QFileInfo(jobs.first().outputPath).absolutePath();
         if (!outputFolder.isEmpty()) {
             if (logWriter->open(outputFolder, "batch", totalFiles)) {
                 emit logFileCreated(logWriter->filePath());
@@ -156,6 +209,20 @@ void BatchProcessor::start(const QList<JobInfo>& jobs, const QString& ffmpegPath
         }
     }
 
+    // Analysis results CSV — only when the chain runs analysis filters
+    bool resultsEnabled = settings.value("log/analysisResults", true).toBool();
+    if (resultsEnabled && m_analysisFilters && !jobs.isEmpty()) {
+        if (!outputFolder.isEmpty() && m_resultsWriter->open(outputFolder)) {
+            emit analysisResultsCreated(m_resultsWriter->filePath());
+        }
+    }
+
+    double audioTotalSec = 0.0;
+    for (const auto& job : jobs) {
+        audioTotalSec += jobDuration(job);
+    }
+    m_metrics->start(totalFiles, maxConcurrent, audioTotalSec, outputFolder);
+
     qDebug() << "BatchProcessor: Starting" << totalFiles << "files across"
              << maxConcurrent << "workers";
 
@@ -166,92 +233,334 @@ void BatchProcessor::start(const QList<JobInfo>& jobs, const QString& ffmpegPath
     for (int i = 0; i < maxConcurrent && !jobQueue.isEmpty(); ++i) {
         dispatchToWorker(i);
     }
+    updateQueueDepth();
+    pauseIfHeld();
 }
 
 // ========== WORKER DISPATCH ==========
 
 void BatchProcessor::dispatchToWorker(int i) {
-    if (jobQueue.isEmpty()) {
-        m_workers[i].active = false;
+    m_workers[i].active = false;
+
+    while (!jobQueue.isEmpty() && !m_spaceHold) {
+        // Admission looks at the head only — released dependents keep their
+        // place at the front instead of being overtaken
+        const JobInfo& next = jobQueue.head();
+        if (writesOutput(next)) {
+            switch (m_admission.check(next.outputPath, outputBytes(next))) {
+                case OutputAdmission::Verdict::Admit:
+                    break;
+                case OutputAdmission::Verdict::WriterLimit:
+                    return;  // retried when a writer finishes
+                case OutputAdmission::Verdict::LowSpace:
+                    holdForDiskSpace(next.outputPath);
+                    return;
+            }
+        }
+
+        JobInfo job = jobQueue.dequeue();
+
+        // A shared input that isn't decoded yet: the job waits for it, and
+        // this worker runs the decode unless another one already is
+        const QString pending = m_decodeCache.pendingSource(cachedSources(job));
+        if (!pending.isEmpty()) {
+            m_decodeWaiting[pending].append(job);
+            if (m_decodeCache.state(pending) == DecodeCache::State::Missing) {
+                startDecode(i, pending);
+                return;
+            }
+            continue;
+        }
+
+        runJob(i, job);
         return;
     }
+}
 
-    JobInfo job = jobQueue.dequeue();
-    ++m_dispatched;
+void BatchProcessor::runJob(int i, JobInfo job) {
+    if (!job.isMeasurement) ++m_dispatched;
+
+    // Render pass of a two-pass loudnorm: swap in the measured values
+    if (job.loudnormFilterId >= 0) {
+        LoudnormMeasurement measurement;
+        QString measuredCommand;
+        if (LoudnormMeasurement::lookup(job.measurementKey, &measurement)) {
+            measuredCommand = measurement.applyToCommand(job.command, job.loudnormFilterId);
+        }
+        if (!measuredCommand.isEmpty()) {
+            job.command = measuredCommand;
+            job.loudnormFilterId = -1;  // already applied if re-queued by pause
+        } else {
+            qWarning() << "BatchProcessor: No loudnorm measurement for"
+                       << job.inputFile.fileName << "— rendering single-pass";
+        }
+    }
 
     m_workers[i].active               = true;
     m_workers[i].currentJob           = job;
     m_workers[i].currentFileName      = job.inputFile.fileName;
     m_workers[i].currentInputFileName = QFileInfo(job.inputFile.fileName).fileName();
-    m_workers[i].currentJobIsCascade  = job.isCascade;
+    m_workers[i].capturedOutput.clear();
+    m_workers[i].analysis.take();
+
+    if (writesOutput(job)) ensureOutputFolders(job);
+
+    // currentJob keeps the real paths — a re-queued job is staged afresh.
+    // Aux and image outputs are committed or discarded with the main output.
+    const QString command = m_decodeCache.rewriteInputs(job.command, cachedSources(job));
+    m_workers[i].staged = OutputStaging::Staged{};
+    m_workers[i].staged.command = command;
+    if (m_atomicOutput && writesOutput(job)) {
+        m_workers[i].staged = OutputStaging::stage(
+            command, QStringList{job.outputPath} + job.extraOutputPaths,
+            m_preallocateOutput && job.pcmOutput ? job.expectedBytes : 0,
+            job.branchOutputPaths);
+    }
 
-    qDebug() << "BatchProcessor: Worker" << i << "starting file"
-             << m_dispatched << "/" << totalFiles << ":" << m_workers[i].currentFileName;
+    // A measurement reports the number of the render it precedes
+    const int fileNumber = job.isMeasurement ? m_dispatched + 1 : m_dispatched;
+    qDebug() << "BatchProcessor: Worker" << i << (job.isMeasurement ? "measuring file" : "starting file")
+             << fileNumber << "/" << totalFiles << ":" << m_workers[i].currentFileName;
 
-    emit fileStarted(m_workers[i].currentFileName, m_dispatched, totalFiles, i);
+    emit fileStarted(m_workers[i].currentFileName, fileNumber, totalFiles, i);
 
-    m_workers[i].runner->runCommand(job.command, ffmpegPath);
-    double dur = parseDurationString(job.inputFile.duration);
+    if (writesOutput(job)) {
+        // The files expectedBytes covers, under the names ffmpeg writes them to
+        QStringList writingPaths;
+        for (const auto& path : QStringList{job.outputPath} + job.extraOutputPaths) {
+            writingPaths.append(m_workers[i].staged.finalPaths.contains(path)
+                                    ? OutputStaging::tempPathFor(path) : path);
+        }
+        m_admission.jobStarted(job.outputPath, outputBytes(job), writingPaths,
+                               m_workers[i].staged.preallocated);
+    }
+    m_workers[i].runner->runCommand(m_workers[i].staged.command, ffmpegPath);
+    double dur = jobDuration(job);
     if (dur > 0.0) m_workers[i].runner->setTotalDuration(dur);
+    m_metrics->jobStarted(i, dur);
+}
+
+void BatchProcessor::startDecode(int i, const QString& source) {
+    WorkerState& w = m_workers[i];
+    w.active               = true;
+    w.decodingSource       = source;
+    w.currentJob           = JobInfo{};
+    w.currentFileName      = QFileInfo(source).fileName();
+    w.currentInputFileName.clear();  // not a batch file — keep it out of the log
+    w.capturedOutput.clear();
+    w.staged = OutputStaging::Staged{};
+
+    qDebug() << "BatchProcessor: Worker" << i << "decoding shared input" << source;
+    w.runner->runCommand(m_decodeCache.startDecode(source), ffmpegPath);
+}
+
+void BatchProcessor::onDecodeFinished(int i, bool success) {
+    const QString source = m_workers[i].decodingSource;
+    m_workers[i].decodingSource.clear();
+    m_workers[i].active = false;
+
+    if (state == State::Cancelled) return;  // cache already cleared
+
+    if (state == State::Paused) {
+        m_decodeCache.decodeAborted(source);  // decoded again after resume
+    } else {
+        m_decodeCache.decodeFinished(source, success);
+    }
+
+    // Waiting jobs go back to the front in their original order
+    QList<JobInfo> released = m_decodeWaiting.take(source);
+    for (int k = released.size() - 1; k >= 0; --k) {
+        jobQueue.prepend(released[k]);
+    }
+
+    if (state != State::Processing) {
+        updateQueueDepth();
+        return;
+    }
+
+    for (int w = 0; w < m_workers.size() && !jobQueue.isEmpty(); ++w) {
+        if (!m_workers[w].active) dispatchToWorker(w);
+    }
+    updateQueueDepth();
+    pauseIfHeld();
+    finishIfDone();
 }
 
 void BatchProcessor::onWorkerProgress(int i, FFmpegRunner::ProgressInfo info) {
+    if (!m_workers[i].decodingSource.isEmpty()) return;
+    m_metrics->jobProgress(i, info.currentTime);
     emit fileProgress(info, i);
 }
 
 void BatchProcessor::onWorkerFinished(int i, bool success) {
+    if (!m_workers[i].decodingSource.isEmpty()) {
+        onDecodeFinished(i, success);
+        return;
+    }
+
+    // cancel() waits for each killed job — its partial outputs go, nothing is counted
+    if (state == State::Cancelled) {
+        OutputStaging::discard(m_workers[i].staged);
+        m_workers[i].active = false;
+        return;
+    }
+
     // If paused, this completion came from cancel() during pause — re-queue for after resume.
     // Don't count as failure; don't emit fileFinished.
     if (state == State::Paused) {
+        OutputStaging::discard(m_workers[i].staged);
+        if (writesOutput(m_workers[i].currentJob)) {
+            m_admission.jobAborted(m_workers[i].currentJob.outputPath, outputBytes(m_workers[i].currentJob));
+        }
         jobQueue.prepend(m_workers[i].currentJob);
-        --m_dispatched;
+        if (!m_workers[i].currentJob.isMeasurement) --m_dispatched;
         m_workers[i].active = false;
+        m_metrics->jobAborted(i);
+        updateQueueDepth();
         return;
     }
 
     const QString finishedName = m_workers[i].currentFileName;
-    const bool wasCascade      = m_workers[i].currentJobIsCascade;
+    const int finishedId       = m_workers[i].currentJob.jobId;
+
+    // Outputs take their real names before anything (a dependent pass, the
+    // results CSV) can look for them
+    if (success) {
+        success = OutputStaging::commit(m_workers[i].staged);
+    } else {
+        OutputStaging::discard(m_workers[i].staged);
+    }
+
+    const JobInfo& finishedJob = m_workers[i].currentJob;
+    if (writesOutput(finishedJob)) {
+        qint64 writtenBytes = 0;
+        if (success) {
+            writtenBytes = QFileInfo(finishedJob.outputPath).size();
+            for (const auto& extra : finishedJob.extraOutputPaths + finishedJob.branchOutputPaths) {
+                writtenBytes += QFileInfo(extra).size();
+            }
+        }
+        m_admission.jobFinished(finishedJob.outputPath, writtenBytes);
+    }
+
+    if (success && m_workers[i].currentJob.isMeasurement) {
+        auto measurement = LoudnormMeasurement::parse(m_workers[i].capturedOutput);
+        if (measurement.valid) {
+            LoudnormMeasurement::store(m_workers[i].currentJob.measurementKey, measurement);
+        } else {
+            qWarning() << "BatchProcessor: Could not parse loudnorm measurement for" << finishedName;
+        }
+        m_workers[i].capturedOutput.clear();
+    }
+
+    if (m_resultsWriter->isOpen() && !m_workers[i].currentJob.isMeasurement) {
+        AnalysisRecord record;
+        record.inputFile  = m_workers[i].currentJob.inputFile.filePath;
+        record.outputFile = m_workers[i].currentJob.outputPath;
+        record.success    = success;
+        record.values     = m_workers[i].analysis.take();
+        m_resultsWriter->writeRecord(record);
+    }
+
+    const bool isMeasurement = finishedJob.isMeasurement;
+    if (isMeasurement) {
+        m_metrics->passFinished(i);
+    } else {
+        m_metrics->jobFinished(i, success);
+    }
+    m_decodeCache.release(cachedSources(finishedJob));
 
     if (success) {
-        completedFiles++;
+        if (!isMeasurement) completedFiles++;
         qDebug() << "BatchProcessor: Worker" << i << "succeeded:" << finishedName;
+
+        // Release dependents at the front so a file's chain finishes before
+        // new chains start — keeps intermediate files short-lived
+        QList<JobInfo> released = m_waiting.take(finishedId);
+        for (int k = released.size() - 1; k >= 0; --k) {
+            jobQueue.prepend(released[k]);
+        }
     } else {
-        failedFiles++;
+        // A failed measurement fails its render, which is counted as aborted below
+        if (!isMeasurement) failedFiles++;
         qWarning() << "BatchProcessor: Worker" << i << "failed:" << finishedName;
 
-        if (wasCascade && !jobQueue.isEmpty()) {
-            int aborted = jobQueue.size();
+        double abortedAudioSec = 0.0;
+        int aborted = abortDependents(finishedId, &abortedAudioSec);
+        if (aborted > 0) {
             failedFiles += aborted;
-            qWarning() << "BatchProcessor: Cascade broken — aborting" << aborted << "remaining jobs";
-            jobQueue.clear();
-
-            m_workers[i].active = false;
-            emit fileFinished(finishedName, false, i);
-
-            if (activeWorkerCount() == 0) {
-                logWriter->close();
-                setState(State::Finished);
-                emit allFinished(completedFiles, failedFiles);
-            }
-            return;
+            m_metrics->jobsSkipped(aborted, abortedAudioSec);
+            qWarning() << "BatchProcessor: Cascade broken — aborting" << aborted
+                       << "dependent jobs of" << finishedName;
         }
     }
 
     m_workers[i].active = false;
-    emit fileFinished(finishedName, success, i);
+    if (!isMeasurement || !success) emit fileFinished(finishedName, success, i);
 
-    if (state == State::Processing && !jobQueue.isEmpty()) {
-        dispatchToWorker(i);
-        return;
+    if (state != State::Processing) return;
+
+    // A success may have released more jobs than this worker can take
+    for (int w = 0; w < m_workers.size() && !jobQueue.isEmpty(); ++w) {
+        if (!m_workers[w].active) dispatchToWorker(w);
     }
+    updateQueueDepth();
+    pauseIfHeld();
 
-    if (jobQueue.isEmpty() && activeWorkerCount() == 0) {
-        logWriter->close();
-        setState(State::Finished);
-        qDebug() << "BatchProcessor: Finished —" << completedFiles << "succeeded,"
-                 << failedFiles << "failed";
-        emit allFinished(completedFiles, failedFiles);
+    finishIfDone();
+}
+
+int BatchProcessor::abortDependents(int jobId, double* abortedAudioSec) {
+    int aborted = 0;
+    QList<int> pending{jobId};
+    while (!pending.isEmpty()) {
+        for (const auto& job : m_waiting.take(pending.takeLast())) {
+            if (!job.isMeasurement) ++aborted;
+            if (abortedAudioSec) *abortedAudioSec += jobDuration(job);
+            if (writesOutput(job)) m_admission.dropPending(job.outputPath, outputBytes(job));
+            m_decodeCache.release(cachedSources(job));
+            pending.append(job.jobId);
+        }
     }
+    return aborted;
+}
+
+void BatchProcessor::updateQueueDepth() {
+    int waiting = 0;
+    for (const auto& blocked : m_waiting) waiting += blocked.size();
+    for (const auto& blocked : m_decodeWaiting) waiting += blocked.size();
+    m_metrics->setQueueDepth(jobQueue.size(), waiting);
+}
+
+void BatchProcessor::holdForDiskSpace(const QString& outputPath) {
+    if (m_spaceHold) return;
+    m_spaceHold = true;
+
+    auto volume = m_admission.status(outputPath);
+    qWarning() << "BatchProcessor: Low disk space on" << volume.rootPath << "—"
+               << volume.freeBytes / (1024 * 1024) << "MB free, about"
+               << volume.remainingBytes / (1024 * 1024) << "MB still to write. Pausing.";
+    emit diskSpaceLow(volume.rootPath, volume.freeBytes, volume.remainingBytes);
+}
+
+void BatchProcessor::pauseIfHeld() {
+    // Running jobs already have their space — let them finish, then pause
+    if (!m_spaceHold || state != State::Processing || activeWorkerCount() > 0) return;
+    setState(State::Paused);
+    m_metrics->pause();
+}
+
+void BatchProcessor::finishIfDone() {
+    if (!jobQueue.isEmpty() || activeWorkerCount() > 0) return;
+
+    m_decodeCache.clear();
+    logWriter->close();
+    m_resultsWriter->close();
+    m_metrics->stop();
+    setState(State::Finished);
+    qDebug() << "BatchProcessor: Finished —" << completedFiles << "succeeded,"
+             << failedFiles << "failed";
+    emit allFinished(completedFiles, failedFiles);
 }
 
 int BatchProcessor::activeWorkerCount() const {
@@ -267,6 +576,7 @@ int BatchProcessor::activeWorkerCount() const {
 void BatchProcessor::pause() {
     if (state != State::Processing) return;
     setState(State::Paused);
+    m_metrics->pause();
     for (auto& w : m_workers) {
         if (w.active && w.runner) w.runner->cancel();
     }
@@ -275,19 +585,37 @@ void BatchProcessor::pause() {
 void BatchProcessor::resume() {
     if (state != State::Paused) return;
     setState(State::Processing);
+    m_metrics->resume();
+    m_spaceHold = false;  // re-checked on dispatch
     for (int i = 0; i < m_workers.size() && !jobQueue.isEmpty(); ++i) {
         if (!m_workers[i].active) dispatchToWorker(i);
     }
+    updateQueueDepth();
+    pauseIfHeld();
 }
 
 void BatchProcessor::cancel() {
     if (state == State::Idle || state == State::Finished) return;
     setState(State::Cancelled);
+    m_spaceHold = false;
+
+    // Wait for the kills, so staged outputs and decodes are removed before
+    // allFinished — ffab-cli exits the event loop on it
     for (auto& w : m_workers) {
-        if (w.runner) w.runner->cancel();
+        if (w.runner) w.runner->cancelAndWait();
+        if (w.active) {
+            OutputStaging::discard(w.staged);
+            w.decodingSource.clear();
+            w.active = false;
+        }
     }
     jobQueue.clear();
+    m_waiting.clear();
+    m_decodeWaiting.clear();
+    m_decodeCache.clear();
     logWriter->close();
+    m_resultsWriter->close();
+    m_metrics->stop();
     qDebug() << "BatchProcessor: Cancelled";
     emit allFinished(completedFiles, failedFiles);
 }
@@ -322,3 +650,32 @@ double BatchProcessor::parseDurationString(const QString& dur) {
     }
     return 0.0;
 }
+
+double BatchProcessor::jobDuration(const JobInfo& job) {
+    return job.durationSec > 0.0 ? job.durationSec : parseDurationString(job.inputFile.duration);
+}
+
+QStringList BatchProcessor::cachedSources(const JobInfo& job) const {
+    if (!m_decodeCache.isEnabled()) return {};
+    return DecodeCache::sourcesOf(job.command, QStringList{job.inputFile.filePath} + job.sidechainFiles);
+}
+
+bool BatchProcessor::writesOutput(const JobInfo& job) {
+    return !job.analysisOnly && !job.isMeasurement;
+}
+
+qint64 BatchProcessor::outputBytes(const JobInfo& job) {
+    return job.expectedBytes * (1 + job.extraOutputPaths.size());
+}
+
+void BatchProcessor::ensureOutputFolders(const JobInfo& job) {
+    // ffmpeg won't create a missing output folder
+    for (const auto& path : QStringList{job.outputPath} + job.extraOutputPaths + job.branchOutputPaths) {
+        const QString folder = QFileInfo(path).absolutePath();
+        if (m_createdFolders.contains(folder)) continue;
+        if (!QDir().mkpath(folder)) {
+            qWarning() << "BatchProcessor: Could not create output folder" << folder;
+        }
+        m_createdFolders.insert(folder);
+    }
+}
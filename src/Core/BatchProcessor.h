@@ -2,11 +2,18 @@
 
 #include <QObject>
 #include <QQueue>
+#include <QHash>
+#include <QSet>
 #include <QString>
 #include <QVector>
 #include <memory>
 #include "FFmpegRunner.h"
+#include "AnalysisResults.h"
+#include "BatchMetrics.h"
 #include "UI/FileListWidget.h"
+#include "OutputStaging.h"
+#include "OutputAdmission.h"
+#include "DecodeCache.h"
 
 class FilterChain;
 class LogFileWriter;
@@ -16,15 +23,36 @@ class LogFileWriter;
  *
  * Features:
  * - Queue of files to process
- * - Parallel processing (N workers, N read from QSettings "processing/maxConcurrent")
+ * - Parallel processing (N workers, N read from QSettings "processing/maxConcurrent";
+ *   analysis-only batches use "processing/analysisConcurrent", default = core count)
+ * - Dependency-aware scheduling: a job may name a predecessor that must
+ *   succeed first (Iterate passes). Independent chains run on separate
+ *   workers; a failure aborts only that job's dependents.
  * - Progress tracking per worker and overall
  * - Pause/resume/cancel functionality
+ * - Outputs written under a temp name and renamed on success
+ *   (OutputStaging, "processing/atomicOutput"), optionally preallocated
+ *   ("processing/preallocateOutput")
+ * - Outputs may sit in subfolders of the OUTPUT folder (JobListBuilder
+ *   OutputLayout), with their aux/image outputs beside them; the folders
+ *   are created at dispatch, and the batch log, results CSV and metrics go
+ *   to the OUTPUT folder passed to start()
+ * - Admission control (OutputAdmission): jobs wait while their volume is at
+ *   its measured writer cap; when free space would drop below
+ *   "processing/minFreeSpaceMB" dispatch stops and the batch pauses once
+ *   the running jobs finish (diskSpaceLow)
+ * - Shared decoded inputs (DecodeCache, "processing/decodeCache"): a
+ *   compressed source read by several jobs is decoded once on a worker,
+ *   its jobs wait for that decode, and the file is evicted after its last job
+ * - Analysis filter results collected into a per-batch CSV (AnalysisResultsWriter)
+ * - Throughput telemetry (BatchMetrics): realtime factor, queue depth,
+ *   worker utilization, ETA; optional JSONL / Prometheus export
  * - Uses FilterChain to build commands
  * - Uses FFmpegRunner instances to execute
  *
  * Two entry points:
  *   1. start(files, outputFolder, filterChain, ...) — original, builds jobs internally
- *   2. start(jobs, ffmpegPath) — new, accepts pre-built jobs from JobListBuilder
+ *   2. start(jobs, ffmpegPath, outputFolder) — new, accepts pre-built jobs from JobListBuilder
  */
 class BatchProcessor : public QObject {
     Q_OBJECT
@@ -43,8 +71,20 @@ public:
         QStringList sidechainFiles;      // Per-job sidechain files (varies per algorithm)
         QString combinedBaseName;        // Pre-computed: "drumhit01_cathedral" etc.
         QString outputPath;
+        QStringList extraOutputPaths;    // Further files written by the same command (in-process Iterate)
+        QStringList branchOutputPaths;   // Aux/image files the command also writes (not in expectedBytes)
         QString command;
-        bool isCascade = false;          // If true, abort remaining jobs on failure
+        double durationSec = 0.0;        // Expected output length (sidechains may extend it); 0 = inputFile.duration
+        int dependsOn = -1;              // Index in the submitted job list that must succeed first
+        int jobId = -1;                  // Assigned by start(): index in the submitted list
+        bool analysisOnly = false;       // Writes nothing (-f null) — eligible for higher concurrency
+        qint64 expectedBytes = 0;        // Estimated size of each output file; 0 = unknown
+        bool pcmOutput = false;          // expectedBytes is exact enough to preallocate
+
+        // Two-pass loudnorm (see LoudnormMeasurement)
+        bool isMeasurement = false;      // Analysis pass: parse loudnorm JSON from its output
+        QString measurementKey;          // Shared by a measurement and the render that uses it
+        int loudnormFilterId = -1;       // Render: loudnorm instance given the measured values at dispatch
     };
 
     explicit BatchProcessor(QObject* parent = nullptr);
@@ -58,8 +98,19 @@ public:
               const QStringList& sidechainFiles,
               const QString& ffmpegPath);
 
-    // New entry point — accepts pre-built jobs from JobListBuilder
-    void start(const QList<JobInfo>& jobs, const QString& ffmpegPath);
+    // New entry point — accepts pre-built jobs from JobListBuilder. The batch
+    // log, analysis CSV and metrics export go to outputFolder itself (jobs may
+    // write into shard subfolders of it, measurement passes write nothing).
+    void start(const QList<JobInfo>& jobs, const QString& ffmpegPath,
+               const QString& outputFolder);
+
+    // Worker count for the next start(), replacing "processing/maxConcurrent"
+    // (0 = use the setting). Analysis-only batches may still widen the pool.
+    void setMaxConcurrentOverride(int workers) { m_maxConcurrentOverride = workers; }
+
+    // Whether the next start()'s chain runs analysis filters
+    // (FilterChain::hasAnalysisFilters) — the results CSV is written only then
+    void setAnalysisFilters(bool present) { m_analysisFilters = present; }
 
     // Control processing
     void pause();
@@ -72,6 +123,8 @@ public:
     int getCompletedFiles() const;
     int getFailedFiles() const;
     QString getCurrentFile() const;
+    int getWorkerCount() const { return m_workers.size(); }
+    BatchMetrics* metrics() const { return m_metrics; }
 
 signals:
     void started(int totalFiles);
@@ -82,6 +135,8 @@ signals:
     void stateChanged(BatchProcessor::State state);
     void logFileCreated(const QString& filePath);
     void logContentWritten();
+    void analysisResultsCreated(const QString& filePath);
+    void diskSpaceLow(const QString& volumePath, qint64 freeBytes, qint64 remainingBytes);
 
 private:
     struct WorkerState {
@@ -89,22 +144,50 @@ private:
         JobInfo       currentJob;              // full job — needed to re-queue on pause
         QString currentFileName;
         QString currentInputFileName;  // bare filename for log prefixing
+        QString capturedOutput;        // measurement jobs only
+        OutputStaging::Staged staged;  // temp outputs of the running job
+        AnalysisResultParser analysis; // fed while an analysis results file is open
+        QString decodingSource;        // set while the worker decodes a shared input
         bool active                   = false;
-        bool currentJobIsCascade      = false;
     };
 
     void dispatchToWorker(int workerIndex);
+    void runJob(int workerIndex, JobInfo job);
+    void startDecode(int workerIndex, const QString& source);
+    void onDecodeFinished(int workerIndex, bool success);
+    QStringList cachedSources(const JobInfo& job) const;
     int  activeWorkerCount() const;
     void onWorkerProgress(int workerIndex, FFmpegRunner::ProgressInfo info);
     void onWorkerFinished(int workerIndex, bool success);
     void setState(State newState);
+    int  abortDependents(int jobId, double* abortedAudioSec = nullptr);
+    void finishIfDone();
+    void holdForDiskSpace(const QString& outputPath);
+    void pauseIfHeld();
+    void updateQueueDepth();
     double parseDurationString(const QString& dur);
+    double jobDuration(const JobInfo& job);
+    static bool writesOutput(const JobInfo& job);
+    static qint64 outputBytes(const JobInfo& job);
+    void ensureOutputFolders(const JobInfo& job);
 
     QVector<WorkerState> m_workers;
+    int m_maxConcurrentOverride = 0;
+    bool m_analysisFilters = false;
     int m_dispatched = 0;  // total jobs dispatched so far (drives fileNumber)
+    bool m_atomicOutput = true;
+    bool m_preallocateOutput = false;
+    OutputAdmission m_admission;
+    bool m_spaceHold = false;  // low disk space: no new dispatches, pause once drained
+    QSet<QString> m_createdFolders;  // sharded output subfolders made this batch
+    DecodeCache m_decodeCache;
+    QHash<QString, QList<JobInfo>> m_decodeWaiting;  // shared source → jobs waiting for its decode
 
     LogFileWriter* logWriter;
-    QQueue<JobInfo> jobQueue;
+    AnalysisResultsWriter* m_resultsWriter;
+    BatchMetrics* m_metrics;
+    QQueue<JobInfo> jobQueue;                  // ready to run
+    QHash<int, QList<JobInfo>> m_waiting;      // predecessor jobId → blocked jobs
     State state;
     int totalFiles;
     int completedFiles;
@@ -0,0 +1,170 @@
+#include "ChainProfiler.h"
+#include "FilterChain.h"
+#include "Filters/BaseFilter.h"
+#include <QProcess>
+#include <QRegularExpression>
+#include <QDebug>
+
+ChainProfiler::ChainProfiler(QObject* parent)
+    : QObject(parent)
+{
+}
+
+ChainProfiler::~ChainProfiler() {
+    cancel();
+}
+
+bool ChainProfiler::start(const FilterChain& chain,
+                          const QString& inputFile,
+                          const QStringList& sidechainFiles,
+                          const QList<int>& mutedPositions,
+                          const QString& ffmpegPath) {
+    cancel();
+    m_stages.clear();
+    m_currentStage = 0;
+    m_durationSec = 0.0;
+    m_ffmpegPath = ffmpegPath;
+
+    // Info level so -benchmark and the input Duration line are printed
+    LogSettings logSettings;
+    logSettings.logLevel = "info";
+
+    auto stageCommand = [&](int lastPos) {
+        QString command = chain.buildPreviewStageCommand(
+            inputFile, sidechainFiles, "-", 1, lastPos, mutedPositions,
+            false, logSettings, "-f null");
+        return FilterChain::parseCommandToArgs("-benchmark " + command);
+    };
+
+    Stage baseline;
+    baseline.args = stageCommand(0);
+    baseline.filterName = "Decode";
+    m_stages.append(baseline);
+
+    for (int pos = 1; pos < chain.filterCount() - 1; ++pos) {
+        if (mutedPositions.contains(pos)) continue;
+        auto filter = chain.getFilter(pos);
+        if (!filter) continue;
+
+        Stage stage;
+        stage.args = stageCommand(pos);
+        stage.position = pos;
+        stage.filterId = filter->getFilterId();
+        stage.filterName = filter->displayName();
+        m_stages.append(stage);
+    }
+
+    if (m_stages.size() < 2) {
+        m_stages.clear();
+        return false;
+    }
+
+    startNextStage();
+    return true;
+}
+
+void ChainProfiler::cancel() {
+    if (!m_process) return;
+    m_process->disconnect(this);
+    m_process->kill();
+    m_process->waitForFinished(1000);
+    m_process->deleteLater();
+    m_process = nullptr;
+    m_stages.clear();
+}
+
+void ChainProfiler::startNextStage() {
+    const Stage& stage = m_stages[m_currentStage];
+    emit progress(m_currentStage + 1, m_stages.size(), stage.filterName);
+
+    m_stderr.clear();
+    m_process = new QProcess(this);
+    connect(m_process, &QProcess::readyReadStandardError, this, [this]() {
+        if (m_process) m_stderr += QString::fromUtf8(m_process->readAllStandardError());
+    });
+    connect(m_process, &QProcess::finished, this, &ChainProfiler::onStageFinished);
+
+    qDebug() << "ChainProfiler: Stage" << m_currentStage << m_ffmpegPath << stage.args.join(" ");
+    m_process->start(m_ffmpegPath, stage.args);
+}
+
+void ChainProfiler::onStageFinished(int exitCode) {
+    if (!m_process) return;
+
+    m_stderr += QString::fromUtf8(m_process->readAllStandardError());
+    m_process->deleteLater();
+    m_process = nullptr;
+
+    Stage& stage = m_stages[m_currentStage];
+
+    double cpuSeconds = 0.0;
+    if (exitCode != 0 || !parseBenchmark(m_stderr, &cpuSeconds)) {
+        QString message = exitCode != 0
+            ? QString("Profiling failed at \"%1\":\n%2").arg(stage.filterName, m_stderr.right(2000))
+            : QString("FFmpeg did not report benchmark timings for \"%1\".").arg(stage.filterName);
+        qWarning() << "ChainProfiler:" << message;
+        m_stages.clear();
+        emit error(message);
+        return;
+    }
+    stage.cpuSeconds = cpuSeconds;
+
+    if (m_currentStage == 0) {
+        m_durationSec = parseDuration(m_stderr);
+    }
+
+    if (++m_currentStage < m_stages.size()) {
+        startNextStage();
+    } else {
+        finish();
+    }
+}
+
+void ChainProfiler::finish() {
+    QList<FilterCost> costs;
+    double total = 0.0;
+
+    for (int i = 1; i < m_stages.size(); ++i) {
+        FilterCost cost;
+        cost.filterId = m_stages[i].filterId;
+        cost.position = m_stages[i].position;
+        // Timer jitter can make a near-free filter look negative
+        cost.cpuSeconds = qMax(0.0, m_stages[i].cpuSeconds - m_stages[i - 1].cpuSeconds);
+        if (m_durationSec > 0.0 && cost.cpuSeconds >= 0.001) {
+            cost.realtimeFactor = m_durationSec / cost.cpuSeconds;
+        }
+        total += cost.cpuSeconds;
+        costs.append(cost);
+    }
+
+    if (total > 0.0) {
+        for (auto& cost : costs) cost.share = cost.cpuSeconds / total;
+    }
+
+    qDebug() << "ChainProfiler: Finished —" << costs.size() << "filters,"
+             << total << "s CPU over" << m_durationSec << "s of audio";
+
+    m_stages.clear();
+    emit finished(costs, m_durationSec);
+}
+
+bool ChainProfiler::parseBenchmark(const QString& output, double* cpuSeconds) {
+    static const QRegularExpression re(R"(bench:\s+utime=([\d.]+)s\s+stime=([\d.]+)s)");
+    auto it = re.globalMatch(output);
+    bool found = false;
+    while (it.hasNext()) {
+        auto match = it.next();
+        *cpuSeconds = match.captured(1).toDouble() + match.captured(2).toDouble();
+        found = true;
+    }
+    return found;
+}
+
+double ChainProfiler::parseDuration(const QString& output) {
+    static const QRegularExpression re(R"(Duration:\s+(\d+):(\d+):(\d+(?:\.\d+)?))");
+    auto match = re.match(output);
+    if (!match.hasMatch()) return 0.0;
+    return match.captured(1).toDouble() * 3600.0
+         + match.captured(2).toDouble() * 60.0
+         + match.captured(3).toDouble();
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+class FilterChain;
+class QProcess;
+
+/**
+ * FilterCost - Measured processing cost of one main chain filter
+ */
+struct FilterCost {
+    int filterId = -1;
+    int position = -1;
+    double cpuSeconds = 0.0;      // user + system CPU time attributed to this filter
+    double realtimeFactor = 0.0;  // input duration / cpuSeconds (0 = too small to measure)
+    double share = 0.0;           // fraction of the chain's total filter CPU time
+};
+
+/**
+ * ChainProfiler - Per-filter CPU cost of the current chain on one file
+ *
+ * Runs the chain as a series of growing prefixes, each decoded to -f null
+ * with -benchmark:
+ *
+ *   stage 0:  INPUT                    (decode baseline)
+ *   stage 1:  INPUT → f1
+ *   stage 2:  INPUT → f1 → f2
+ *   ...
+ *
+ * A filter's cost is the CPU time (utime + stime) its stage adds over the
+ * previous one, so decode and ffmpeg startup cancel out. Stages run one at
+ * a time to keep the timings free of contention. Multi-output filters are
+ * measured together with their sub-chains; muted filters are skipped.
+ * Timings are from a single run — treat small differences as noise.
+ */
+class ChainProfiler : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ChainProfiler(QObject* parent = nullptr);
+    ~ChainProfiler() override;
+
+    // Build all stage commands up front (later chain edits don't affect a
+    // running profile) and start the first one
+    bool start(const FilterChain& chain,
+               const QString& inputFile,
+               const QStringList& sidechainFiles,
+               const QList<int>& mutedPositions,
+               const QString& ffmpegPath);
+
+    void cancel();
+    bool isRunning() const { return m_process != nullptr; }
+
+signals:
+    void progress(int stage, int stageCount, const QString& filterName);
+    void finished(const QList<FilterCost>& costs, double durationSec);
+    void error(const QString& message);
+
+private slots:
+    void onStageFinished(int exitCode);
+
+private:
+    struct Stage {
+        QStringList args;
+        int position = 0;    // last main chain position included (0 = decode only)
+        int filterId = -1;
+        QString filterName;
+        double cpuSeconds = 0.0;
+    };
+
+    void startNextStage();
+    void finish();
+
+    // "bench: utime=1.234s stime=0.056s rtime=1.400s" → utime + stime
+    static bool parseBenchmark(const QString& output, double* cpuSeconds);
+    // "Duration: 00:03:45.12" of the first input
+    static double parseDuration(const QString& output);
+
+    QList<Stage> m_stages;
+    int m_currentStage = 0;
+    QProcess* m_process = nullptr;
+    QString m_ffmpegPath;
+    QString m_stderr;
+    double m_durationSec = 0.0;
+};
@@ -4,20 +4,11 @@
 #include "AuxOutputFilter.h"
 #include "SmartAuxReturn.h"
 #include "MultiOutputFilter.h"
-#include "ff-showwavespic.h"
-#include "ff-showspectrumpic.h"
-#include "ff-anullsink.h"
-#include "ff-afir.h"
-#include "ff-sidechaincompress.h"
-#include "ff-sidechaingate.h"
-#include "ff-acrossfade.h"
-#include "ff-amerge.h"
-#include "ff-amix.h"
-#include "ff-axcorrelate.h"
-#include "ff-join.h"
 #include "ff-asplit.h"
 #include <QRegularExpression>
 #include <QStringList>
+#include <QSet>
+#include <vector>
 
 namespace DAG {
 
@@ -25,24 +16,6 @@ namespace DAG {
 // Shared helpers (used by main loop and AsplitFilter sub-chain loop)
 // ================================================================
 
-// Classify image output filters (branch via asplit, produce image file)
-static bool isImageOutputFilter(BaseFilter* f) {
-    return dynamic_cast<FFShowwavespic*>(f) ||
-           dynamic_cast<FFShowspectrumpic*>(f);
-}
-
-// Classify multi-input filters
-static bool isMultiInputFilter(BaseFilter* f) {
-    return dynamic_cast<FFAfir*>(f) ||
-           dynamic_cast<FFSidechaincompress*>(f) ||
-           dynamic_cast<FFSidechaingate*>(f) ||
-           dynamic_cast<FFAcrossfade*>(f) ||
-           dynamic_cast<FFAmerge*>(f) ||
-           dynamic_cast<FFAmix*>(f) ||
-           dynamic_cast<FFAxcorrelate*>(f) ||
-           dynamic_cast<FFJoin*>(f);
-}
-
 // Strip trailing output label [xxx] after last = or :
 static void stripTrailingOutputLabel(QString& filterStr) {
     int lastParam = qMax(filterStr.lastIndexOf('='), filterStr.lastIndexOf(':'));
@@ -66,44 +39,55 @@ QString DAGCommandBuilder::buildFilterFlags(
     auto topoOrder = graph.topologicalOrder();
     int firstNodeId = topoOrder.front();
     int lastNodeId  = topoOrder.back();
+    const size_t count = topoOrder.size();
 
     // ================================================================
-    // Helper: check if there are non-muted filters after currentIdx
-    // that produce output (including aux, waveform, asplit).
-    // Replicates FilterChain.cpp hasFiltersAfter lambda.
+    // Index pass: resolve every node once. Everything below works off
+    // these arrays, so the build is linear in the number of nodes.
     // ================================================================
-    auto hasFiltersAfter = [&](size_t currentIdx) -> bool {
-        for (size_t j = currentIdx + 1; j < topoOrder.size(); ++j) {
-            int nid = topoOrder[j];
-            if (nid == lastNodeId) continue;
-
-            int chainPos = nodeIdToChainPosition.value(nid, -1);
-            if (mutedPositions.contains(chainPos)) continue;
-
-            const FilterNode* n = graph.findNode(nid);
-            if (!n) continue;
-            BaseFilter* f = n->filter.get();
+    const QSet<int> muted(mutedPositions.cbegin(), mutedPositions.cend());
 
-            if (dynamic_cast<AuxOutputFilter*>(f) ||
-                isImageOutputFilter(f) ||
-                dynamic_cast<AsplitFilter*>(f)) {
-                return true;
-            }
-
-            if (dynamic_cast<AudioInputFilter*>(f)) {
-                continue;
-            }
+    std::vector<const FilterNode*> nodeAt(count, nullptr);
+    std::vector<bool> active(count, false);   // not an endpoint, not muted
+    std::vector<QString> flagsAt(count);
 
-            // ANullSink is chain-terminal — treat as transparent for isLastFilter purposes
-            if (dynamic_cast<FFAnullsink*>(f)) {
-                continue;
-            }
+    for (size_t i = 0; i < count; ++i) {
+        int nid = topoOrder[i];
+        nodeAt[i] = graph.findNode(nid);
+        if (!nodeAt[i] || nid == firstNodeId || nid == lastNodeId) continue;
+        if (muted.contains(nodeIdToChainPosition.value(nid, -1))) continue;
+        active[i] = true;
+        flagsAt[i] = nodeAt[i]->filter->buildFFmpegFlags();
+    }
 
-            if (!f->buildFFmpegFlags().isEmpty()) {
+    // A node "produces output" if it emits anything into the filter_complex
+    // (branch taps and asplit always do; AudioInput and anullsink never do).
+    auto producesOutput = [&](size_t i) -> bool {
+        switch (nodeAt[i]->kind) {
+            case FilterKind::AuxOutput:
+            case FilterKind::ImageOutput:
+            case FilterKind::Asplit:
                 return true;
-            }
+            case FilterKind::AudioInput:
+            case FilterKind::NullSink:
+                return false;
+            default:
+                return !flagsAt[i].isEmpty();
         }
-        return false;
+    };
+
+    // ================================================================
+    // Suffix array: liveAfter[i] — are there non-muted filters after i
+    // that produce output? (Replaces the per-node hasFiltersAfter scan.)
+    // ================================================================
+    std::vector<bool> liveAfter(count, false);
+    bool live = false;
+    for (size_t i = count; i-- > 0;) {
+        liveAfter[i] = live;
+        if (active[i] && producesOutput(i)) live = true;
+    }
+    auto hasFiltersAfter = [&](size_t currentIdx) -> bool {
+        return liveAfter[currentIdx];
     };
 
     // ================================================================
@@ -124,21 +108,14 @@ QString DAGCommandBuilder::buildFilterFlags(
     int lastWaveformIdx = -1;
     bool hasFiltersAfterBranchOutputs = false;
 
-    for (size_t i = 0; i < topoOrder.size(); ++i) {
-        int nid = topoOrder[i];
-        if (nid == firstNodeId || nid == lastNodeId) continue;
-
-        int chainPos = nodeIdToChainPosition.value(nid, -1);
-        if (mutedPositions.contains(chainPos)) continue;
-
-        const FilterNode* n = graph.findNode(nid);
-        if (!n) continue;
+    for (size_t i = 0; i < count; ++i) {
+        if (!active[i]) continue;
 
-        if (dynamic_cast<AuxOutputFilter*>(n->filter.get())) {
+        if (nodeAt[i]->kind == FilterKind::AuxOutput) {
             totalAuxOutputs++;
             lastAuxOutputIdx = static_cast<int>(i);
         }
-        if (isImageOutputFilter(n->filter.get())) {
+        if (nodeAt[i]->kind == FilterKind::ImageOutput) {
             totalWaveforms++;
             lastWaveformIdx = static_cast<int>(i);
         }
@@ -147,22 +124,15 @@ QString DAGCommandBuilder::buildFilterFlags(
     int lastBranchOutputIdx = qMax(lastAuxOutputIdx, lastWaveformIdx);
 
     if (lastBranchOutputIdx >= 0) {
-        for (size_t i = lastBranchOutputIdx + 1; i < topoOrder.size(); ++i) {
-            int nid = topoOrder[i];
-            if (nid == lastNodeId) continue;
-
-            int chainPos = nodeIdToChainPosition.value(nid, -1);
-            if (mutedPositions.contains(chainPos)) continue;
-
-            const FilterNode* n = graph.findNode(nid);
-            if (!n) continue;
-            BaseFilter* f = n->filter.get();
-
-            if ((!f->buildFFmpegFlags().isEmpty() &&
-                 !dynamic_cast<AuxOutputFilter*>(f) &&
-                 !isImageOutputFilter(f) &&
-                 !dynamic_cast<FFAnullsink*>(f)) ||
-                dynamic_cast<AsplitFilter*>(f)) {
+        for (size_t i = lastBranchOutputIdx + 1; i < count; ++i) {
+            if (!active[i]) continue;
+            FilterKind kind = nodeAt[i]->kind;
+
+            if ((!flagsAt[i].isEmpty() &&
+                 kind != FilterKind::AuxOutput &&
+                 kind != FilterKind::ImageOutput &&
+                 kind != FilterKind::NullSink) ||
+                kind == FilterKind::Asplit) {
                 hasFiltersAfterBranchOutputs = true;
                 break;
             }
@@ -175,24 +145,19 @@ QString DAGCommandBuilder::buildFilterFlags(
     // ================================================================
     // Main processing loop
     // ================================================================
-    for (size_t i = 0; i < topoOrder.size(); ++i) {
-        int nodeId = topoOrder[i];
-        if (nodeId == firstNodeId || nodeId == lastNodeId) continue;
-
-        int chainPos = nodeIdToChainPosition.value(nodeId, -1);
-        if (mutedPositions.contains(chainPos)) {
-            // Muted: invisible, don't clear sidechain state
-            continue;
-        }
+    for (size_t i = 0; i < count; ++i) {
+        // Endpoints and muted nodes are inactive.
+        // Muted: invisible, don't clear sidechain state
+        if (!active[i]) continue;
 
-        const FilterNode* node = graph.findNode(nodeId);
-        if (!node) continue;
+        const FilterNode* node = nodeAt[i];
         BaseFilter* rawFilter = node->filter.get();
+        const FilterKind kind = node->kind;
 
         // ============================================================
         // CASE 1: AuxOutputFilter — asplit branch
         // ============================================================
-        if (auto* auxOutput = dynamic_cast<AuxOutputFilter*>(rawFilter)) {
+        if (kind == FilterKind::AuxOutput) {
             auxOutputsProcessed++;
             bool isLastBranchOutput = (auxOutputsProcessed == totalAuxOutputs &&
                                        waveformsProcessed == totalWaveforms);
@@ -221,7 +186,7 @@ QString DAGCommandBuilder::buildFilterFlags(
         // ============================================================
         // CASE 2: Image output filter — asplit + image branch
         // ============================================================
-        if (isImageOutputFilter(rawFilter)) {
+        if (kind == FilterKind::ImageOutput) {
             waveformsProcessed++;
             bool isLastBranchOutput = (auxOutputsProcessed == totalAuxOutputs &&
                                        waveformsProcessed == totalWaveforms);
@@ -246,7 +211,7 @@ QString DAGCommandBuilder::buildFilterFlags(
 
             QString imageFilterCmd = QString("%1%2%3")
                 .arg(imageInputLabel)
-                .arg(rawFilter->buildFFmpegFlags())
+                .arg(flagsAt[i])
                 .arg(imageBranchLabel);
             filterStrs.append(imageFilterCmd);
 
@@ -257,7 +222,8 @@ QString DAGCommandBuilder::buildFilterFlags(
         // ============================================================
         // CASE 3: AsplitFilter — split into parallel streams with sub-chains
         // ============================================================
-        if (auto* asplitFilter = dynamic_cast<AsplitFilter*>(rawFilter)) {
+        if (kind == FilterKind::Asplit) {
+            auto* asplitFilter = static_cast<AsplitFilter*>(rawFilter);
             int filterId = rawFilter->getFilterId();
             QString hexId = hexLabelFunc(filterId);
             int numSplits = asplitFilter->numSplits();
@@ -309,12 +275,13 @@ QString DAGCommandBuilder::buildFilterFlags(
 
                         for (size_t j = 0; j < subChain.size(); j++) {
                             const auto& subFilter = subChain[j];
+                            const FilterKind subKind = FilterGraph::classify(subFilter.get());
 
                             // Skip muted sub-chain filters
                             if (subFilter->isEffectivelyMuted()) {
                                 // If skipping a multi-input consumer, clear sidechain state
                                 // so downstream filters process the main stream, not the sidechain
-                                if (isMultiInputFilter(subFilter.get())) {
+                                if (subKind == FilterKind::MultiInput) {
                                     subCurrentAudioInput = nullptr;
                                     subSidechainOutputs.clear();
                                 }
@@ -322,7 +289,8 @@ QString DAGCommandBuilder::buildFilterFlags(
                             }
 
                             // AudioInputFilter — establishes sidechain context
-                            if (auto* audioInput = dynamic_cast<AudioInputFilter*>(subFilter.get())) {
+                            if (subKind == FilterKind::AudioInput) {
+                                auto* audioInput = static_cast<AudioInputFilter*>(subFilter.get());
                                 subCurrentAudioInput = audioInput;
                                 int idx = audioInput->getInputIndex();
                                 subSidechainOutputs[idx] = QString("[%1:a]").arg(idx);
@@ -337,8 +305,8 @@ QString DAGCommandBuilder::buildFilterFlags(
                             QString subOutputLabel = QString("[%1_s%2_%3]")
                                 .arg(hexId).arg(s).arg(subHexId);
 
-                            bool subIsAnalysisTwoInput = subFilter->isAnalysisTwoInputFilter();
-                            bool subIsMultiInput = isMultiInputFilter(subFilter.get());
+                            bool subIsAnalysisTwoInput = (subKind == FilterKind::AnalysisTwoInput);
+                            bool subIsMultiInput = (subKind == FilterKind::MultiInput);
                             bool subIsInsertMode = (subCurrentAudioInput != nullptr &&
                                                     !subIsAnalysisTwoInput &&
                                                     !subIsMultiInput);
@@ -492,7 +460,8 @@ QString DAGCommandBuilder::buildFilterFlags(
         // ============================================================
         // CASE 4: AudioInputFilter — establish sidechain context
         // ============================================================
-        if (auto* audioInput = dynamic_cast<AudioInputFilter*>(rawFilter)) {
+        if (kind == FilterKind::AudioInput) {
+            auto* audioInput = static_cast<AudioInputFilter*>(rawFilter);
             currentAudioInput = audioInput;
             int idx = audioInput->getInputIndex();
             sidechainOutputs[idx] = QString("[%1:a]").arg(idx);
@@ -504,14 +473,14 @@ QString DAGCommandBuilder::buildFilterFlags(
         // hasFiltersAfter treats it as transparent, so the preceding
         // filter already outputs [out]. Command layer adds -f null -.
         // ============================================================
-        if (dynamic_cast<FFAnullsink*>(rawFilter)) {
+        if (kind == FilterKind::NullSink) {
             continue;
         }
 
         // ============================================================
         // Get filter string. If empty, skip.
         // ============================================================
-        QString filterStr = rawFilter->buildFFmpegFlags();
+        QString filterStr = flagsAt[i];
         if (filterStr.isEmpty()) continue;
 
         bool isLastFilter = !hasFiltersAfter(i);
@@ -520,9 +489,9 @@ QString DAGCommandBuilder::buildFilterFlags(
         // ============================================================
         // Classify the filter
         // ============================================================
-        bool isMultiInput = isMultiInputFilter(rawFilter);
-        bool isSmartAuxReturn = (dynamic_cast<SmartAuxReturn*>(rawFilter) != nullptr);
-        bool isAnalysisTwoInput = rawFilter->isAnalysisTwoInputFilter();
+        bool isMultiInput = (kind == FilterKind::MultiInput);
+        bool isSmartAuxReturn = (kind == FilterKind::SmartAuxReturn);
+        bool isAnalysisTwoInput = (kind == FilterKind::AnalysisTwoInput);
         bool isInInsertMode = (currentAudioInput != nullptr &&
                                !isMultiInput &&
                                !isSmartAuxReturn &&
@@ -559,7 +528,7 @@ QString DAGCommandBuilder::buildFilterFlags(
         // CASE 7: SmartAuxReturn — amix main + sidechains
         // ============================================================
         else if (isSmartAuxReturn) {
-            auto* smartAux = dynamic_cast<SmartAuxReturn*>(rawFilter);
+            auto* smartAux = static_cast<SmartAuxReturn*>(rawFilter);
             double mixLevel = smartAux ? smartAux->getMixLevel() : 0.5;
 
             QStringList inputStreams;
@@ -0,0 +1,158 @@
+#include "DecodeCache.h"
+#include <QTemporaryDir>
+#include <QStandardPaths>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDebug>
+
+DecodeCache::DecodeCache() = default;
+
+DecodeCache::~DecodeCache() {
+    clear();
+}
+
+bool DecodeCache::reset(bool enabled) {
+    clear();
+    if (!enabled) return false;
+
+    QString ffabTempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/FFAB";
+    QDir().mkpath(ffabTempDir);
+
+    m_dir = std::make_unique<QTemporaryDir>(ffabTempDir + "/batch_decode_XXXXXX");
+    if (!m_dir->isValid()) {
+        qWarning() << "DecodeCache: Could not create a folder in" << ffabTempDir
+                   << "— reading inputs directly";
+        m_dir.reset();
+        return false;
+    }
+    return true;
+}
+
+void DecodeCache::clear() {
+    if (m_dir && m_peakBytes > 0) {
+        qDebug() << "DecodeCache: Peak size" << m_peakBytes / (1024 * 1024) << "MB";
+    }
+    m_entries.clear();
+    m_dir.reset();   // removes the folder and anything still in it
+    m_nextIndex = 0;
+    m_peakBytes = 0;
+    m_liveBytes = 0;
+}
+
+// ========== SOURCES ==========
+
+QStringList DecodeCache::sourcesOf(const QString& command, const QStringList& candidates) {
+    QStringList sources;
+    for (int i = 0; i < candidates.size(); ++i) {
+        const QString& source = candidates[i];
+        if (source.isEmpty() || sources.contains(source) || !isCompressed(source)) continue;
+        if (!command.contains(QString("-i \"%1\"").arg(source))) continue;
+
+        // The decode is audio only — the main input's video must come from the original
+        if (i == 0 && command.contains("-map 0:v")) continue;
+        sources.append(source);
+    }
+    return sources;
+}
+
+bool DecodeCache::isCompressed(const QString& source) {
+    // Already PCM — reading it directly is as fast as reading a decode
+    static const QStringList uncompressed = { "wav", "wave", "aif", "aiff", "aifc", "w64", "rf64", "caf" };
+    return !uncompressed.contains(QFileInfo(source).suffix().toLower());
+}
+
+void DecodeCache::addReference(const QString& source) {
+    ++m_entries[source].refs;
+}
+
+void DecodeCache::seal() {
+    // A source read once gains nothing from a decode in between
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->refs < 2) {
+            it = m_entries.erase(it);
+        } else {
+            it->path = m_dir->filePath(QString("%1_%2.wav")
+                                           .arg(m_nextIndex++, 5, 10, QChar('0'))
+                                           .arg(QFileInfo(it.key()).completeBaseName()));
+            ++it;
+        }
+    }
+    qDebug() << "DecodeCache:" << m_entries.size() << "shared compressed inputs";
+}
+
+DecodeCache::State DecodeCache::state(const QString& source) const {
+    auto it = m_entries.constFind(source);
+    return it != m_entries.constEnd() ? it->state : State::Failed;
+}
+
+QString DecodeCache::pendingSource(const QStringList& sources) const {
+    for (const auto& source : sources) {
+        State s = state(source);
+        if (s == State::Missing || s == State::Decoding) return source;
+    }
+    return QString();
+}
+
+// ========== DECODE ==========
+
+QString DecodeCache::startDecode(const QString& source) {
+    Entry& entry = m_entries[source];
+    entry.state = State::Decoding;
+
+    // First audio stream, as a [0:a] filter input would pick; RF64 past 4 GB
+    return QString("-hide_banner -loglevel error -y -i \"%1\" -map 0:a:0 -c:a pcm_f32le -rf64 auto \"%2\"")
+        .arg(source, entry.path);
+}
+
+void DecodeCache::decodeFinished(const QString& source, bool success) {
+    auto it = m_entries.find(source);
+    if (it == m_entries.end()) return;
+
+    if (it->refs <= 0) {
+        // Every job that wanted it was aborted while it decoded
+        QFile::remove(it->path);
+        m_entries.erase(it);
+    } else if (success && QFileInfo::exists(it->path)) {
+        it->state = State::Ready;
+        m_liveBytes += QFileInfo(it->path).size();
+        m_peakBytes = qMax(m_peakBytes, m_liveBytes);
+    } else {
+        qWarning() << "DecodeCache: Decode failed for" << source << "— jobs read the original";
+        QFile::remove(it->path);
+        it->state = State::Failed;
+    }
+}
+
+void DecodeCache::decodeAborted(const QString& source) {
+    auto it = m_entries.find(source);
+    if (it == m_entries.end()) return;
+    QFile::remove(it->path);
+    it->state = State::Missing;
+}
+
+QString DecodeCache::rewriteInputs(const QString& command, const QStringList& sources) const {
+    QString rewritten = command;
+    for (const auto& source : sources) {
+        auto it = m_entries.constFind(source);
+        if (it == m_entries.constEnd() || it->state != State::Ready) continue;
+        rewritten.replace(QString("-i \"%1\"").arg(source), QString("-i \"%1\"").arg(it->path));
+    }
+    return rewritten;
+}
+
+// ========== EVICTION ==========
+
+void DecodeCache::release(const QStringList& sources) {
+    for (const auto& source : sources) {
+        auto it = m_entries.find(source);
+        if (it == m_entries.end() || --it->refs > 0) continue;
+        if (it->state == State::Decoding) continue;   // removed when the decode ends
+
+        if (it->state == State::Ready) {
+            m_liveBytes -= QFileInfo(it->path).size();
+            QFile::remove(it->path);
+        }
+        m_entries.erase(it);
+    }
+}
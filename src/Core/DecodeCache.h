@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <memory>
+
+class QTemporaryDir;
+
+/**
+ * DecodeCache - Decode shared batch inputs once
+ *
+ * Cartesian decodes every main file once per aux file and Broadcast decodes
+ * its fixed aux/IR once per main file. With "processing/decodeCache" on,
+ * each compressed source used by two or more jobs is decoded once to 32-bit
+ * float WAV in a per-batch folder under the FFAB temp folder, and jobs read
+ * that instead.
+ *
+ *   - BatchProcessor runs the decode on a worker the first time a job needs
+ *     the source; jobs needing a source that is still decoding wait for it
+ *   - Each entry counts the jobs still to run against it; the file is
+ *     deleted when the last one finishes, fails or is aborted. In Cartesian's
+ *     main-major order a main file's decode lives for its M jobs only
+ *   - A failed decode leaves the source in place — jobs read the original
+ *   - PCM sources (WAV/AIFF/...) and a main input whose video is passed
+ *     through are never cached
+ */
+class DecodeCache {
+public:
+    enum class State { Missing, Decoding, Ready, Failed };
+
+    DecodeCache();
+    ~DecodeCache();
+
+    // Start a batch; false leaves the cache disabled
+    bool reset(bool enabled);
+    bool isEnabled() const { return m_dir != nullptr; }
+
+    // Delete every decoded file and disable the cache
+    void clear();
+
+    // Compressed sources the command reads with -i. candidates[0] is the main input.
+    static QStringList sourcesOf(const QString& command, const QStringList& candidates);
+
+    // Counting pass at batch start, then drop sources used only once
+    void addReference(const QString& source);
+    void seal();
+
+    bool contains(const QString& source) const { return m_entries.contains(source); }
+    State state(const QString& source) const;
+
+    // First source of a job that is not decoded yet (Missing or Decoding), or empty
+    QString pendingSource(const QStringList& sources) const;
+
+    // Marks the source Decoding and returns the ffmpeg command that decodes it
+    QString startDecode(const QString& source);
+    void decodeFinished(const QString& source, bool success);
+    void decodeAborted(const QString& source);   // paused — decode again later
+
+    // Point each -i at its decoded file where one is ready
+    QString rewriteInputs(const QString& command, const QStringList& sources) const;
+
+    // A job reading these sources will not run again — evict unused files
+    void release(const QStringList& sources);
+
+private:
+    struct Entry {
+        QString path;
+        int refs = 0;
+        State state = State::Missing;
+    };
+
+    static bool isCompressed(const QString& source);
+
+    std::unique_ptr<QTemporaryDir> m_dir;
+    QHash<QString, Entry> m_entries;   // source path → decoded file
+    int m_nextIndex = 0;
+    qint64 m_peakBytes = 0;
+    qint64 m_liveBytes = 0;
+};
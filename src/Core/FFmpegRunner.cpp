@@ -80,6 +80,13 @@ void FFmpegRunner::cancel() {
     }
 }
 
+void FFmpegRunner::cancelAndWait() {
+    cancel();
+    if (process->state() != QProcess::NotRunning) {
+        process->waitForFinished();
+    }
+}
+
 bool FFmpegRunner::isRunning() const {
     return status == Status::Running;
 }
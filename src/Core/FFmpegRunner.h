@@ -44,6 +44,10 @@ public:
 
     // Cancel current process
     void cancel();
+    
+    // Cancel and block until the process has exited — finished(false) has
+    // been emitted when this returns
+    void cancelAndWait();
 
     // Check if currently running
     bool isRunning() const;
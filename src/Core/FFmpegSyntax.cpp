@@ -2,6 +2,7 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QTextBlock>
 #include <QDebug>
 
 // ============================================================================
@@ -15,8 +16,11 @@ FFmpegHighlighter::FFmpegHighlighter(QTextDocument* parent)
 }
 
 void FFmpegHighlighter::loadSyntax(const QString& json) {
-    rules.clear();
-    
+    syntaxJson = json;
+    rules = parseRules(json);
+}
+
+QVector<SyntaxRule> FFmpegHighlighter::parseRules(const QString& json) {
     QString syntaxSource = json.isEmpty() 
         ? QString::fromUtf8(FFmpegSyntaxDef::syntaxJson) 
         : json;
@@ -26,13 +30,14 @@ void FFmpegHighlighter::loadSyntax(const QString& json) {
     
     if (error.error != QJsonParseError::NoError) {
         qWarning() << "FFmpegHighlighter: JSON parse error:" << error.errorString();
-        return;
+        return {};
     }
     
-    parseJsonSyntax(doc.object());
+    return parseJsonSyntax(doc.object());
 }
 
-void FFmpegHighlighter::parseJsonSyntax(const QJsonObject& root) {
+QVector<SyntaxRule> FFmpegHighlighter::parseJsonSyntax(const QJsonObject& root) {
+    QVector<SyntaxRule> parsed;
     QJsonArray tokens = root["tokens"].toArray();
     
     for (const QJsonValue& tokenVal : tokens) {
@@ -50,14 +55,15 @@ void FFmpegHighlighter::parseJsonSyntax(const QJsonObject& root) {
         rule.format = createFormat(color);
         
         if (rule.pattern.isValid()) {
-            rules.append(rule);
+            parsed.append(rule);
         } else {
             qWarning() << "FFmpegHighlighter: Invalid pattern for scope" << scope 
                        << ":" << rule.pattern.errorString();
         }
     }
     
-    qDebug() << "FFmpegHighlighter: Loaded" << rules.size() << "syntax rules";
+    qDebug() << "FFmpegHighlighter: Loaded" << parsed.size() << "syntax rules";
+    return parsed;
 }
 
 QTextCharFormat FFmpegHighlighter::createFormat(const QString& colorHex) {
@@ -67,17 +73,46 @@ QTextCharFormat FFmpegHighlighter::createFormat(const QString& colorHex) {
 }
 
 void FFmpegHighlighter::highlightBlock(const QString& text) {
-    // Apply each rule in order (later rules can override earlier)
-    for (const SyntaxRule& rule : rules) {
-        QRegularExpressionMatchIterator it = rule.pattern.globalMatch(text);
-        
-        while (it.hasNext()) {
-            QRegularExpressionMatch match = it.next();
-            int start = match.capturedStart();
-            int length = match.capturedLength();
-            setFormat(start, length, rule.format);
+    Q_UNUSED(text);
+    int line = currentBlock().blockNumber();
+    if (line < 0 || line >= lineSpans.size()) return;
+    
+    for (const SyntaxSpan& span : lineSpans[line]) {
+        setFormat(span.start, span.length, span.format);
+    }
+}
+
+SyntaxLineSpans FFmpegHighlighter::computeSpans(const QString& text, const QString& syntaxSource) {
+    // Recompiled only when a different syntax is requested on this thread
+    thread_local QString threadSource;
+    thread_local QVector<SyntaxRule> threadRules = parseRules(QString());
+    if (syntaxSource != threadSource) {
+        threadSource = syntaxSource;
+        threadRules = parseRules(syntaxSource);
+    }
+    
+    // Lines match QTextDocument blocks after setPlainText(). Each rule is
+    // applied in order, so later rules override earlier ones.
+    const QStringList lines = text.split('\n');
+    SyntaxLineSpans spans(lines.size());
+    
+    for (int line = 0; line < lines.size(); ++line) {
+        for (const SyntaxRule& rule : threadRules) {
+            QRegularExpressionMatchIterator it = rule.pattern.globalMatch(lines[line]);
+            
+            while (it.hasNext()) {
+                QRegularExpressionMatch match = it.next();
+                spans[line].append({static_cast<int>(match.capturedStart()),
+                                    static_cast<int>(match.capturedLength()),
+                                    rule.format});
+            }
         }
     }
+    return spans;
+}
+
+void FFmpegHighlighter::setLineSpans(const SyntaxLineSpans& spans) {
+    lineSpans = spans;
 }
 
 QString FFmpegHighlighter::exportToTextMate() const {
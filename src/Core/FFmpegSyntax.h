@@ -113,6 +113,15 @@ struct SyntaxRule {
     QTextCharFormat format;
 };
 
+// One highlighted run, relative to the start of its line
+struct SyntaxSpan {
+    int start = 0;
+    int length = 0;
+    QTextCharFormat format;
+};
+
+using SyntaxLineSpans = QVector<QVector<SyntaxSpan>>;  // indexed by line (text block)
+
 
 // ============================================================================
 // FFMPEG HIGHLIGHTER (QSyntaxHighlighter subclass)
@@ -125,17 +134,31 @@ public:
     // Load syntax from JSON (uses embedded default if not specified)
     void loadSyntax(const QString& json = QString());
     
+    // JSON passed to loadSyntax() — empty for the embedded default
+    QString syntaxSource() const { return syntaxJson; }
+    
     // Export current syntax to TextMate JSON format
     QString exportToTextMate() const;
     
+    // Run the rules of syntaxSource over every line of text, away from any
+    // document. Thread-safe — each thread compiles its own copy of the rules.
+    static SyntaxLineSpans computeSpans(const QString& text, const QString& syntaxSource = QString());
+    
+    // Spans computed for the text about to be set; highlightBlock() applies
+    // them instead of running the rules on the UI thread
+    void setLineSpans(const SyntaxLineSpans& spans);
+    
 protected:
     void highlightBlock(const QString& text) override;
     
 private:
-    void parseJsonSyntax(const QJsonObject& root);
-    QTextCharFormat createFormat(const QString& colorHex);
+    static QVector<SyntaxRule> parseRules(const QString& json);
+    static QVector<SyntaxRule> parseJsonSyntax(const QJsonObject& root);
+    static QTextCharFormat createFormat(const QString& colorHex);
     
-    QVector<SyntaxRule> rules;
+    QString syntaxJson;
+    QVector<SyntaxRule> rules;   // for exportToTextMate()
+    SyntaxLineSpans lineSpans;
 };
 
 
@@ -1,4 +1,6 @@
 #include "FilterChain.h"
+#include "LoudnormMeasurement.h"
+#include "FilterRegistry.h"
 #include "BaseFilter.h"
 #include "InputFilter.h"
 #include "OutputFilter.h"
@@ -127,9 +129,11 @@
 #include <QJsonArray>
 #include <QFile>
 #include <QFileInfo>
+#include <QDir>
 #include <QDebug>
 #include <QRegularExpression>
 #include <QSettings>
+#include <QSet>
 #include <algorithm>
 
 // ========== LogSettings Implementation ==========
@@ -145,6 +149,13 @@ QString LogSettings::buildFlags() const {
     return args.join(" ");
 }
 
+LogSettings LogSettings::atLeastInfo() const {
+    static const QStringList quietLevels = {"quiet", "panic", "fatal", "error", "warning"};
+    LogSettings raised = *this;
+    if (quietLevels.contains(raised.logLevel)) raised.logLevel = "info";
+    return raised;
+}
+
 LogSettings LogSettings::preview() {
     return LogSettings();
 }
@@ -160,8 +171,7 @@ LogSettings LogSettings::fromQSettings() {
 
 // Classify image output filters (branch via asplit, produce image file)
 static bool isImageOutputFilter(BaseFilter* f) {
-    return dynamic_cast<FFShowwavespic*>(f) ||
-           dynamic_cast<FFShowspectrumpic*>(f);
+    return FilterRegistry::kindOf(f) == DAG::FilterKind::ImageOutput;
 }
 
 // Extract common properties from image output filters (both types share same interface)
@@ -191,6 +201,8 @@ const std::vector<std::shared_ptr<BaseFilter>> FilterChain::s_emptyChain;
 FilterChain::FilterChain() {
     inputFilter = new InputFilter();
     outputFilter = new OutputFilter();
+    inputFilter->setTypeInfo(FilterRegistry::instance().find("input"));
+    outputFilter->setTypeInfo(FilterRegistry::instance().find("output"));
     
     // First middle filter will be #1
     m_nextFilterId = 1;
@@ -322,7 +334,8 @@ QString FilterChain::getFilterHexLabel(int filterId) const {
 
 QString FilterChain::buildCompleteCommand(const QString& inputFile, const QString& outputFile,
                                          const LogSettings& logSettings) const {
-    QString command = logSettings.buildFlags() + " ";
+    // Measurement filters report at info level
+    QString command = (hasAnalysisFilters() ? logSettings.atLeastInfo() : logSettings).buildFlags() + " ";
     
     if (inputFilter) {
         QString inputFlags = inputFilter->buildFFmpegFlags();
@@ -375,7 +388,7 @@ QString FilterChain::buildCompleteCommand(const QString& inputFile, const QStrin
             QString auxBranchLabel = QString("[%1-auxOut]").arg(filterIdLabel);
 
             // Build output file path
-            QString auxOutputPath = buildAuxOutputPath(inputFile, auxOut, auxIndex);
+            QString auxOutputPath = buildAuxOutputPath(inputFile, outputFile, auxOut, auxIndex);
 
             // Append output mapping
             command += QString(" -map \"%1\" %2 \"%3\"")
@@ -395,7 +408,7 @@ QString FilterChain::buildCompleteCommand(const QString& inputFile, const QStrin
             QString imageBranchLabel = QString("[%1-waveform]").arg(filterIdLabel);
 
             auto info = getImageFilterInfo(filters[i].get());
-            QString imageOutputPath = buildImageOutputPath(inputFile, filters[i].get());
+            QString imageOutputPath = buildImageOutputPath(inputFile, outputFile, filters[i].get());
 
             command += QString(" -map \"%1\" %2 \"%3\"")
                 .arg(imageBranchLabel)
@@ -417,7 +430,8 @@ QString FilterChain::buildFilterFlags() const {
 QString FilterChain::buildCompleteCommand(const QString& inputFile, const QString& outputFile,
                                          const QList<int>& mutedPositions,
                                          const LogSettings& logSettings) const {
-    QString command = logSettings.buildFlags() + " ";
+    QString command = (hasAnalysisFilters(mutedPositions) ? logSettings.atLeastInfo() : logSettings)
+                          .buildFlags() + " ";
     
     if (inputFilter) {
         QString inputFlags = inputFilter->buildFFmpegFlags();
@@ -468,7 +482,7 @@ QString FilterChain::buildCompleteCommand(const QString& inputFile, const QStrin
             QString auxBranchLabel = QString("[%1-auxOut]").arg(filterIdLabel);
             
             // Build output file path
-            QString auxOutputPath = buildAuxOutputPath(inputFile, auxOut, auxIndex);
+            QString auxOutputPath = buildAuxOutputPath(inputFile, outputFile, auxOut, auxIndex);
             
             // Append output mapping
             command += QString(" -map \"%1\" %2 \"%3\"") // quotes for View Command, stripped by QProcess
@@ -492,7 +506,7 @@ QString FilterChain::buildCompleteCommand(const QString& inputFile, const QStrin
             QString imageBranchLabel = QString("[%1-waveform]").arg(filterIdLabel);
 
             auto info = getImageFilterInfo(filters[i].get());
-            QString imageOutputPath = buildImageOutputPath(inputFile, filters[i].get());
+            QString imageOutputPath = buildImageOutputPath(inputFile, outputFile, filters[i].get());
 
             command += QString(" -map \"%1\" %2 \"%3\"")
                 .arg(imageBranchLabel)
@@ -925,14 +939,7 @@ QString FilterChain::buildFilterFlags(const QList<int>& mutedPositions) const {
         bool isLastFilter = !hasFiltersAfter(i);
         int filterId = filters[i]->getFilterId();
 
-        bool isMultiInputFilter = (dynamic_cast<FFAfir*>(filters[i].get()) ||
-                                   dynamic_cast<FFSidechaincompress*>(filters[i].get()) ||
-                                   dynamic_cast<FFSidechaingate*>(filters[i].get()) ||
-                                   dynamic_cast<FFAcrossfade*>(filters[i].get()) ||
-                                   dynamic_cast<FFAmerge*>(filters[i].get()) ||
-                                   dynamic_cast<FFAmix*>(filters[i].get()) ||
-                                   dynamic_cast<FFAxcorrelate*>(filters[i].get()) ||
-                                   dynamic_cast<FFJoin*>(filters[i].get()));
+        bool isMultiInputFilter = FilterRegistry::kindOf(filters[i].get()) == DAG::FilterKind::MultiInput;
 
         bool isSmartAuxReturn = (dynamic_cast<SmartAuxReturn*>(filters[i].get()) != nullptr);
 
@@ -1197,8 +1204,25 @@ bool FilterChain::useDAGPath(const QList<int>& /*mutedPositions*/) const {
 }
 
 QString FilterChain::buildFilterFlagsDAG(const QList<int>& mutedPositions) const {
+    return buildFilterFlagsDAG(mutedPositions, 1, static_cast<int>(filters.size()) - 2);
+}
+
+QString FilterChain::buildFilterFlagsDAG(const QList<int>& mutedPositions, int firstPos, int lastPos) const {
+    if (filters.size() < 2) return "";
+
+    // INPUT + filters[firstPos..lastPos] + OUTPUT. The builder skips the two
+    // endpoints, so a partial range is wired [0:a] → ... → [out] like a full chain.
+    std::vector<std::shared_ptr<BaseFilter>> range;
+    range.push_back(filters.front());
+    firstPos = qMax(firstPos, 1);
+    lastPos = qMin(lastPos, static_cast<int>(filters.size()) - 2);
+    for (int i = firstPos; i <= lastPos; ++i) {
+        range.push_back(filters[i]);
+    }
+    range.push_back(filters.back());
+
     DAG::FilterGraph graph;
-    graph.buildLinearChain(filters);
+    graph.buildLinearChain(range);
 
     QMap<int, int> nodeIdToPos;
     for (size_t i = 0; i < filters.size(); ++i) {
@@ -1213,25 +1237,37 @@ QString FilterChain::buildFilterFlagsDAG(const QList<int>& mutedPositions) const
         graph, mutedPositions, nodeIdToPos, hexFunc);
 }
 
-QString FilterChain::buildAuxOutputPath(const QString& inputFile, AuxOutputFilter* auxOut, int auxIndex) const {
+QString FilterChain::branchOutputFolder(const QString& inputFile, const QString& outputFile) const {
+    if (!outputFilter || outputFilter->getOutputFolder().isEmpty()) {
+        // Fallback to input directory
+        return QFileInfo(inputFile).absolutePath();
+    }
+
+    // Main OUTPUT filter's folder — or the shard subfolder of it the main
+    // output was placed in (OutputLayout), so a job's files stay together
+    QString outputDir = QDir::cleanPath(outputFilter->getOutputFolder());
+    if (!outputFile.isEmpty()) {
+        QString mainDir = QFileInfo(outputFile).absolutePath();
+        if (mainDir.startsWith(QDir(outputDir).absolutePath() + '/')) return mainDir;
+    }
+    return outputDir;
+}
+
+QString FilterChain::buildAuxOutputPath(const QString& inputFile, const QString& outputFile,
+                                        AuxOutputFilter* auxOut, int auxIndex) const {
     if (!auxOut) return "";
     
     // Extract base filename without extension
     QFileInfo fileInfo(inputFile);
     QString baseName = fileInfo.completeBaseName();  // filename without extension
-    QString inputDir = fileInfo.absolutePath();
     
     // Determine output directory
     QString outputDir;
     if (auxOut->getUseCustomOutputFolder() && !auxOut->getOutputFolder().isEmpty()) {
         // Use aux output's custom folder
         outputDir = auxOut->getOutputFolder();
-    } else if (outputFilter && !outputFilter->getOutputFolder().isEmpty()) {
-        // Use main OUTPUT filter's folder
-        outputDir = outputFilter->getOutputFolder();
     } else {
-        // Fallback to input directory
-        outputDir = inputDir;
+        outputDir = branchOutputFolder(inputFile, outputFile);
     }
     
     // Get suffix from aux output
@@ -1247,7 +1283,8 @@ QString FilterChain::buildAuxOutputPath(const QString& inputFile, AuxOutputFilte
     return QString("%1/%2%3.%4").arg(outputDir).arg(baseName).arg(suffix).arg(extension);
 }
 
-QString FilterChain::buildImageOutputPath(const QString& inputFile, BaseFilter* imageFilter) const {
+QString FilterChain::buildImageOutputPath(const QString& inputFile, const QString& outputFile,
+                                          BaseFilter* imageFilter) const {
     if (!imageFilter) return "";
 
     auto info = getImageFilterInfo(imageFilter);
@@ -1255,16 +1292,13 @@ QString FilterChain::buildImageOutputPath(const QString& inputFile, BaseFilter*
     // Extract base filename without extension
     QFileInfo fileInfo(inputFile);
     QString baseName = fileInfo.completeBaseName();
-    QString inputDir = fileInfo.absolutePath();
 
     // Determine output directory
     QString outputDir;
     if (info.useCustomOutputFolder && !info.outputFolder.isEmpty()) {
         outputDir = info.outputFolder;
-    } else if (outputFilter && !outputFilter->getOutputFolder().isEmpty()) {
-        outputDir = outputFilter->getOutputFolder();
     } else {
-        outputDir = inputDir;
+        outputDir = branchOutputFolder(inputFile, outputFile);
     }
 
     // Build full path: <dir>/<basename><suffix>.<ext>
@@ -1319,7 +1353,8 @@ QString FilterChain::buildCompleteCommand(const QString& inputFile,
                                          const QString& outputFile,
                                          const QList<int>& mutedPositions,
                                          const LogSettings& logSettings) const {
-    QString command = logSettings.buildFlags() + " ";
+    QString command = (hasAnalysisFilters(mutedPositions) ? logSettings.atLeastInfo() : logSettings)
+                          .buildFlags() + " ";
     
     if (inputFilter) {
         QString inputFlags = inputFilter->buildFFmpegFlags();
@@ -1386,7 +1421,7 @@ QString FilterChain::buildCompleteCommand(const QString& inputFile,
             qDebug() << "  Found AuxOutput filter! ID:" << filterId << "Label:" << auxBranchLabel;
             
             // Build output file path
-            QString auxOutputPath = buildAuxOutputPath(inputFile, auxOut, auxIndex);
+            QString auxOutputPath = buildAuxOutputPath(inputFile, outputFile, auxOut, auxIndex);
             qDebug() << "  Aux output path:" << auxOutputPath;
             
             QString codecFlags = auxOut->getCodecFlags();
@@ -1420,7 +1455,7 @@ QString FilterChain::buildCompleteCommand(const QString& inputFile,
             qDebug() << "  Found image output filter! ID:" << filterId << "Label:" << imageBranchLabel;
 
             auto info = getImageFilterInfo(filters[i].get());
-            QString imageOutputPath = buildImageOutputPath(inputFile, filters[i].get());
+            QString imageOutputPath = buildImageOutputPath(inputFile, outputFile, filters[i].get());
             qDebug() << "  Image output path:" << imageOutputPath;
             qDebug() << "  Video codec flags:" << info.videoCodecFlags;
 
@@ -1521,10 +1556,421 @@ QString FilterChain::buildPreviewCommand(const QString& inputFile,
             command += QString(" -map %1 -f null -").arg(imageBranchLabel);
         }
     }
-    
+
+    return command.trimmed();
+}
+
+// ========== Preview Stage Caching ==========
+
+// Filters slow enough that re-rendering them on every preview hurts
+static bool isExpensivePreviewStage(BaseFilter* f) {
+    const QString type = f->filterType();
+    return type == "ff-afir" || type == "ff-rubberband" || type == "ff-afftdn";
+}
+
+QStringList FilterChain::buildStageSignatures(const QList<int>& mutedPositions) const {
+    QStringList signatures;
+    for (size_t i = 0; i < filters.size(); ++i) {
+        BaseFilter* f = filters[i].get();
+        bool muted = mutedPositions.contains(static_cast<int>(i));
+        QString sig = f->filterType() + "|" + (muted ? "M" : "-") + "|" + f->buildFFmpegFlags();
+
+        // Multi-output filters build their routing from sub-chains, not from
+        // their own flags — fold the serialized sub-chains and stamped mutes in.
+        if (auto* multiOut = dynamic_cast<MultiOutputFilter*>(f)) {
+            QJsonObject json;
+            multiOut->toJSON(json);
+            sig += "|" + QString::fromUtf8(QJsonDocument(json).toJson(QJsonDocument::Compact));
+            for (int s = 0; s < MultiOutputFilter::MAX_STREAMS; ++s) {
+                for (const auto& sub : multiOut->getSubChain(s)) {
+                    sig += sub->isEffectivelyMuted() ? "M" : "-";
+                }
+            }
+        }
+        signatures << sig;
+    }
+    return signatures;
+}
+
+QList<int> FilterChain::findPreviewCutPoints(const QList<int>& mutedPositions) const {
+    QList<int> cutPoints;
+    if (filters.size() <= 2 || endsWithSinkFilter(mutedPositions)) return cutPoints;
+
+    // Walk the main chain tracking the same sidechain state the DAG builder
+    // does. A cut is only safe where that state is empty — a stage file
+    // carries the main stream only.
+    bool sidechainActive = false;
+    for (int i = 1; i < static_cast<int>(filters.size()) - 1; ++i) {
+        if (mutedPositions.contains(i)) continue;
+        BaseFilter* f = filters[i].get();
+
+        // Labels that can be referenced further down the chain make any split unsafe
+        if (f->usesCustomOutputStream()) return {};
+        if (auto* custom = dynamic_cast<CustomFFmpegFilter*>(f)) {
+            if (custom->getManualOutputLabels()) return {};
+        }
+
+        const DAG::FilterKind kind = DAG::FilterGraph::classify(f);
+        if (kind == DAG::FilterKind::AudioInput) {
+            sidechainActive = true;
+            continue;
+        }
+
+        bool consumesSidechain = kind == DAG::FilterKind::MultiInput ||
+                                 kind == DAG::FilterKind::SmartAuxReturn ||
+                                 kind == DAG::FilterKind::Asplit;
+        bool inInsertMode = sidechainActive && !consumesSidechain &&
+                            kind != DAG::FilterKind::AnalysisTwoInput;
+
+        if (consumesSidechain) {
+            sidechainActive = false;
+        }
+
+        if (!inInsertMode && !sidechainActive &&
+            isExpensivePreviewStage(f) && !f->buildFFmpegFlags().isEmpty()) {
+            cutPoints << i;
+        }
+    }
+    return cutPoints;
+}
+
+QString FilterChain::buildPreviewStageCommand(const QString& inputFile,
+                                              const QStringList& sidechainFiles,
+                                              const QString& outputFile,
+                                              int firstPos,
+                                              int lastPos,
+                                              const QList<int>& mutedPositions,
+                                              bool finalStage,
+                                              const LogSettings& logSettings,
+                                              const QString& outputFlagsOverride) const {
+    QString command = logSettings.buildFlags() + " ";
+    command += QString("-i \"%1\" ").arg(inputFile);
+
+    // Sidechain inputs keep their indices in every stage so [N:a] labels stay valid
+    int audioInputCount = getRequiredAudioInputCount();
+    for (int i = 0; i < audioInputCount; ++i) {
+        if (i < sidechainFiles.size() && !sidechainFiles[i].isEmpty()) {
+            command += QString("-i \"%1\" ").arg(sidechainFiles[i]);
+        } else {
+            command += "-f lavfi -i anullsrc=duration=1 ";
+        }
+    }
+
+    bool chainEndsWithSink = finalStage && endsWithSinkFilter(mutedPositions);
+
+    QString filterFlags = buildFilterFlagsDAG(mutedPositions, firstPos, lastPos);
+    if (!filterFlags.isEmpty()) {
+        command += "-filter_complex \"" + filterFlags + "\" ";
+        if (!chainEndsWithSink) {
+            command += "-map \"[out]\" ";
+        }
+    } else {
+        command += "-map 0:a ";
+    }
+
+    if (!chainEndsWithSink) {
+        if (!outputFlagsOverride.isEmpty()) {
+            command += outputFlagsOverride + " ";
+        } else if (finalStage) {
+            if (outputFilter) command += outputFilter->buildFFmpegFlags() + " ";
+        } else {
+            command += "-c:a pcm_f32le ";
+        }
+        command += QString("\"%1\"").arg(outputFile);
+    }
+
+    // Discard aux and image branches that fall inside this stage
+    for (int i = qMax(firstPos, 1); i <= lastPos && i < static_cast<int>(filters.size()) - 1; ++i) {
+        if (mutedPositions.contains(i)) continue;
+
+        QString filterIdLabel = getFilterHexLabel(filters[i]->getFilterId());
+        if (dynamic_cast<AuxOutputFilter*>(filters[i].get())) {
+            command += QString(" -map [%1-auxOut] -f null -").arg(filterIdLabel);
+        } else if (isImageOutputFilter(filters[i].get())) {
+            command += QString(" -map [%1-waveform] -f null -").arg(filterIdLabel);
+        }
+    }
+
+    return command.trimmed();
+}
+
+QString FilterChain::buildIterateCommand(const QString& inputFile,
+                                         const QStringList& outputFiles,
+                                         const QList<int>& mutedPositions,
+                                         double gainDb,
+                                         const LogSettings& logSettings) const {
+    if (filters.size() < 2 || outputFiles.isEmpty()) return "";
+
+    // Output flags are repeated per mapped file, so they can't map streams themselves
+    if (outputFilter && (outputFilter->isVideoPassthrough()
+                         || outputFilter->buildFFmpegFlags().contains("-map"))) {
+        return "";
+    }
+
+    // Stages of one pass, built once: [volume=gainDb →] active filters
+    // [→ output format]. Passes are chained by label, so every stage must be
+    // a single plain segment.
+    static const QRegularExpression leadingLabels(R"(^(\[[^\]]*\])+)");
+    static const QRegularExpression trailingLabels(R"((\[[^\]]*\])+$)");
+
+    QStringList stages;
+    if (!qFuzzyCompare(gainDb, 0.0)) {
+        FFVolume volume;
+        volume.setDecibels(gainDb);
+        stages << volume.buildFFmpegFlags();
+    }
+
+    for (int pos = 1; pos < static_cast<int>(filters.size()) - 1; ++pos) {
+        if (mutedPositions.contains(pos)) continue;
+
+        BaseFilter* filter = filters[pos].get();
+        if (DAG::FilterGraph::classify(filter) != DAG::FilterKind::Normal
+            || filter->usesCustomOutputStream()
+            || filter->handlesOwnInputRouting()) {
+            return "";
+        }
+        if (auto* customFilter = dynamic_cast<CustomFFmpegFilter*>(filter)) {
+            if (customFilter->getManualOutputLabels()) return "";
+        }
+
+        QString flags = filter->buildFFmpegFlags();
+        if (flags.isEmpty()) continue;
+        if (flags.contains(';')) return "";
+        flags.remove(leadingLabels);
+        flags.remove(trailingLabels);
+        stages << flags;
+    }
+
+    // Cascade mode writes each pass in the OUTPUT format and re-reads it;
+    // convert to that format after every pass so both modes sound the same
+    if (outputFilter) {
+        QString format = outputFilter->passFormatFilter();
+        if (format.isEmpty()) return "";   // lossy or custom: only cascade reproduces it
+        stages << format;
+    }
+    if (stages.isEmpty()) stages << "anull";
+
+    // The end of every pass but the last is split between its own output
+    // and the next pass
+    QStringList filterStrs;
+    QStringList passLabels;
+    QString current = "[0:a]";
+    for (int pass = 0; pass < outputFiles.size(); ++pass) {
+        for (int s = 0; s < stages.size(); ++s) {
+            QString label = QString("[i%1_%2]").arg(pass).arg(s);
+            filterStrs.append(current + stages[s] + label);
+            current = label;
+        }
+
+        if (pass + 1 < outputFiles.size()) {
+            QString tap = QString("[i%1_out]").arg(pass);
+            QString next = QString("[i%1_next]").arg(pass);
+            filterStrs.append(current + "asplit=2" + tap + next);
+            passLabels << tap;
+            current = next;
+        } else {
+            passLabels << current;
+        }
+    }
+
+    QString command = (hasAnalysisFilters(mutedPositions) ? logSettings.atLeastInfo() : logSettings)
+                          .buildFlags() + " ";
+    command += QString("-i \"%1\" ").arg(inputFile);
+    command += "-filter_complex \"" + filterStrs.join(";") + "\"";
+
+    QString outputFlags = outputFilter ? outputFilter->buildFFmpegFlags() : QString();
+    for (int pass = 0; pass < passLabels.size(); ++pass) {
+        command += QString(" -map \"%1\" ").arg(passLabels[pass]);
+        if (!outputFlags.isEmpty()) command += outputFlags + " ";
+        command += QString("\"%1\"").arg(outputFiles[pass]);
+    }
+
     return command.trimmed();
 }
 
+bool FilterChain::isAnalysisOnly(const QList<int>& mutedPositions) const {
+    // Aux and image outputs still write files — those chains render normally
+    for (int i = 1; i < static_cast<int>(filters.size()) - 1; ++i) {
+        if (mutedPositions.contains(i)) continue;
+        if (dynamic_cast<AuxOutputFilter*>(filters[i].get()) || isImageOutputFilter(filters[i].get())) {
+            return false;
+        }
+    }
+
+    if (endsWithSinkFilter(mutedPositions)) return true;
+
+    static const QStringList measurementTypes = {
+        "ff-astats", "ff-volumedetect", "ff-silencedetect", "ff-drmeter",
+        "ff-replaygain", "ff-ashowinfo", "ff-anull"
+    };
+
+    bool hasMeasurement = false;
+    for (int i = 1; i < static_cast<int>(filters.size()) - 1; ++i) {
+        if (mutedPositions.contains(i)) continue;
+
+        QString type = filters[i]->filterType();
+        if (!measurementTypes.contains(type)) return false;
+        if (type != "ff-anull") hasMeasurement = true;
+    }
+    return hasMeasurement;
+}
+
+bool FilterChain::hasAnalysisFilters(const QList<int>& mutedPositions) const {
+    for (int i = 1; i < static_cast<int>(filters.size()) - 1; ++i) {
+        if (mutedPositions.contains(i)) continue;
+        if (FilterRegistry::reportsAnalysis(filters[i].get())) return true;
+
+        if (auto* multi = dynamic_cast<MultiOutputFilter*>(filters[i].get())) {
+            for (int stream = 0; stream < multi->getNumOutputStreams(); ++stream) {
+                for (const auto& sub : multi->getSubChain(stream)) {
+                    if (FilterRegistry::reportsAnalysis(sub.get())) return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+QStringList FilterChain::branchOutputPaths(const QString& inputFile, const QString& outputFile,
+                                           const QList<int>& mutedPositions) const {
+    // Same order and aux numbering as the mappings buildCompleteCommand appends
+    QStringList paths;
+    int auxIndex = 1;
+    for (int i = 1; i < static_cast<int>(filters.size()) - 1; ++i) {
+        if (mutedPositions.contains(i)) continue;
+        if (auto* auxOut = dynamic_cast<AuxOutputFilter*>(filters[i].get())) {
+            paths.append(buildAuxOutputPath(inputFile, outputFile, auxOut, auxIndex++));
+        }
+    }
+    for (int i = 1; i < static_cast<int>(filters.size()) - 1; ++i) {
+        if (mutedPositions.contains(i)) continue;
+        if (isImageOutputFilter(filters[i].get())) {
+            paths.append(buildImageOutputPath(inputFile, outputFile, filters[i].get()));
+        }
+    }
+    return paths;
+}
+
+double FilterChain::estimateOutputDuration(double mainSec,
+                                           const QList<double>& sidechainSec,
+                                           const QList<int>& mutedPositions) const {
+    double longest = 0.0;
+    double shortest = 0.0;
+    for (double sec : sidechainSec) {
+        if (sec <= 0.0) continue;
+        longest = qMax(longest, sec);
+        shortest = shortest > 0.0 ? qMin(shortest, sec) : sec;
+    }
+    if (longest <= 0.0) return mainSec;
+
+    double result = mainSec;
+    for (int i = 1; i < static_cast<int>(filters.size()) - 1; ++i) {
+        if (mutedPositions.contains(i)) continue;
+
+        const QString type = filters[i]->filterType();
+        if (type == "ff-amix") {
+            QString flags = filters[i]->buildFFmpegFlags();
+            if (flags.contains("duration=shortest")) {
+                result = qMin(result, shortest);
+            } else if (!flags.contains("duration=first")) {
+                result = qMax(result, longest);
+            }
+        } else if (type == "ff-acrossfade") {
+            result += longest;
+        } else if (type == "ff-amerge") {
+            result = qMin(result, shortest);
+        }
+    }
+    return result;
+}
+
+QString FilterChain::buildAnalysisCommand(const QString& inputFile,
+                                          const QStringList& sidechainFiles,
+                                          const QList<int>& mutedPositions,
+                                          const LogSettings& logSettings) const {
+    // Measurement filters report at info level
+    QString command = logSettings.atLeastInfo().buildFlags() + " ";
+
+    // Audio only, single-threaded decode/filtering — parallelism comes from
+    // running many files at once
+    command += "-threads 1 -filter_threads 1 ";
+    command += QString("-vn -sn -dn -i \"%1\" ").arg(inputFile);
+
+    int audioInputCount = getRequiredAudioInputCount();
+    for (int i = 0; i < audioInputCount; ++i) {
+        if (i < sidechainFiles.size() && !sidechainFiles[i].isEmpty()) {
+            command += QString("-vn -sn -dn -i \"%1\" ").arg(sidechainFiles[i]);
+        } else {
+            command += "-f lavfi -i anullsrc=duration=1 ";
+        }
+    }
+
+    QString filterFlags = buildFilterFlags(mutedPositions);
+    if (!filterFlags.isEmpty()) {
+        command += "-filter_complex \"" + filterFlags + "\" -map \"[out]\" ";
+    } else {
+        command += "-map 0:a ";
+    }
+    command += "-f null -";
+
+    return command;
+}
+
+QString FilterChain::buildLoudnormMeasureCommand(const QString& inputFile,
+                                                 const QStringList& sidechainFiles,
+                                                 const QList<int>& mutedPositions,
+                                                 int* loudnormFilterId,
+                                                 QString* analysisSignature) const {
+    int loudnormPos = -1;
+    for (int i = 1; i < static_cast<int>(filters.size()) - 1; ++i) {
+        if (mutedPositions.contains(i)) continue;
+        auto* loudnorm = dynamic_cast<FFLoudnorm*>(filters[i].get());
+        if (loudnorm && loudnorm->isTwoPass()) {
+            loudnormPos = i;
+            break;
+        }
+    }
+    if (loudnormPos < 0) return "";
+
+    int filterId = filters[loudnormPos]->getFilterId();
+    QString filterFlags = LoudnormMeasurement::measureCommand(
+        buildFilterFlagsDAG(mutedPositions, 1, loudnormPos), filterId);
+    if (filterFlags.isEmpty()) return "";
+
+    if (loudnormFilterId) *loudnormFilterId = filterId;
+    if (analysisSignature) *analysisSignature = filterFlags;
+
+    // loudnorm prints its JSON at info level
+    LogSettings logSettings;
+    logSettings.logLevel = "info";
+
+    QString command = logSettings.buildFlags() + " ";
+    command += QString("-i \"%1\" ").arg(inputFile);
+    int audioInputCount = getRequiredAudioInputCount();
+    for (int i = 0; i < audioInputCount; ++i) {
+        if (i < sidechainFiles.size() && !sidechainFiles[i].isEmpty()) {
+            command += QString("-i \"%1\" ").arg(sidechainFiles[i]);
+        } else {
+            command += "-f lavfi -i anullsrc=duration=1 ";
+        }
+    }
+    command += "-filter_complex \"" + filterFlags + "\" -map \"[out]\" -f null -";
+
+    // Aux and image branches before loudnorm still need a consumer
+    for (int i = 1; i < loudnormPos; ++i) {
+        if (mutedPositions.contains(i)) continue;
+
+        QString filterIdLabel = getFilterHexLabel(filters[i]->getFilterId());
+        if (dynamic_cast<AuxOutputFilter*>(filters[i].get())) {
+            command += QString(" -map [%1-auxOut] -f null -").arg(filterIdLabel);
+        } else if (isImageOutputFilter(filters[i].get())) {
+            command += QString(" -map [%1-waveform] -f null -").arg(filterIdLabel);
+        }
+    }
+
+    return command;
+}
+
 QString FilterChain::formatCommandForDisplay(const QString& command, const QString& ffmpegPath) {
     // Just prepend ffmpeg path - let the Command View Window handle formatting
     return ffmpegPath + " " + command;
@@ -1679,247 +2125,68 @@ bool FilterChain::fromJSON(const QJsonObject& json) {
     return true;
 }
 
+QJsonObject FilterChain::toSnapshot() const {
+    QJsonObject snapshot;
+    snapshot["chain"] = toJSON();
+    
+    if (filters.size() >= 2) {
+        QJsonObject inputJson, outputJson;
+        filters.front()->toJSON(inputJson);
+        filters.back()->toJSON(outputJson);
+        snapshot["input"] = inputJson;
+        snapshot["output"] = outputJson;
+    }
+    
+    QJsonArray mutedIds;
+    for (const auto& filter : filters) {
+        if (!filter) continue;
+        if (filter->isEffectivelyMuted()) mutedIds.append(filter->getFilterId());
+        
+        if (auto* multiOutput = dynamic_cast<MultiOutputFilter*>(filter.get())) {
+            for (int s = 1; s < MultiOutputFilter::MAX_STREAMS; ++s) {
+                for (const auto& subFilter : multiOutput->getSubChain(s)) {
+                    if (subFilter && subFilter->isEffectivelyMuted()) mutedIds.append(subFilter->getFilterId());
+                }
+            }
+        }
+    }
+    snapshot["muted_ids"] = mutedIds;
+    return snapshot;
+}
+
+std::shared_ptr<FilterChain> FilterChain::fromSnapshot(const QJsonObject& snapshot) {
+    auto chain = std::make_shared<FilterChain>();
+    chain->fromJSON(snapshot["chain"].toObject());
+    
+    // fromJSON() keeps the chain's own INPUT/OUTPUT — restore their settings
+    if (snapshot.contains("input")) {
+        chain->filters.front()->fromJSON(snapshot["input"].toObject());
+        chain->filters.back()->fromJSON(snapshot["output"].toObject());
+    }
+    
+    QSet<int> mutedIds;
+    for (const auto& id : snapshot["muted_ids"].toArray()) mutedIds.insert(id.toInt());
+    
+    for (const auto& filter : chain->filters) {
+        if (!filter) continue;
+        filter->setEffectivelyMuted(mutedIds.contains(filter->getFilterId()));
+        
+        if (auto* multiOutput = dynamic_cast<MultiOutputFilter*>(filter.get())) {
+            for (int s = 1; s < MultiOutputFilter::MAX_STREAMS; ++s) {
+                for (const auto& subFilter : multiOutput->getSubChain(s)) {
+                    if (subFilter) subFilter->setEffectivelyMuted(mutedIds.contains(subFilter->getFilterId()));
+                }
+            }
+        }
+    }
+    
+    chain->updateAudioInputIndices();
+    chain->updateMultiInputFilterIndices();
+    return chain;
+}
+
 std::shared_ptr<BaseFilter> FilterChain::createFilterByType(const QString& type) {
-    if (type == "input") {
-        return std::make_shared<InputFilter>();
-    } else if (type == "output") {
-        return std::make_shared<OutputFilter>();
-    } else if (type == "audio-input") {
-        return std::make_shared<AudioInputFilter>();
-    } else if (type == "ff-volume") {
-        return std::make_shared<FFVolume>();
-    } else if (type == "ff-showwavespic") {
-        return std::make_shared<FFShowwavespic>();
-    } else if (type == "ff-showspectrumpic") {
-        return std::make_shared<FFShowspectrumpic>();
-    } else if (type == "ff-afir") {
-        return std::make_shared<FFAfir>();
-    } else if (type == "ff-amerge") {
-        return std::make_shared<FFAmerge>();
-    } else if (type == "ff-sidechaincompress") {
-        return std::make_shared<FFSidechaincompress>();
-    } else if (type == "ff-sidechaingate") {
-        return std::make_shared<FFSidechaingate>();
-    } else if (type == "ff-amix") {
-        return std::make_shared<FFAmix>();
-    } else if (type == "ff-acrossfade") {
-        return std::make_shared<FFAcrossfade>();
-    } else if (type == "asplit") {
-        return std::make_shared<AsplitFilter>();
-    } else if (type == "SmartAuxReturn") {
-        return std::make_shared<SmartAuxReturn>();
-    } else if (type == "aux-output") {
-        return std::make_shared<AuxOutputFilter>();
-    } else if (type == "custom") {
-        return std::make_shared<CustomFFmpegFilter>();
-    } else if (type == "ff-adelay") {
-        return std::make_shared<FFAdelay>();
-    } else if (type == "ff-aecho") {
-        return std::make_shared<FFAecho>();
-    } else if (type == "ff-atempo") {
-        return std::make_shared<FFAtempo>();
-    } else if (type == "ff-atrim") {
-        return std::make_shared<FFAtrim>();
-    } else if (type == "ff-afade") {
-        return std::make_shared<FFAfade>();
-    } else if (type == "ff-aloop") {
-        return std::make_shared<FFAloop>();
-    } else if (type == "ff-areverse") {
-        return std::make_shared<FFAreverse>();
-    } else if (type == "ff-apad") {
-        return std::make_shared<FFApad>();
-    } else if (type == "ff-asetpts") {
-        return std::make_shared<FFAsetpts>();
-    } else if (type == "ff-aformat") {
-        return std::make_shared<FFAformat>();
-    } else if (type == "ff-aresample") {
-        return std::make_shared<FFAresample>();
-    } else if (type == "ff-asetrate") {
-        return std::make_shared<FFAsetrate>();
-    } else if (type == "ff-dcshift") {
-        return std::make_shared<FFDcshift>();
-    } else if (type == "ff-anull") {
-        return std::make_shared<FFAnull>();
-    } else if (type == "ff-silenceremove") {
-        return std::make_shared<FFSilenceremove>();
-    } else if (type == "ff-acompressor") {
-        return std::make_shared<FFAcompressor>();
-    } else if (type == "ff-alimiter") {
-        return std::make_shared<FFAlimiter>();
-    } else if (type == "ff-agate") {
-        return std::make_shared<FFAgate>();
-    } else if (type == "ff-dynaudnorm") {
-        return std::make_shared<FFDynaudnorm>();
-    } else if (type == "ff-compand") {
-        return std::make_shared<FFCompand>();
-    } else if (type == "ff-mcompand") {
-        return std::make_shared<FFMcompand>();
-    } else if (type == "ff-apsyclip") {
-        return std::make_shared<FFApsyclip>();
-    } else if (type == "ff-asoftclip") {
-        return std::make_shared<FFAsoftclip>();
-    } else if (type == "ff-chorus") {
-        return std::make_shared<FFChorus>();
-    } else if (type == "ff-flanger") {
-        return std::make_shared<FFFlanger>();
-    } else if (type == "ff-aphaser") {
-        return std::make_shared<FFAphaser>();
-    } else if (type == "ff-tremolo") {
-        return std::make_shared<FFTremolo>();
-    } else if (type == "ff-vibrato") {
-        return std::make_shared<FFVibrato>();
-    } else if (type == "ff-afreqshift") {
-        return std::make_shared<FFAfreqshift>();
-    } else if (type == "ff-aphaseshift") {
-        return std::make_shared<FFAphaseshift>();
-    } else if (type == "ff-highpass") {
-        return std::make_shared<FFHighpass>();
-    } else if (type == "ff-lowpass") {
-        return std::make_shared<FFLowpass>();
-    } else if (type == "ff-bandpass") {
-        return std::make_shared<FFBandpass>();
-    } else if (type == "ff-bandreject") {
-        return std::make_shared<FFBandreject>();
-    } else if (type == "ff-equalizer") {
-        return std::make_shared<FFEqualizer>();
-    } else if (type == "ff-bass") {
-        return std::make_shared<FFBass>();
-    } else if (type == "ff-treble") {
-        return std::make_shared<FFTreble>();
-    } else if (type == "ff-highshelf") {
-        return std::make_shared<FFHighshelf>();
-    } else if (type == "ff-lowshelf") {
-        return std::make_shared<FFLowshelf>();
-    } else if (type == "ff-tiltshelf") {
-        return std::make_shared<FFTiltshelf>();
-    } else if (type == "ff-allpass") {
-        return std::make_shared<FFAllpass>();
-    } else if (type == "ff-crossfeed") {
-        return std::make_shared<FFCrossfeed>();
-    } else if (type == "ff-extrastereo") {
-        return std::make_shared<FFExtrastereo>();
-    } else if (type == "ff-stereowiden") {
-        return std::make_shared<FFStereowiden>();
-    } else if (type == "ff-earwax") {
-        return std::make_shared<FFEarwax>();
-    } else if (type == "ff-haas") {
-        return std::make_shared<FFHaas>();
-    } else if (type == "ff-stereotools") {
-        return std::make_shared<FFStereotools>();
-    } else if (type == "ff-aexciter") {
-        return std::make_shared<FFAexciter>();
-    } else if (type == "ff-crystalizer") {
-        return std::make_shared<FFCrystalizer>();
-    } else if (type == "ff-asubboost") {
-        return std::make_shared<FFAsubboost>();
-    } else if (type == "ff-virtualbass") {
-        return std::make_shared<FFVirtualbass>();
-    } else if (type == "ff-acrusher") {
-        return std::make_shared<FFAcrusher>();
-    } else if (type == "ff-apulsator") {
-        return std::make_shared<FFApulsator>();
-    } else if (type == "ff-afftdn") {
-        return std::make_shared<FFAfftdn>();
-    } else if (type == "ff-adeclick") {
-        return std::make_shared<FFAdeclick>();
-    } else if (type == "ff-adeclip") {
-        return std::make_shared<FFAdeclip>();
-    } else if (type == "ff-deesser") {
-        return std::make_shared<FFDeesser>();
-    } else if (type == "ff-adrc") {
-        return std::make_shared<FFAdrc>();
-    } else if (type == "ff-adynamicequalizer") {
-        return std::make_shared<FFAdynamicequalizer>();
-    } else if (type == "ff-bs2b") {
-        return std::make_shared<FFBs2b>();
-    } else if (type == "ff-loudnorm") {
-        return std::make_shared<FFLoudnorm>();
-    } else if (type == "ff-speechnorm") {
-        return std::make_shared<FFSpeechnorm>();
-    } else if (type == "ff-dialoguenhance") {
-        return std::make_shared<FFDialoguenhance>();
-    } else if (type == "ff-acontrast") {
-        return std::make_shared<FFAcontrast>();
-    } else if (type == "ff-adecorrelate") {
-        return std::make_shared<FFAdecorrelate>();
-    } else if (type == "ff-atilt") {
-        return std::make_shared<FFAtilt>();
-    } else if (type == "ff-asubcut") {
-        return std::make_shared<FFAsubcut>();
-    } else if (type == "ff-asupercut") {
-        return std::make_shared<FFAsupercut>();
-    } else if (type == "ff-asuperpass") {
-        return std::make_shared<FFAsuperpass>();
-    } else if (type == "ff-asuperstop") {
-        return std::make_shared<FFAsuperstop>();
-    } else if (type == "ff-biquad") {
-        return std::make_shared<FFBiquad>();
-    } else if (type == "ff-compensationdelay") {
-        return std::make_shared<FFCompensationdelay>();
-    } else if (type == "ff-astats") {
-        return std::make_shared<FFAstats>();
-    } else if (type == "ff-channelmap") {
-        return std::make_shared<FFChannelmap>();
-    } else if (type == "ff-channelsplit") {
-        return std::make_shared<FFChannelsplit>();
-    } else if (type == "ff-anequalizer") {
-        return std::make_shared<FFAnequalizer>();
-    } else if (type == "ff-acopy") {
-        return std::make_shared<FFAcopy>();
-    } else if (type == "ff-adenorm") {
-        return std::make_shared<FFAdenorm>();
-    } else if (type == "ff-volumedetect") {
-        return std::make_shared<FFVolumedetect>();
-    } else if (type == "ff-drmeter") {
-        return std::make_shared<FFDrmeter>();
-    } else if (type == "ff-silencedetect") {
-        return std::make_shared<FFSilencedetect>();
-    } else if (type == "ff-replaygain") {
-        return std::make_shared<FFReplaygain>();
-    } else if (type == "ff-aemphasis") {
-        return std::make_shared<FFAemphasis>();
-    } else if (type == "ff-hdcd") {
-        return std::make_shared<FFHdcd>();
-    } else if (type == "ff-aderivative") {
-        return std::make_shared<FFAderivative>();
-    } else if (type == "ff-aintegral") {
-        return std::make_shared<FFAintegral>();
-    } else if (type == "ff-adynamicsmooth") {
-        return std::make_shared<FFAdynamicsmooth>();
-    } else if (type == "ff-ashowinfo") {
-        return std::make_shared<FFAshowinfo>();
-    } else if (type == "ff-acue") {
-        return std::make_shared<FFAcue>();
-    } else if (type == "ff-pan") {
-        return std::make_shared<FFPan>();
-    } else if (type == "ff-join") {
-        return std::make_shared<FFJoin>();
-    } else if (type == "ff-surround") {
-        return std::make_shared<FFSurround>();
-    } else if (type == "ff-sofalizer") {
-        return std::make_shared<FFSofalizer>();
-    } else if (type == "ff-acrossover") {
-        return std::make_shared<FFAcrossover>();
-    } else if (type == "ff-superequalizer") {
-        return std::make_shared<FFSuperequalizer>();
-    } else if (type == "ff-firequalizer") {
-        return std::make_shared<FFFirequalizer>();
-    } else if (type == "ff-apsnr") {
-        return std::make_shared<FFApsnr>();
-    } else if (type == "ff-asdr") {
-        return std::make_shared<FFAsdr>();
-    } else if (type == "ff-asisdr") {
-        return std::make_shared<FFAsisdr>();
-    } else if (type == "ff-axcorrelate") {
-        return std::make_shared<FFAxcorrelate>();
-    } else if (type == "ff-rubberband") {
-        return std::make_shared<FFRubberband>();
-    } else if (type == "ff-anullsink") {
-        return std::make_shared<FFAnullsink>();
-    } else if (type == "channel-eq") {
-    return std::make_shared<ChannelEqFilter>(); // PROTOTYPE
-    } 
-    return nullptr;
+    return FilterRegistry::instance().create(type);
 }
 
 // ========== Audio Input Management ==========
@@ -30,6 +30,10 @@ struct LogSettings {
     // Build the flags portion of the command
     QString buildFlags() const;
 
+    // Same settings, log level raised to info if it is quieter — measurement
+    // filters print their results at info
+    LogSettings atLeastInfo() const;
+
     // Hardcoded safe defaults for preview — never changes
     static LogSettings preview();
 
@@ -133,6 +137,99 @@ public:
                                 const QList<int>& mutedPositions,
                                 const LogSettings& logSettings = LogSettings()) const;
 
+    // ========== Preview Stage Caching ==========
+
+    // Per-position signature of the main chain (type + flags + mute state).
+    // Diffing two signature lists finds the earliest changed stage.
+    QStringList buildStageSignatures(const QList<int>& mutedPositions) const;
+
+    // Main chain positions the preview can be split after, ascending.
+    // Only expensive filters (AFIR, Rubberband, AFFTDN) are cut points, and only
+    // where no sidechain context or custom output stream crosses the cut.
+    QList<int> findPreviewCutPoints(const QList<int>& mutedPositions) const;
+
+    // Build a preview command covering main chain positions [firstPos, lastPos].
+    // inputFile is either the source or a cached stage from a previous cut.
+    // Intermediate stages write 32-bit float WAV and skip the OUTPUT filter;
+    // the final stage applies OUTPUT flags exactly like buildPreviewCommand,
+    // unless outputFlagsOverride is given (e.g. raw PCM to a pipe for streaming).
+    QString buildPreviewStageCommand(const QString& inputFile,
+                                     const QStringList& sidechainFiles,
+                                     const QString& outputFile,
+                                     int firstPos,
+                                     int lastPos,
+                                     const QList<int>& mutedPositions,
+                                     bool finalStage,
+                                     const LogSettings& logSettings = LogSettings(),
+                                     const QString& outputFlagsOverride = QString()) const;
+
+    // ========== Multi-Pass Rendering ==========
+
+    // Render R chained passes of the chain from one decode in one process.
+    // Each pass is [volume=gainDb →] active filters; the end of every pass is
+    // split between its own output file and the next pass. outputFiles holds
+    // one path per pass. Returns empty if the chain has filters that can't be
+    // chained as plain segments (aux/image outputs, sidechains, sub-chains,
+    // custom outputs or labels), so callers fall back to cascade jobs that
+    // re-read each pass from disk.
+    QString buildIterateCommand(const QString& inputFile,
+                                const QStringList& outputFiles,
+                                const QList<int>& mutedPositions,
+                                double gainDb,
+                                const LogSettings& logSettings = LogSettings()) const;
+
+    // ========== Analysis-Only Mode ==========
+
+    // True if the batch only measures: no active aux/image output, and the
+    // main chain ends in a sink (FFAnullsink) or every active filter is a
+    // measurement filter (astats, volumedetect, silencedetect, drmeter,
+    // replaygain, ashowinfo).
+    bool isAnalysisOnly(const QList<int>& mutedPositions) const;
+
+    // True if an active filter reports results AnalysisResultParser reads
+    // (astats, volumedetect, silencedetect, drmeter, replaygain), in the
+    // main chain or a sub-chain. Render commands for such a chain run at
+    // log level info or above so the reports reach the parser.
+    bool hasAnalysisFilters(const QList<int>& mutedPositions = QList<int>()) const;
+
+    // Every aux and image output file a render command for inputFile →
+    // outputFile writes besides outputFile itself, in command order
+    QStringList branchOutputPaths(const QString& inputFile, const QString& outputFile,
+                                  const QList<int>& mutedPositions) const;
+
+    // Command for analysis mode: cheap decode (audio only, one thread per
+    // process), audio to -f null, log level raised to info so the
+    // measurement filters report.
+    QString buildAnalysisCommand(const QString& inputFile,
+                                 const QStringList& sidechainFiles,
+                                 const QList<int>& mutedPositions,
+                                 const LogSettings& logSettings = LogSettings()) const;
+
+    // ========== Duration Estimate ==========
+
+    // Expected output length for progress/ETA. Most filters keep the main
+    // input's length; mixing sidechains in can change it: amix with
+    // duration=longest runs to the longest input, acrossfade appends the
+    // sidechain, amerge stops at the shortest. sidechainSec entries of 0
+    // (unknown) are ignored.
+    double estimateOutputDuration(double mainSec,
+                                  const QList<double>& sidechainSec,
+                                  const QList<int>& mutedPositions) const;
+
+    // ========== Two-Pass Loudnorm ==========
+
+    // Analysis-only command for the first active two-pass FFLoudnorm in the
+    // main chain: the filters before it plus loudnorm with print_format=json,
+    // decoded to -f null (no encode). Returns empty if there is none.
+    // loudnormFilterId receives the filter's id (its named instance in the
+    // render command, see LoudnormMeasurement); analysisSignature identifies
+    // the analysed filters for measurement caching.
+    QString buildLoudnormMeasureCommand(const QString& inputFile,
+                                        const QStringList& sidechainFiles,
+                                        const QList<int>& mutedPositions,
+                                        int* loudnormFilterId,
+                                        QString* analysisSignature) const;
+
     // Static helpers for command formatting/parsing
     static QString formatCommandForDisplay(const QString& command, const QString& ffmpegPath);
     static QStringList parseCommandToArgs(const QString& command);
@@ -145,6 +242,12 @@ public:
     QJsonObject toJSON() const;
     bool fromJSON(const QJsonObject& json);
 
+    // Self-contained copy for building commands off the UI thread: toJSON()
+    // plus what it leaves out — INPUT/OUTPUT settings and the effective mutes
+    // stamped by FilterChainWidget::getMutedFilterPositions()
+    QJsonObject toSnapshot() const;
+    static std::shared_ptr<FilterChain> fromSnapshot(const QJsonObject& snapshot);
+
     // ========== Filter Factory ==========
 
     static std::shared_ptr<BaseFilter> createFilterByType(const QString& type);
@@ -178,11 +281,17 @@ private:
         int mainChainPosition = -1;
     };
 
+    // Folder for aux/image outputs without a custom folder: the OUTPUT
+    // filter's folder, or the shard subfolder of it outputFile is in
+    QString branchOutputFolder(const QString& inputFile, const QString& outputFile) const;
+
     // Build output file path for an aux output
-    QString buildAuxOutputPath(const QString& inputFile, class AuxOutputFilter* auxOut, int auxIndex) const;
+    QString buildAuxOutputPath(const QString& inputFile, const QString& outputFile,
+                               class AuxOutputFilter* auxOut, int auxIndex) const;
 
     // Build output file path for an image output filter (waveform, spectrum, etc.)
-    QString buildImageOutputPath(const QString& inputFile, BaseFilter* imageFilter) const;
+    QString buildImageOutputPath(const QString& inputFile, const QString& outputFile,
+                                 BaseFilter* imageFilter) const;
 
     // Check if the main chain ends with a sink filter (no audio output)
     bool endsWithSinkFilter(const QList<int>& mutedPositions = QList<int>()) const;
@@ -191,6 +300,9 @@ private:
     bool useDAGPath(const QList<int>& mutedPositions) const;
     QString buildFilterFlagsDAG(const QList<int>& mutedPositions) const;
 
+    // Same as above, restricted to main chain positions [firstPos, lastPos]
+    QString buildFilterFlagsDAG(const QList<int>& mutedPositions, int firstPos, int lastPos) const;
+
     std::vector<std::shared_ptr<BaseFilter>> filters;
 
     InputFilter* inputFilter = nullptr;
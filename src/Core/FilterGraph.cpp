@@ -1,11 +1,18 @@
 #include "FilterGraph.h"
+#include "FilterRegistry.h"
 
 namespace DAG {
 
 void FilterGraph::addNode(FilterNode node) {
+    node.kind = classify(node.filter.get());
+    m_index.insert(node.nodeId, static_cast<int>(m_nodes.size()));
     m_nodes.push_back(std::move(node));
 }
 
+FilterKind FilterGraph::classify(const BaseFilter* f) {
+    return FilterRegistry::kindOf(f);
+}
+
 void FilterGraph::addConnection(Connection conn) {
     m_connections.push_back(std::move(conn));
 }
@@ -42,10 +49,8 @@ std::vector<int> FilterGraph::topologicalOrder() const {
 }
 
 const FilterNode* FilterGraph::findNode(int nodeId) const {
-    for (const auto& node : m_nodes) {
-        if (node.nodeId == nodeId) return &node;
-    }
-    return nullptr;
+    int idx = m_index.value(nodeId, -1);
+    return idx >= 0 ? &m_nodes[idx] : nullptr;
 }
 
 QString FilterGraph::validate() const {
@@ -56,6 +61,7 @@ QString FilterGraph::validate() const {
 void FilterGraph::clear() {
     m_nodes.clear();
     m_connections.clear();
+    m_index.clear();
 }
 
 } // namespace DAG
@@ -2,6 +2,7 @@
 
 #include "FilterNode.h"
 #include "Connection.h"
+#include <QHash>
 #include <vector>
 #include <memory>
 
@@ -30,8 +31,16 @@ public:
     // For a linear chain this is trivially the insertion order.
     std::vector<int> topologicalOrder() const;
 
+    // O(1) lookup through the nodeId → index map
     const FilterNode* findNode(int nodeId) const;
 
+    // Position of a node in nodes(), or -1
+    int indexOf(int nodeId) const { return m_index.value(nodeId, -1); }
+
+    // Routing role of a filter (used for nodes and for asplit sub-chain filters),
+    // from FilterRegistry
+    static FilterKind classify(const BaseFilter* filter);
+
     // ========== Validation ==========
 
     // Returns empty string on success, error description on failure.
@@ -42,6 +51,7 @@ public:
 private:
     std::vector<FilterNode> m_nodes;
     std::vector<Connection> m_connections;
+    QHash<int, int>         m_index;   // nodeId → index into m_nodes
 };
 
 } // namespace DAG
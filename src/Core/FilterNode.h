@@ -7,11 +7,26 @@
 
 namespace DAG {
 
+// Routing role of a node, looked up in FilterRegistry once when the node is
+// added to a graph so command building doesn't repeat it per lookup.
+enum class FilterKind {
+    Normal,            // Plain 1→1 filter
+    AuxOutput,         // AuxOutputFilter — asplit tap to a file
+    ImageOutput,       // showwavespic / showspectrumpic — asplit tap to an image
+    Asplit,            // AsplitFilter with parallel sub-chains
+    AudioInput,        // Establishes sidechain context, emits nothing itself
+    NullSink,          // anullsink — chain terminal, omitted from filter_complex
+    SmartAuxReturn,    // amix of main + sidechains
+    MultiInput,        // afir, sidechaincompress, amix, join, ...
+    AnalysisTwoInput   // apsnr, asdr, asisdr
+};
+
 struct FilterNode {
     int                              nodeId;
     std::shared_ptr<BaseFilter>      filter;
     std::vector<PortDescriptor>      inputs;
     std::vector<PortDescriptor>      outputs;
+    FilterKind                       kind = FilterKind::Normal;
 
     static FilterNode fromFilter(std::shared_ptr<BaseFilter> f) {
         FilterNode node;
@@ -0,0 +1,298 @@
+#include "FilterRegistry.h"
+#include "InputFilter.h"
+#include "OutputFilter.h"
+#include "AudioInputFilter.h"
+#include "ff-volume.h"
+#include "ff-showwavespic.h"
+#include "ff-showspectrumpic.h"
+#include "ff-afir.h"
+#include "ff-amerge.h"
+#include "ff-sidechaincompress.h"
+#include "ff-sidechaingate.h"
+#include "ff-amix.h"
+#include "ff-acrossfade.h"
+#include "ff-asplit.h"
+#include "SmartAuxReturn.h"
+#include "AuxOutputFilter.h"
+#include "CustomFFmpegFilter.h"
+#include "ff-adelay.h"
+#include "ff-aecho.h"
+#include "ff-atempo.h"
+#include "ff-atrim.h"
+#include "ff-afade.h"
+#include "ff-aloop.h"
+#include "ff-areverse.h"
+#include "ff-apad.h"
+#include "ff-asetpts.h"
+#include "ff-aformat.h"
+#include "ff-aresample.h"
+#include "ff-asetrate.h"
+#include "ff-dcshift.h"
+#include "ff-anull.h"
+#include "ff-silenceremove.h"
+#include "ff-acompressor.h"
+#include "ff-alimiter.h"
+#include "ff-agate.h"
+#include "ff-dynaudnorm.h"
+#include "ff-compand.h"
+#include "ff-mcompand.h"
+#include "ff-apsyclip.h"
+#include "ff-asoftclip.h"
+#include "ff-chorus.h"
+#include "ff-flanger.h"
+#include "ff-aphaser.h"
+#include "ff-tremolo.h"
+#include "ff-vibrato.h"
+#include "ff-afreqshift.h"
+#include "ff-aphaseshift.h"
+#include "ff-highpass.h"
+#include "ff-lowpass.h"
+#include "ff-bandpass.h"
+#include "ff-bandreject.h"
+#include "ff-equalizer.h"
+#include "ff-bass.h"
+#include "ff-treble.h"
+#include "ff-highshelf.h"
+#include "ff-lowshelf.h"
+#include "ff-tiltshelf.h"
+#include "ff-allpass.h"
+#include "ff-crossfeed.h"
+#include "ff-extrastereo.h"
+#include "ff-stereowiden.h"
+#include "ff-earwax.h"
+#include "ff-haas.h"
+#include "ff-stereotools.h"
+#include "ff-aexciter.h"
+#include "ff-crystalizer.h"
+#include "ff-asubboost.h"
+#include "ff-virtualbass.h"
+#include "ff-acrusher.h"
+#include "ff-apulsator.h"
+#include "ff-afftdn.h"
+#include "ff-adeclick.h"
+#include "ff-adeclip.h"
+#include "ff-deesser.h"
+#include "ff-adrc.h"
+#include "ff-adynamicequalizer.h"
+#include "ff-bs2b.h"
+#include "ff-loudnorm.h"
+#include "ff-speechnorm.h"
+#include "ff-dialoguenhance.h"
+#include "ff-acontrast.h"
+#include "ff-adecorrelate.h"
+#include "ff-atilt.h"
+#include "ff-asubcut.h"
+#include "ff-asupercut.h"
+#include "ff-asuperpass.h"
+#include "ff-asuperstop.h"
+#include "ff-biquad.h"
+#include "ff-compensationdelay.h"
+#include "ff-astats.h"
+#include "ff-channelmap.h"
+#include "ff-channelsplit.h"
+#include "ff-anequalizer.h"
+#include "ff-acopy.h"
+#include "ff-adenorm.h"
+#include "ff-volumedetect.h"
+#include "ff-drmeter.h"
+#include "ff-silencedetect.h"
+#include "ff-replaygain.h"
+#include "ff-aemphasis.h"
+#include "ff-hdcd.h"
+#include "ff-aderivative.h"
+#include "ff-aintegral.h"
+#include "ff-adynamicsmooth.h"
+#include "ff-ashowinfo.h"
+#include "ff-acue.h"
+#include "ff-pan.h"
+#include "ff-join.h"
+#include "ff-surround.h"
+#include "ff-sofalizer.h"
+#include "ff-acrossover.h"
+#include "ff-superequalizer.h"
+#include "ff-firequalizer.h"
+#include "ff-apsnr.h"
+#include "ff-asdr.h"
+#include "ff-asisdr.h"
+#include "ff-axcorrelate.h"
+#include "ff-rubberband.h"
+#include "ff-anullsink.h"
+#include "ChannelEqFilter.h"
+#include <QDebug>
+
+using DAG::FilterKind;
+
+template <typename T>
+void FilterRegistry::add(const char* type, const char* category, const char* name, FilterKind kind) {
+    FilterTypeInfo info;
+    info.type = QString::fromLatin1(type);
+    info.category = QString::fromLatin1(category);
+    info.name = QString::fromUtf8(name);
+    info.kind = kind;
+    info.create = []() -> std::shared_ptr<BaseFilter> { return std::make_shared<T>(); };
+    m_index.insert(info.type, m_types.size());
+    m_types.append(info);
+}
+
+// One table for every filter type, in "+ Add Filter" menu order: categories
+// appear in the order of their first entry. Built on first use (not by
+// per-filter static registrars: ffab_engine is a static library, and the
+// linker drops object files whose only reference is their own registrar).
+FilterRegistry::FilterRegistry() {
+    add<InputFilter>("input", "", "Input");
+    add<OutputFilter>("output", "", "Output");
+    add<CustomFFmpegFilter>("custom", "", "Custom FFmpeg...");
+
+    add<AudioInputFilter>("audio-input", "Routing && I/O", "SideChain / Audio Input", FilterKind::AudioInput);
+    add<AuxOutputFilter>("aux-output", "Routing && I/O", "Aux Output", FilterKind::AuxOutput);
+    add<AsplitFilter>("asplit", "Routing && I/O", "Audio Split", FilterKind::Asplit);
+    add<SmartAuxReturn>("SmartAuxReturn", "Routing && I/O", "Smart Aux Return", FilterKind::SmartAuxReturn);
+    add<FFAcrossover>("ff-acrossover", "Routing && I/O", "Crossover Multi-output");
+
+    add<FFAfir>("ff-afir", "Multi-Input", "Convolution IR (afir)", FilterKind::MultiInput);
+    add<FFAmerge>("ff-amerge", "Multi-Input", "Channel Merge (amerge)", FilterKind::MultiInput);
+    add<FFAmix>("ff-amix", "Multi-Input", "Audio Mix (amix)", FilterKind::MultiInput);
+    add<FFSidechaincompress>("ff-sidechaincompress", "Multi-Input", "Sidechain Compressor", FilterKind::MultiInput);
+    add<FFSidechaingate>("ff-sidechaingate", "Multi-Input", "Sidechain Gate", FilterKind::MultiInput);
+    add<FFAcrossfade>("ff-acrossfade", "Multi-Input", "Crossfade (acrossfade)", FilterKind::MultiInput);
+    add<FFJoin>("ff-join", "Multi-Input", "Join Channels", FilterKind::MultiInput);
+
+    add<FFAgate>("ff-agate", "Dynamics", "Gate");
+    add<FFAlimiter>("ff-alimiter", "Dynamics", "Limiter");
+    add<FFAcompressor>("ff-acompressor", "Dynamics", "Compressor");
+    add<FFCompand>("ff-compand", "Dynamics", "Compander");
+    add<FFMcompand>("ff-mcompand", "Dynamics", "Multiband Compander");
+    add<FFDynaudnorm>("ff-dynaudnorm", "Dynamics", "Dynamic Normalizer");
+    add<FFAdynamicequalizer>("ff-adynamicequalizer", "Dynamics", "Dynamic EQ");
+    add<FFAdynamicsmooth>("ff-adynamicsmooth", "Dynamics", "Dynamic Smooth");
+    add<FFAexciter>("ff-aexciter", "Dynamics", "Exciter");
+    add<FFDeesser>("ff-deesser", "Dynamics", "De-esser");
+    add<FFAdrc>("ff-adrc", "Dynamics", "DRC (Spectral)");
+    add<FFLoudnorm>("ff-loudnorm", "Dynamics", "Loudness Norm");
+    add<FFSpeechnorm>("ff-speechnorm", "Dynamics", "Speech Norm");
+    add<FFDialoguenhance>("ff-dialoguenhance", "Dynamics", "Dialogue Enhance");
+    add<FFAcontrast>("ff-acontrast", "Dynamics", "Contrast");
+
+    add<ChannelEqFilter>("channel-eq", "EQ && Filters", "Channel EQ");  // PROTOTYPE
+    add<FFAllpass>("ff-allpass", "EQ && Filters", "All Pass");
+    add<FFHighpass>("ff-highpass", "EQ && Filters", "High Pass");
+    add<FFLowpass>("ff-lowpass", "EQ && Filters", "Low Pass");
+    add<FFBandpass>("ff-bandpass", "EQ && Filters", "Band Pass");
+    add<FFBandreject>("ff-bandreject", "EQ && Filters", "Band Reject (Notch)");
+    add<FFEqualizer>("ff-equalizer", "EQ && Filters", "Parametric EQ");
+    add<FFAnequalizer>("ff-anequalizer", "EQ && Filters", "Parametric Multi EQ");
+    add<FFHighshelf>("ff-highshelf", "EQ && Filters", "High Shelf");
+    add<FFLowshelf>("ff-lowshelf", "EQ && Filters", "Low Shelf");
+    add<FFTiltshelf>("ff-tiltshelf", "EQ && Filters", "Tilt Shelf");
+    add<FFAtilt>("ff-atilt", "EQ && Filters", "Tilt EQ");
+    add<FFTreble>("ff-treble", "EQ && Filters", "Treble");
+    add<FFBass>("ff-bass", "EQ && Filters", "Bass");
+    add<FFAsubboost>("ff-asubboost", "EQ && Filters", "Sub Boost");
+    add<FFVirtualbass>("ff-virtualbass", "EQ && Filters", "Virtual Bass");
+    add<FFAsubcut>("ff-asubcut", "EQ && Filters", "Sub Cut");
+    add<FFAsupercut>("ff-asupercut", "EQ && Filters", "Super Cut");
+    add<FFAsuperpass>("ff-asuperpass", "EQ && Filters", "Super Bandpass");
+    add<FFAsuperstop>("ff-asuperstop", "EQ && Filters", "Super Notch");
+    add<FFBiquad>("ff-biquad", "EQ && Filters", "Biquad");
+    add<FFAemphasis>("ff-aemphasis", "EQ && Filters", "Emphasis");
+    add<FFSuperequalizer>("ff-superequalizer", "EQ && Filters", "18-Band EQ");
+    add<FFFirequalizer>("ff-firequalizer", "EQ && Filters", "FIR Equalizer");
+
+    add<FFAsoftclip>("ff-asoftclip", "Harmonics", "Soft Clipper");
+    add<FFAcrusher>("ff-acrusher", "Harmonics", "Bit Crusher");
+    add<FFApsyclip>("ff-apsyclip", "Harmonics", "Psychoacoustic Clipper");
+    add<FFCrystalizer>("ff-crystalizer", "Harmonics", "Crystalizer");
+
+    add<FFChorus>("ff-chorus", "Modulation", "Chorus");
+    add<FFFlanger>("ff-flanger", "Modulation", "Flanger");
+    add<FFAphaser>("ff-aphaser", "Modulation", "Phaser");
+    add<FFAphaseshift>("ff-aphaseshift", "Modulation", "Phase Shifter");
+    add<FFTremolo>("ff-tremolo", "Modulation", "Tremolo");
+    add<FFVibrato>("ff-vibrato", "Modulation", "Vibrato");
+    add<FFAfreqshift>("ff-afreqshift", "Modulation", "Frequency Shifter");
+    add<FFApulsator>("ff-apulsator", "Modulation", "Pulsator");
+
+    add<FFAloop>("ff-aloop", "Time && Pitch", "Loop");
+    add<FFAtrim>("ff-atrim", "Time && Pitch", "Trim");
+    add<FFAreverse>("ff-areverse", "Time && Pitch", "Reverse");
+    add<FFApad>("ff-apad", "Time && Pitch", "Pad");
+    add<FFAfade>("ff-afade", "Time && Pitch", "Fade");
+    add<FFCompensationdelay>("ff-compensationdelay", "Time && Pitch", "Compensation Delay");
+    add<FFAsetpts>("ff-asetpts", "Time && Pitch", "Set PTS");
+    add<FFRubberband>("ff-rubberband", "Time && Pitch", "Rubberband");
+    add<FFAdelay>("ff-adelay", "Time && Pitch", "Delay");
+    add<FFAecho>("ff-aecho", "Time && Pitch", "Echo");
+    add<FFAtempo>("ff-atempo", "Time && Pitch", "Tempo");
+
+    add<FFStereotools>("ff-stereotools", "Stereo && Spatial", "Stereo Tools");
+    add<FFStereowiden>("ff-stereowiden", "Stereo && Spatial", "Stereo Widen");
+    add<FFExtrastereo>("ff-extrastereo", "Stereo && Spatial", "Extra Stereo");
+    add<FFAdecorrelate>("ff-adecorrelate", "Stereo && Spatial", "Decorrelate");
+    add<FFCrossfeed>("ff-crossfeed", "Stereo && Spatial", "Crossfeed");
+    add<FFBs2b>("ff-bs2b", "Stereo && Spatial", "BS2B Crossfeed");
+    add<FFPan>("ff-pan", "Stereo && Spatial", "Pan / Remix");
+    add<FFHaas>("ff-haas", "Stereo && Spatial", "Haas Effect");
+    add<FFSofalizer>("ff-sofalizer", "Stereo && Spatial", "SOFA Spatializer");
+    add<FFEarwax>("ff-earwax", "Stereo && Spatial", "Earwax");
+    add<FFSurround>("ff-surround", "Stereo && Spatial", "Surround Upmix");
+    add<FFChannelmap>("ff-channelmap", "Stereo && Spatial", "Channel Map");
+    add<FFChannelsplit>("ff-channelsplit", "Stereo && Spatial", "Channel Split");
+
+    add<FFAfftdn>("ff-afftdn", "Restoration", "FFT Denoise");
+    add<FFAdeclick>("ff-adeclick", "Restoration", "Declick");
+    add<FFAdeclip>("ff-adeclip", "Restoration", "Declip");
+
+    add<FFVolume>("ff-volume", "Utility", "Volume");
+    add<FFAformat>("ff-aformat", "Utility", "Format");
+    add<FFAresample>("ff-aresample", "Utility", "Resample");
+    add<FFAsetrate>("ff-asetrate", "Utility", "Set Rate");
+    add<FFDcshift>("ff-dcshift", "Utility", "DC Shift");
+    add<FFSilenceremove>("ff-silenceremove", "Utility", "Silence Remove");
+    add<FFAdenorm>("ff-adenorm", "Utility", "Anti-Denorm");
+    add<FFHdcd>("ff-hdcd", "Utility", "HDCD Decoder");
+    add<FFAderivative>("ff-aderivative", "Utility", "Derivative");
+    add<FFAintegral>("ff-aintegral", "Utility", "Integral");
+    add<FFAcue>("ff-acue", "Utility", "Audio Cue");
+    add<FFAcopy>("ff-acopy", "Utility", "Audio Copy");
+    add<FFAnull>("ff-anull", "Utility", "Null");
+    add<FFAnullsink>("ff-anullsink", "Utility", "Null Sink", FilterKind::NullSink);
+
+    add<FFShowwavespic>("ff-showwavespic", "Analysis", "Waveform Image", FilterKind::ImageOutput);
+    add<FFShowspectrumpic>("ff-showspectrumpic", "Analysis", "Spectrum Image", FilterKind::ImageOutput);
+    add<FFSilencedetect>("ff-silencedetect", "Analysis", "Silence Detect");
+    add<FFVolumedetect>("ff-volumedetect", "Analysis", "Volume Detect");
+    add<FFAstats>("ff-astats", "Analysis", "Audio Stats");
+    add<FFAshowinfo>("ff-ashowinfo", "Analysis", "Show Info");
+    add<FFDrmeter>("ff-drmeter", "Analysis", "DR Meter");
+    add<FFReplaygain>("ff-replaygain", "Analysis", "ReplayGain");
+    add<FFApsnr>("ff-apsnr", "Analysis", "PSNR Measure", FilterKind::AnalysisTwoInput);
+    add<FFAsdr>("ff-asdr", "Analysis", "SDR Measure", FilterKind::AnalysisTwoInput);
+    add<FFAsisdr>("ff-asisdr", "Analysis", "SI-SDR Measure", FilterKind::AnalysisTwoInput);
+    add<FFAxcorrelate>("ff-axcorrelate", "Analysis", "Cross-Correlate", FilterKind::MultiInput);
+
+    // Analyzers whose stderr report AnalysisResults collects
+    for (const char* type : { "ff-astats", "ff-volumedetect", "ff-silencedetect", "ff-drmeter", "ff-replaygain" }) {
+        m_types[m_index.value(QString::fromLatin1(type))].reportsAnalysis = true;
+    }
+}
+
+const FilterRegistry& FilterRegistry::instance() {
+    static const FilterRegistry registry;
+    return registry;
+}
+
+const FilterTypeInfo* FilterRegistry::find(const QString& type) const {
+    auto it = m_index.constFind(type);
+    return it != m_index.constEnd() ? &m_types[it.value()] : nullptr;
+}
+
+std::shared_ptr<BaseFilter> FilterRegistry::create(const QString& type) const {
+    const FilterTypeInfo* info = find(type);
+    if (!info) {
+        qWarning() << "FilterRegistry: Unknown filter type" << type;
+        return nullptr;
+    }
+    std::shared_ptr<BaseFilter> filter = info->create();
+    filter->setTypeInfo(info);
+    return filter;
+}
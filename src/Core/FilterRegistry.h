@@ -0,0 +1,67 @@
+#pragma once
+
+#include "FilterNode.h"
+#include <QString>
+#include <QHash>
+#include <QList>
+#include <memory>
+
+class BaseFilter;
+
+/**
+ * FilterTypeInfo - Static description of one filter type
+ */
+struct FilterTypeInfo {
+    QString type;                                      // filterType(), preset JSON "type"
+    QString category;                                  // FilterMenuBuilder submenu ("" = not in the menu)
+    QString name;                                      // menu display name
+    DAG::FilterKind kind = DAG::FilterKind::Normal;    // routing role for command building
+    bool reportsAnalysis = false;                      // prints a measurement report (astats, drmeter, ...)
+    std::shared_ptr<BaseFilter> (*create)() = nullptr;
+};
+
+/**
+ * FilterRegistry - Every filter type, hashed by type string
+ *
+ * Replaces the string-compare ladder that used to create filters in
+ * FilterChain::fromJSON and the dynamic_cast cascades that classified them
+ * for command building: both are now one hash lookup. FilterMenuBuilder
+ * builds the "+ Add Filter" menu from types(), so a new filter is added
+ * here only.
+ *
+ * Ports are not part of the type — multi-input filters size them from
+ * their parameters, so FilterNode still asks the instance.
+ */
+class FilterRegistry {
+public:
+    static const FilterRegistry& instance();
+
+    const FilterTypeInfo* find(const QString& type) const;
+    bool contains(const QString& type) const { return m_index.contains(type); }
+
+    // Every type in menu order
+    const QList<FilterTypeInfo>& types() const { return m_types; }
+
+    // nullptr (with a warning) for unknown types. The filter keeps a
+    // pointer to its entry, so later lookups don't hash the type again.
+    std::shared_ptr<BaseFilter> create(const QString& type) const;
+
+    // Metadata of a filter instance — Normal / false for filters not
+    // created through the registry
+    static DAG::FilterKind kindOf(const BaseFilter* filter) {
+        return filter && filter->typeInfo() ? filter->typeInfo()->kind : DAG::FilterKind::Normal;
+    }
+    static bool reportsAnalysis(const BaseFilter* filter) {
+        return filter && filter->typeInfo() && filter->typeInfo()->reportsAnalysis;
+    }
+
+private:
+    FilterRegistry();
+
+    template <typename T>
+    void add(const char* type, const char* category, const char* name,
+             DAG::FilterKind kind = DAG::FilterKind::Normal);
+
+    QList<FilterTypeInfo> m_types;
+    QHash<QString, qsizetype> m_index;   // type → position in m_types
+};
@@ -1,11 +1,15 @@
 #include "JobListBuilder.h"
 #include "Core/FilterChain.h"
 #include "Filters/OutputFilter.h"
+#include "Core/LoudnormMeasurement.h"
 #include <QFileInfo>
 #include <QDir>
 #include <QDebug>
 #include <QRandomGenerator>
+#include <QUuid>
+#include <QLocale>
 #include <QRegularExpression>
+#include <QCryptographicHash>
 #include <algorithm>
 #include <cmath>
 
@@ -95,14 +99,50 @@ QString JobListBuilder::buildOutputPath(const QString& combinedBaseName,
     return QDir(outputFolder).filePath(outputFileName);
 }
 
+QString JobListBuilder::shardFolder(const QString& outputFolder,
+                                    const OutputLayout& layout,
+                                    const QString& mainName,
+                                    const QString& auxName,
+                                    const QString& combinedBaseName,
+                                    int ordinal) {
+    QString subfolder;
+    switch (layout.sharding) {
+        case OutputLayout::Sharding::None:
+            return outputFolder;
+        case OutputLayout::Sharding::MainName:
+            subfolder = mainName;
+            break;
+        case OutputLayout::Sharding::AuxName:
+            subfolder = auxName.isEmpty() ? mainName : auxName;
+            break;
+        case OutputLayout::Sharding::HashPrefix:
+            // MD5, not qHash — the folder of a name must not change between runs
+            subfolder = QString::fromLatin1(
+                QCryptographicHash::hash(combinedBaseName.toUtf8(), QCryptographicHash::Md5)
+                    .toHex().left(2));
+            break;
+        case OutputLayout::Sharding::Count:
+            subfolder = QString("%1").arg(ordinal / qMax(1, layout.filesPerFolder), 4, 10, QChar('0'));
+            break;
+    }
+    return subfolder.isEmpty() ? outputFolder : QDir(outputFolder).filePath(subfolder);
+}
+
 QString JobListBuilder::buildCommand(const QString& mainInputPath,
                                      const QStringList& sidechainFiles,
                                      const QString& outputPath,
                                      std::shared_ptr<FilterChain> filterChain,
-                                     const QList<int>& mutedPositions) {
+                                     const QList<int>& mutedPositions,
+                                     bool* analysisOnly) {
+    if (analysisOnly) *analysisOnly = false;
     if (!filterChain) return QString();
 
     auto logSettings = LogSettings::fromQSettings();
+    if (filterChain->isAnalysisOnly(mutedPositions)) {
+        if (analysisOnly) *analysisOnly = true;
+        return filterChain->buildAnalysisCommand(
+            mainInputPath, sidechainFiles, mutedPositions, logSettings);
+    }
     if (!sidechainFiles.isEmpty()) {
         return filterChain->buildCompleteCommand(
             mainInputPath, sidechainFiles, outputPath, mutedPositions, logSettings);
@@ -117,10 +157,11 @@ QString JobListBuilder::buildCommandWithGain(const QString& mainInputPath,
                                               const QString& outputPath,
                                               std::shared_ptr<FilterChain> filterChain,
                                               const QList<int>& mutedPositions,
-                                              double gainDb) {
+                                              double gainDb,
+                                              bool* analysisOnly) {
     // Build the normal command first
     QString cmd = buildCommand(mainInputPath, sidechainFiles, outputPath,
-                               filterChain, mutedPositions);
+                               filterChain, mutedPositions, analysisOnly);
     
     if (cmd.isEmpty() || qFuzzyCompare(gainDb, 0.0)) {
         return cmd;  // No gain adjustment needed
@@ -182,6 +223,26 @@ QString JobListBuilder::buildCommandWithGain(const QString& mainInputPath,
     return cmd;
 }
 
+double JobListBuilder::outputDuration(std::shared_ptr<FilterChain> filterChain,
+                                      const QList<int>& mutedPositions,
+                                      const FileListWidget::AudioFileInfo& mainFile,
+                                      const FileListWidget::AudioFileInfo* aux1File,
+                                      const FileListWidget::AudioFileInfo* aux2File) {
+    auto seconds = [](const QString& duration) {
+        QStringList parts = duration.split(':');
+        if (parts.size() != 3) return 0.0;
+        return parts[0].toInt() * 3600 + parts[1].toInt() * 60 + parts[2].toDouble();
+    };
+    
+    double mainSec = seconds(mainFile.duration);
+    if (!filterChain || mainSec <= 0.0) return mainSec;
+    
+    QList<double> sidechainSec;
+    if (aux1File) sidechainSec << seconds(aux1File->duration);
+    if (aux2File) sidechainSec << seconds(aux2File->duration);
+    return filterChain->estimateOutputDuration(mainSec, sidechainSec, mutedPositions);
+}
+
 QStringList JobListBuilder::buildSidechainList(const QStringList& otherSidechainFiles,
                                                const QString& aux1File,
                                                int aux1InputIndex,
@@ -221,7 +282,8 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildSequential(
     const QString& outputFolder,
     std::shared_ptr<FilterChain> filterChain,
     const QList<int>& mutedPositions,
-    const QStringList& sidechainFiles) {
+    const QStringList& sidechainFiles,
+    const OutputLayout& layout) {
     
     QList<BatchProcessor::JobInfo> jobs;
     jobs.reserve(mainFiles.size());
@@ -232,10 +294,12 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildSequential(
         
         QString combined = baseName(file.fileName);
         job.combinedBaseName = combined;
-        job.outputPath = buildOutputPath(combined, outputFolder, filterChain);
+        job.outputPath = buildOutputPath(
+            combined, shardFolder(outputFolder, layout, combined, QString(), combined, jobs.size()),
+            filterChain);
         job.sidechainFiles = sidechainFiles;
         job.command = buildCommand(file.filePath, sidechainFiles, job.outputPath,
-                                   filterChain, mutedPositions);
+                                   filterChain, mutedPositions, &job.analysisOnly);
         
         jobs.append(job);
     }
@@ -260,9 +324,10 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildSequential(
 // All intermediate results are kept so the user can audition the progression
 // and pick the iteration they like best.
 //
-// Jobs for each file are marked isCascade = true so that if one iteration fails,
-// the remaining iterations for that file are skipped (the output chain is broken).
-// However, the next file's iterations start fresh.
+// Each pass depends on the previous pass of the same file (dependsOn), so if
+// one iteration fails, the remaining iterations for that file are skipped (the
+// output chain is broken). Other files' chains are independent and keep running
+// on the other workers.
 
 QList<BatchProcessor::JobInfo> JobListBuilder::buildIterate(
     const QList<FileListWidget::AudioFileInfo>& mainFiles,
@@ -271,7 +336,8 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildIterate(
     const QString& outputFolder,
     std::shared_ptr<FilterChain> filterChain,
     const QList<int>& mutedPositions,
-    const QStringList& sidechainFiles) {
+    const QStringList& sidechainFiles,
+    const OutputLayout& layout) {
     
     QList<BatchProcessor::JobInfo> jobs;
     
@@ -281,29 +347,83 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildIterate(
     repeatCount = qBound(ITERATE_MIN_REPEATS, repeatCount, ITERATE_MAX_REPEATS);
     gainReductionDb = qBound(ITERATE_MIN_GAIN_DB, gainReductionDb, ITERATE_MAX_GAIN_DB);
     
-    int totalJobs = mainFiles.size() * repeatCount;
-    jobs.reserve(totalJobs);
-    
     // Width of iteration number for formatting (e.g. "01" for ≤99, "001" for ≥100)
     int numWidth = (repeatCount >= 100) ? 3 : 2;
     
+    auto iterLabel = [numWidth](int r) {
+        return QString("i%1").arg(r + 1, numWidth, 10, QChar('0'));
+    };
+    
+    // ---------- In-process mode: all passes of a file in one ffmpeg ----------
+    bool lossyOutput = false;
+    if (filterChain) {
+        auto lastFilter = filterChain->getFilter(filterChain->filterCount() - 1);
+        if (auto* output = dynamic_cast<OutputFilter*>(lastFilter.get())) {
+            lossyOutput = (output->getCategory() == OutputFilter::Category::Compressed);
+        }
+    }
+    
+    if (filterChain && !lossyOutput) {
+        auto logSettings = LogSettings::fromQSettings();
+        
+        for (const auto& mainFile : mainFiles) {
+            QString fileBase = baseName(mainFile.fileName);
+            QStringList passOutputs;
+            for (int r = 0; r < repeatCount; ++r) {
+                QString combined = fileBase + "_" + iterLabel(r);
+                QString folder = shardFolder(outputFolder, layout, fileBase, QString(), combined,
+                                             jobs.size() * repeatCount + r);
+                passOutputs.append(buildOutputPath(combined, folder, filterChain));
+            }
+            
+            QString command = filterChain->buildIterateCommand(
+                mainFile.filePath, passOutputs, mutedPositions, gainReductionDb, logSettings);
+            if (command.isEmpty()) {
+                // Chain-level limitation — same for every file
+                jobs.clear();
+                break;
+            }
+            
+            BatchProcessor::JobInfo job;
+            job.inputFile = mainFile;
+            job.combinedBaseName = fileBase + "_" + iterLabel(repeatCount - 1);
+            job.outputPath = passOutputs.last();
+            job.extraOutputPaths = passOutputs.mid(0, repeatCount - 1);
+            job.sidechainFiles = sidechainFiles;
+            job.command = command;
+            jobs.append(job);
+        }
+        
+        if (!jobs.isEmpty()) {
+            qDebug() << "Iterate: built" << jobs.size() << "in-process jobs"
+                     << "(" << mainFiles.size() << "files ×" << repeatCount << "passes,"
+                     << gainReductionDb << "dB/pass)";
+            return jobs;
+        }
+    }
+    
+    // ---------- Cascade mode: one job per pass, each re-reads the last ----------
+    int totalJobs = mainFiles.size() * repeatCount;
+    jobs.reserve(totalJobs);
+    
     for (const auto& mainFile : mainFiles) {
         QString fileBase = baseName(mainFile.fileName);
         QString previousOutputPath;
         
         for (int r = 0; r < repeatCount; ++r) {
             BatchProcessor::JobInfo job;
-            job.isCascade = true;  // Abort remaining iterations on failure
+            if (r > 0) job.dependsOn = jobs.size() - 1;  // Previous pass of this file
             
             // Iteration label: i01, i02, ...
-            QString iterLabel = QString("i%1").arg(r + 1, numWidth, 10, QChar('0'));
-            QString combined = fileBase + "_" + iterLabel;
+            QString combined = fileBase + "_" + iterLabel(r);
             
             job.combinedBaseName = combined;
-            job.outputPath = buildOutputPath(combined, outputFolder, filterChain);
+            job.outputPath = buildOutputPath(
+                combined, shardFolder(outputFolder, layout, fileBase, QString(), combined, jobs.size()),
+                filterChain);
             job.sidechainFiles = sidechainFiles;
             
-            // Determine the input for this pass
+            // Determine the input for this pass (the previous pass's sharded path)
             QString inputPath;
             if (r == 0) {
                 // First pass: use the original file
@@ -327,12 +447,12 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildIterate(
             if (qFuzzyCompare(gainReductionDb, 0.0)) {
                 // No gain reduction — pure chaos mode
                 job.command = buildCommand(inputPath, sidechainFiles, job.outputPath,
-                                           filterChain, mutedPositions);
+                                           filterChain, mutedPositions, &job.analysisOnly);
             } else {
                 // Inject volume filter for gain staging
                 job.command = buildCommandWithGain(inputPath, sidechainFiles, job.outputPath,
                                                     filterChain, mutedPositions,
-                                                    gainReductionDb);
+                                                    gainReductionDb, &job.analysisOnly);
             }
             
             previousOutputPath = job.outputPath;
@@ -357,7 +477,8 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildZip(
     std::shared_ptr<FilterChain> filterChain,
     const QList<int>& mutedPositions,
     const QStringList& otherSidechainFiles,
-    ZipMismatch mismatchMode) {
+    ZipMismatch mismatchMode,
+    const OutputLayout& layout) {
     
     QList<BatchProcessor::JobInfo> jobs;
     
@@ -402,10 +523,14 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildZip(
         
         QString combined = baseName(mainFile.fileName) + "_" + baseName(auxFile.fileName);
         job.combinedBaseName = combined;
-        job.outputPath = buildOutputPath(combined, outputFolder, filterChain);
+        job.outputPath = buildOutputPath(
+            combined, shardFolder(outputFolder, layout, baseName(mainFile.fileName), baseName(auxFile.fileName),
+                                  combined, jobs.size()),
+            filterChain);
         job.sidechainFiles = buildSidechainList(otherSidechainFiles, auxFile.filePath, aux1InputIndex);
+        job.durationSec = outputDuration(filterChain, mutedPositions, mainFile, &auxFile);
         job.command = buildCommand(mainFile.filePath, job.sidechainFiles, job.outputPath,
-                                   filterChain, mutedPositions);
+                                   filterChain, mutedPositions, &job.analysisOnly);
         
         jobs.append(job);
     }
@@ -422,7 +547,8 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildBroadcastFixed(
     const QString& outputFolder,
     std::shared_ptr<FilterChain> filterChain,
     const QList<int>& mutedPositions,
-    const QStringList& otherSidechainFiles) {
+    const QStringList& otherSidechainFiles,
+    const OutputLayout& layout) {
     
     QList<BatchProcessor::JobInfo> jobs;
     jobs.reserve(mainFiles.size());
@@ -435,10 +561,13 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildBroadcastFixed(
         
         QString combined = baseName(mainFile.fileName) + "_" + auxBase;
         job.combinedBaseName = combined;
-        job.outputPath = buildOutputPath(combined, outputFolder, filterChain);
+        job.outputPath = buildOutputPath(
+            combined, shardFolder(outputFolder, layout, baseName(mainFile.fileName), auxBase,
+                                  combined, jobs.size()),
+            filterChain);
         job.sidechainFiles = buildSidechainList(otherSidechainFiles, fixedAuxFile, aux1InputIndex);
         job.command = buildCommand(mainFile.filePath, job.sidechainFiles, job.outputPath,
-                                   filterChain, mutedPositions);
+                                   filterChain, mutedPositions, &job.analysisOnly);
         
         jobs.append(job);
     }
@@ -455,7 +584,8 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildBroadcastRandom(
     const QString& outputFolder,
     std::shared_ptr<FilterChain> filterChain,
     const QList<int>& mutedPositions,
-    const QStringList& otherSidechainFiles) {
+    const QStringList& otherSidechainFiles,
+    const OutputLayout& layout) {
     
     QList<BatchProcessor::JobInfo> jobs;
     
@@ -474,10 +604,14 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildBroadcastRandom(
         // Include "rnd" marker so user knows randomness was involved
         QString combined = baseName(mainFile.fileName) + "_" + baseName(auxFile.fileName);
         job.combinedBaseName = combined;
-        job.outputPath = buildOutputPath(combined, outputFolder, filterChain);
+        job.outputPath = buildOutputPath(
+            combined, shardFolder(outputFolder, layout, baseName(mainFile.fileName), baseName(auxFile.fileName),
+                                  combined, jobs.size()),
+            filterChain);
         job.sidechainFiles = buildSidechainList(otherSidechainFiles, auxFile.filePath, aux1InputIndex);
+        job.durationSec = outputDuration(filterChain, mutedPositions, mainFile, &auxFile);
         job.command = buildCommand(mainFile.filePath, job.sidechainFiles, job.outputPath,
-                                   filterChain, mutedPositions);
+                                   filterChain, mutedPositions, &job.analysisOnly);
         
         jobs.append(job);
     }
@@ -494,7 +628,8 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildCartesian(
     const QString& outputFolder,
     std::shared_ptr<FilterChain> filterChain,
     const QList<int>& mutedPositions,
-    const QStringList& otherSidechainFiles) {
+    const QStringList& otherSidechainFiles,
+    const OutputLayout& layout) {
     
     QList<BatchProcessor::JobInfo> jobs;
     
@@ -510,10 +645,14 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildCartesian(
             
             QString combined = baseName(mainFile.fileName) + "_" + baseName(auxFile.fileName);
             job.combinedBaseName = combined;
-            job.outputPath = buildOutputPath(combined, outputFolder, filterChain);
+            job.outputPath = buildOutputPath(
+                combined, shardFolder(outputFolder, layout, baseName(mainFile.fileName), baseName(auxFile.fileName),
+                                      combined, jobs.size()),
+                filterChain);
             job.sidechainFiles = buildSidechainList(otherSidechainFiles, auxFile.filePath, aux1InputIndex);
+            job.durationSec = outputDuration(filterChain, mutedPositions, mainFile, &auxFile);
             job.command = buildCommand(mainFile.filePath, job.sidechainFiles, job.outputPath,
-                                       filterChain, mutedPositions);
+                                       filterChain, mutedPositions, &job.analysisOnly);
             
             jobs.append(job);
         }
@@ -533,7 +672,8 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildCartesianTriple(
     const QString& outputFolder,
     std::shared_ptr<FilterChain> filterChain,
     const QList<int>& mutedPositions,
-    const QStringList& otherSidechainFiles) {
+    const QStringList& otherSidechainFiles,
+    const OutputLayout& layout) {
     
     QList<BatchProcessor::JobInfo> jobs;
     
@@ -552,12 +692,17 @@ QList<BatchProcessor::JobInfo> JobListBuilder::buildCartesianTriple(
                                    baseName(aux1File.fileName) + "_" +
                                    baseName(aux2File.fileName);
                 job.combinedBaseName = combined;
-                job.outputPath = buildOutputPath(combined, outputFolder, filterChain);
+                job.outputPath = buildOutputPath(
+                    combined, shardFolder(outputFolder, layout, baseName(mainFile.fileName), baseName(aux1File.fileName),
+                                          combined, jobs.size()),
+                    filterChain);
                 job.sidechainFiles = buildSidechainList(otherSidechainFiles,
                                                         aux1File.filePath, aux1InputIndex,
                                                         aux2File.filePath, aux2InputIndex);
+                job.durationSec = outputDuration(filterChain, mutedPositions, mainFile,
+                                                 &aux1File, &aux2File);
                 job.command = buildCommand(mainFile.filePath, job.sidechainFiles, job.outputPath,
-                                           filterChain, mutedPositions);
+                                           filterChain, mutedPositions, &job.analysisOnly);
                 
                 jobs.append(job);
             }
@@ -609,6 +754,57 @@ JobListBuilder::SizeEstimate JobListBuilder::estimateSize(
     return est;
 }
 
+void JobListBuilder::setExpectedOutputSizes(QList<BatchProcessor::JobInfo>& jobs,
+                                            std::shared_ptr<FilterChain> filterChain) {
+    if (!filterChain) return;
+    
+    auto lastFilter = filterChain->getFilter(filterChain->filterCount() - 1);
+    auto* output = dynamic_cast<OutputFilter*>(lastFilter.get());
+    if (!output) return;
+    
+    const QString format = output->getFileExtension();
+    const int pcmBits = output->pcmBitsPerSample();
+    
+    for (auto& job : jobs) {
+        if (job.analysisOnly || job.isMeasurement) continue;
+        
+        double seconds = job.durationSec;
+        if (seconds <= 0.0) {
+            QStringList parts = job.inputFile.duration.split(':');
+            if (parts.size() == 3) {
+                seconds = parts[0].toInt() * 3600 + parts[1].toInt() * 60 + parts[2].toDouble();
+            }
+        }
+        if (seconds <= 0.0) continue;
+        
+        const FileListWidget::AudioFileInfo& in = job.inputFile;
+        int channels = in.channels > 0 ? in.channels : 2;
+        int sampleRate = pcmBits > 0 ? output->getSampleRate() : (in.sampleRate > 0 ? in.sampleRate : 48000);
+        int bitDepth = pcmBits > 0 ? pcmBits : (in.bitsPerSample > 0 ? in.bitsPerSample : 24);
+        
+        double bytesPerSec = estimateBytesPerSecond(format, sampleRate, bitDepth, channels);
+        job.expectedBytes = static_cast<qint64>(std::ceil(seconds * bytesPerSec));
+        job.pcmOutput = pcmBits > 0;
+    }
+}
+
+void JobListBuilder::setBranchOutputPaths(QList<BatchProcessor::JobInfo>& jobs,
+                                          std::shared_ptr<FilterChain> filterChain,
+                                          const QList<int>& mutedPositions) {
+    if (!filterChain) return;
+    
+    for (auto& job : jobs) {
+        if (job.analysisOnly || job.isMeasurement) continue;
+        job.branchOutputPaths.clear();
+        
+        // In-process Iterate commands map no branch outputs
+        for (const auto& path : filterChain->branchOutputPaths(
+                 job.inputFile.filePath, job.outputPath, mutedPositions)) {
+            if (job.command.contains(QString("\"%1\"").arg(path))) job.branchOutputPaths.append(path);
+        }
+    }
+}
+
 QString JobListBuilder::formatBytes(qint64 bytes) {
     if (bytes < 0) return "~0 B";
     
@@ -625,6 +821,89 @@ QString JobListBuilder::formatBytes(qint64 bytes) {
     }
 }
 
+// ========== TWO-PASS LOUDNORM ==========
+
+QList<BatchProcessor::JobInfo> JobListBuilder::addLoudnormMeasurePasses(
+    const QList<BatchProcessor::JobInfo>& jobs,
+    std::shared_ptr<FilterChain> filterChain,
+    const QList<int>& mutedPositions) {
+    
+    if (!filterChain || jobs.isEmpty()) return jobs;
+    
+    QList<BatchProcessor::JobInfo> result;
+    result.reserve(jobs.size() * 2);
+    QList<int> newIndex(jobs.size(), -1);
+    int measured = 0;
+    int cached = 0;
+    
+    for (int j = 0; j < jobs.size(); ++j) {
+        BatchProcessor::JobInfo render = jobs[j];
+        if (render.dependsOn >= 0 && render.dependsOn < j) {
+            render.dependsOn = newIndex[render.dependsOn];
+        }
+        
+        int loudnormFilterId = -1;
+        QString signature;
+        QString measureCommand;
+        if (render.extraOutputPaths.isEmpty()) {
+            measureCommand = filterChain->buildLoudnormMeasureCommand(
+                render.inputFile.filePath, render.sidechainFiles, mutedPositions,
+                &loudnormFilterId, &signature);
+        }
+        
+        if (measureCommand.isEmpty()) {
+            if (j == 0) return jobs;  // Chain has no two-pass loudnorm
+            newIndex[j] = result.size();
+            result.append(render);
+            continue;
+        }
+        
+        // Inputs produced inside this batch (Iterate passes) can't be cached
+        // up front — their key only links the measurement to its render
+        QString key;
+        if (render.dependsOn < 0) {
+            key = LoudnormMeasurement::cacheKey(render.inputFile.filePath,
+                                                render.sidechainFiles, signature);
+        }
+        
+        LoudnormMeasurement measurement;
+        QString measuredCommand;
+        if (LoudnormMeasurement::lookup(key, &measurement)) {
+            measuredCommand = measurement.applyToCommand(render.command, loudnormFilterId);
+        }
+        
+        if (!measuredCommand.isEmpty()) {
+            render.command = measuredCommand;
+            ++cached;
+        } else {
+            if (key.isEmpty()) key = QUuid::createUuid().toString(QUuid::WithoutBraces);
+            
+            BatchProcessor::JobInfo measure;
+            measure.inputFile = render.inputFile;
+            measure.sidechainFiles = render.sidechainFiles;
+            measure.combinedBaseName = render.combinedBaseName;
+            measure.command = measureCommand;
+            measure.dependsOn = render.dependsOn;
+            measure.isMeasurement = true;
+            measure.measurementKey = key;
+            
+            render.dependsOn = result.size();
+            render.measurementKey = key;
+            render.loudnormFilterId = loudnormFilterId;
+            result.append(measure);
+            ++measured;
+        }
+        
+        newIndex[j] = result.size();
+        result.append(render);
+    }
+    
+    qDebug() << "Loudnorm two-pass:" << measured << "measurement jobs,"
+             << cached << "renders from cached measurements";
+    
+    return result;
+}
+
 // ========== VALIDATION ==========
 
 QString JobListBuilder::validateOutputCount(int count) {
@@ -10,6 +10,23 @@
 class FilterChain;
 class OutputFilter;
 
+/**
+ * OutputLayout - Subfolder of the OUTPUT folder each batch output goes into,
+ * so million-file batches don't end up in one flat directory
+ */
+struct OutputLayout {
+    enum class Sharding {
+        None = 0,      // outputFolder/drums_hall.wav
+        MainName,      // outputFolder/drums/drums_hall.wav
+        AuxName,       // outputFolder/hall/drums_hall.wav (main name without an aux)
+        HashPrefix,    // outputFolder/3f/drums_hall.wav — 256 evenly filled folders
+        Count          // outputFolder/0000/ ... filesPerFolder outputs each
+    };
+    
+    Sharding sharding = Sharding::None;
+    int filesPerFolder = 1000;
+};
+
 /**
  * JobListBuilder - Pure logic: algorithm + file inputs → flat QList<JobInfo>
  * 
@@ -98,13 +115,20 @@ public:
         const QString& outputFolder,
         std::shared_ptr<FilterChain> filterChain,
         const QList<int>& mutedPositions,
-        const QStringList& sidechainFiles);
+        const QStringList& sidechainFiles,
+        const OutputLayout& layout = {});
     
     // Algorithm 2: Iterate — re-process each file R times through the chain.
     // "Photocopying a photocopy" — each pass accumulates the chain's effect.
     // A per-iteration gain reduction (dB) is injected before each pass to prevent
     // runaway clipping. All intermediate results are preserved.
-    // If any iteration fails, remaining iterations for that file are aborted (isCascade).
+    // Each pass depends on the previous one (dependsOn); if an iteration fails,
+    // only that file's remaining iterations are aborted.
+    //
+    // When the chain allows it (see FilterChain::buildIterateCommand) and the
+    // output is not lossy, all R passes of a file run in one ffmpeg process
+    // instead: one job per file, one decode, each pass tapped to its own file.
+    // Lossy outputs keep the cascade so every pass re-encodes like the original.
     //
     // Output naming: drums_i01, drums_i02, drums_i03 ... drums_i10
     // Output count:  N files × R repeats
@@ -115,7 +139,8 @@ public:
         const QString& outputFolder,
         std::shared_ptr<FilterChain> filterChain,
         const QList<int>& mutedPositions,
-        const QStringList& sidechainFiles);
+        const QStringList& sidechainFiles,
+        const OutputLayout& layout = {});
     
     // Algorithm 3: Zip — 1:1 pairing of main + aux1
     static QList<BatchProcessor::JobInfo> buildZip(
@@ -126,7 +151,8 @@ public:
         std::shared_ptr<FilterChain> filterChain,
         const QList<int>& mutedPositions,
         const QStringList& otherSidechainFiles,
-        ZipMismatch mismatchMode = ZipMismatch::Truncate);
+        ZipMismatch mismatchMode = ZipMismatch::Truncate,
+        const OutputLayout& layout = {});
     
     // Algorithm 4: Broadcast Fixed — single aux applied to every main
     static QList<BatchProcessor::JobInfo> buildBroadcastFixed(
@@ -136,7 +162,8 @@ public:
         const QString& outputFolder,
         std::shared_ptr<FilterChain> filterChain,
         const QList<int>& mutedPositions,
-        const QStringList& otherSidechainFiles);
+        const QStringList& otherSidechainFiles,
+        const OutputLayout& layout = {});
     
     // Algorithm 5: Broadcast Random — random aux per main file
     static QList<BatchProcessor::JobInfo> buildBroadcastRandom(
@@ -146,7 +173,8 @@ public:
         const QString& outputFolder,
         std::shared_ptr<FilterChain> filterChain,
         const QList<int>& mutedPositions,
-        const QStringList& otherSidechainFiles);
+        const QStringList& otherSidechainFiles,
+        const OutputLayout& layout = {});
     
     // Algorithm 6: Cartesian — every main × every aux
     static QList<BatchProcessor::JobInfo> buildCartesian(
@@ -156,7 +184,8 @@ public:
         const QString& outputFolder,
         std::shared_ptr<FilterChain> filterChain,
         const QList<int>& mutedPositions,
-        const QStringList& otherSidechainFiles);
+        const QStringList& otherSidechainFiles,
+        const OutputLayout& layout = {});
     
     // Algorithm 7: Cartesian Triple — N × M × P
     static QList<BatchProcessor::JobInfo> buildCartesianTriple(
@@ -168,7 +197,21 @@ public:
         const QString& outputFolder,
         std::shared_ptr<FilterChain> filterChain,
         const QList<int>& mutedPositions,
-        const QStringList& otherSidechainFiles);
+        const QStringList& otherSidechainFiles,
+        const OutputLayout& layout = {});
+    
+    // ========== Two-Pass Loudnorm ==========
+    
+    // If the chain has a two-pass FFLoudnorm, give every render job a
+    // measurement job (analysis only, -f null) that it depends on. Renders
+    // whose input already has a cached measurement get it applied directly
+    // and no measurement job. Measurements of one file don't depend on each
+    // other, so they spread across all workers. Existing dependsOn indices
+    // are remapped. In-process Iterate jobs are left single-pass.
+    static QList<BatchProcessor::JobInfo> addLoudnormMeasurePasses(
+        const QList<BatchProcessor::JobInfo>& jobs,
+        std::shared_ptr<FilterChain> filterChain,
+        const QList<int>& mutedPositions);
     
     // ========== Size Estimation ==========
     
@@ -187,6 +230,20 @@ public:
         int bitDepth = 24,
         int channels = 2);
     
+    // Fill JobInfo::expectedBytes: output duration × estimateBytesPerSecond,
+    // input channel count. Uncompressed outputs use the OUTPUT rate and bit
+    // depth and are marked pcmOutput; other formats use the input's.
+    static void setExpectedOutputSizes(
+        QList<BatchProcessor::JobInfo>& jobs,
+        std::shared_ptr<FilterChain> filterChain);
+    
+    // Fill JobInfo::branchOutputPaths (FilterChain::branchOutputPaths) so
+    // aux and image outputs are staged and committed with the main output
+    static void setBranchOutputPaths(
+        QList<BatchProcessor::JobInfo>& jobs,
+        std::shared_ptr<FilterChain> filterChain,
+        const QList<int>& mutedPositions);
+    
     // Format byte count as human-readable string ("~1.2 GB")
     static QString formatBytes(qint64 bytes);
     
@@ -206,13 +263,25 @@ private:
         const QString& outputFolder,
         std::shared_ptr<FilterChain> filterChain);
     
-    // Build FFmpeg command for a job
+    // Folder an output goes into under the layout. ordinal = outputs
+    // produced so far (Count); auxName may be empty (AuxName falls back to mainName)
+    static QString shardFolder(
+        const QString& outputFolder,
+        const OutputLayout& layout,
+        const QString& mainName,
+        const QString& auxName,
+        const QString& combinedBaseName,
+        int ordinal);
+    
+    // Build FFmpeg command for a job (analysis command for measure-only chains).
+    // analysisOnly receives whether it is one (JobInfo::analysisOnly).
     static QString buildCommand(
         const QString& mainInputPath,
         const QStringList& sidechainFiles,
         const QString& outputPath,
         std::shared_ptr<FilterChain> filterChain,
-        const QList<int>& mutedPositions);
+        const QList<int>& mutedPositions,
+        bool* analysisOnly = nullptr);
     
     // Build FFmpeg command with a volume filter prepended to the filter graph.
     // Used by Iterate to inject per-pass gain reduction.
@@ -224,7 +293,8 @@ private:
         const QString& outputPath,
         std::shared_ptr<FilterChain> filterChain,
         const QList<int>& mutedPositions,
-        double gainDb);
+        double gainDb,
+        bool* analysisOnly = nullptr);
     
     // Prepare sidechain file list with a specific aux file at a specific index
     static QStringList buildSidechainList(
@@ -234,6 +304,15 @@ private:
         const QString& aux2File = QString(),
         int aux2InputIndex = -1);
     
+    // Expected output length of a job from its input durations
+    // (see FilterChain::estimateOutputDuration)
+    static double outputDuration(
+        std::shared_ptr<FilterChain> filterChain,
+        const QList<int>& mutedPositions,
+        const FileListWidget::AudioFileInfo& mainFile,
+        const FileListWidget::AudioFileInfo* aux1File,
+        const FileListWidget::AudioFileInfo* aux2File = nullptr);
+    
     // Extract base name without extension from a file path or file name
     static QString baseName(const QString& fileNameOrPath);
 };
@@ -0,0 +1,196 @@
+#include "LoudnormMeasurement.h"
+#include <QFileInfo>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QHash>
+#include <QtNumeric>
+#include <QDebug>
+
+namespace {
+
+// Session-wide cache (main thread only)
+QHash<QString, LoudnormMeasurement>& measurementCache() {
+    static QHash<QString, LoudnormMeasurement> cache;
+    return cache;
+}
+
+// loudnorm prints its numbers as JSON strings ("-23.45"), older builds as numbers
+double jsonNumber(const QJsonObject& obj, const QString& key, bool* ok) {
+    QJsonValue value = obj.value(key);
+    if (value.isDouble()) return value.toDouble();
+    bool converted = false;
+    double result = value.toString().toDouble(&converted);
+    if (!converted) *ok = false;
+    return result;
+}
+
+// Split "loudnorm=a=1:b=2" (or "loudnorm@name=...") into ordered key/value
+// pairs; name receives the filter name so joinOptions() can restore it
+QList<QPair<QString, QString>> splitOptions(const QString& loudnormFlags, QString* name) {
+    QList<QPair<QString, QString>> options;
+    QString body = loudnormFlags;
+    *name = "loudnorm";
+    if (body.startsWith("loudnorm")) {
+        int eq = body.indexOf('=');
+        *name = eq < 0 ? body : body.left(eq);
+        body = eq < 0 ? QString() : body.mid(eq + 1);
+    }
+
+    for (const QString& part : body.split(':', Qt::SkipEmptyParts)) {
+        int eq = part.indexOf('=');
+        if (eq < 0) continue;
+        options.append({part.left(eq), part.mid(eq + 1)});
+    }
+    return options;
+}
+
+QString joinOptions(const QString& name, const QList<QPair<QString, QString>>& options) {
+    QStringList parts;
+    for (const auto& option : options) {
+        parts << option.first + "=" + option.second;
+    }
+    return parts.isEmpty() ? name : name + "=" + parts.join(':');
+}
+
+// The instance's "name=opts" span in a command: it ends at the next filter
+// (',' ';'), output label ('[') or the closing quote of -filter_complex
+bool findInstance(const QString& command, int filterId, int* start, int* length) {
+    QString name = LoudnormMeasurement::instanceName(filterId);
+    int pos = 0;
+    while ((pos = command.indexOf(name, pos)) >= 0) {
+        int end = pos + name.size();
+        // Don't match the prefix of a longer id (ffab1 in ffab12)
+        if (end == command.size() || !command[end].isLetterOrNumber()) {
+            while (end < command.size() && !QString(",;[\"").contains(command[end])) ++end;
+            *start = pos;
+            *length = end - pos;
+            return true;
+        }
+        pos = end;
+    }
+    return false;
+}
+
+void setOption(QList<QPair<QString, QString>>& options, const QString& key, const QString& value) {
+    for (auto& option : options) {
+        if (option.first == key) {
+            option.second = value;
+            return;
+        }
+    }
+    options.append({key, value});
+}
+
+} // namespace
+
+LoudnormMeasurement LoudnormMeasurement::parse(const QString& output) {
+    LoudnormMeasurement m;
+
+    // The JSON block follows "[Parsed_loudnorm_N @ 0x...]" and is the last
+    // brace-delimited object containing input_i
+    int keyPos = output.lastIndexOf("\"input_i\"");
+    if (keyPos < 0) return m;
+    int start = output.lastIndexOf('{', keyPos);
+    int end = output.indexOf('}', keyPos);
+    if (start < 0 || end < 0) return m;
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(output.mid(start, end - start + 1).toUtf8(), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        qWarning() << "LoudnormMeasurement: Malformed JSON:" << error.errorString();
+        return m;
+    }
+
+    QJsonObject obj = doc.object();
+    bool ok = true;
+    m.inputI       = jsonNumber(obj, "input_i", &ok);
+    m.inputLRA     = jsonNumber(obj, "input_lra", &ok);
+    m.inputTP      = jsonNumber(obj, "input_tp", &ok);
+    m.inputThresh  = jsonNumber(obj, "input_thresh", &ok);
+    m.targetOffset = jsonNumber(obj, "target_offset", &ok);
+
+    // Silence measures as -inf, which loudnorm rejects as measured_I
+    m.valid = ok && qIsFinite(m.inputI) && qIsFinite(m.inputThresh);
+    return m;
+}
+
+QString LoudnormMeasurement::measureFlags(const QString& loudnormFlags) {
+    QString name;
+    auto options = splitOptions(loudnormFlags, &name);
+    setOption(options, "print_format", "json");
+    return joinOptions(name, options);
+}
+
+QString LoudnormMeasurement::applyTo(const QString& loudnormFlags) const {
+    if (!valid) return loudnormFlags;
+
+    QString name;
+    auto options = splitOptions(loudnormFlags, &name);
+
+    double userOffset = 0.0;
+    for (const auto& option : options) {
+        if (option.first == "offset") userOffset = option.second.toDouble();
+    }
+
+    setOption(options, "measured_I", QString::number(inputI, 'f', 2));
+    setOption(options, "measured_LRA", QString::number(inputLRA, 'f', 2));
+    setOption(options, "measured_TP", QString::number(inputTP, 'f', 2));
+    setOption(options, "measured_thresh", QString::number(inputThresh, 'f', 2));
+    setOption(options, "offset", QString::number(userOffset + targetOffset, 'f', 2));
+    setOption(options, "linear", "true");
+    return joinOptions(name, options);
+}
+
+// ========== NAMED INSTANCE ==========
+
+QString LoudnormMeasurement::instanceName(int filterId) {
+    return QString("loudnorm@ffab%1").arg(filterId);
+}
+
+QString LoudnormMeasurement::measureCommand(const QString& command, int filterId) {
+    int start = 0, length = 0;
+    if (!findInstance(command, filterId, &start, &length)) return QString();
+    QString result = command;
+    return result.replace(start, length, measureFlags(command.mid(start, length)));
+}
+
+QString LoudnormMeasurement::applyToCommand(const QString& command, int filterId) const {
+    int start = 0, length = 0;
+    if (!findInstance(command, filterId, &start, &length)) return QString();
+    QString result = command;
+    return result.replace(start, length, applyTo(command.mid(start, length)));
+}
+
+QString LoudnormMeasurement::cacheKey(const QString& inputFile,
+                                      const QStringList& sidechainFiles,
+                                      const QString& analysisSignature) {
+    QFileInfo info(inputFile);
+    if (!info.exists()) return QString();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(info.absoluteFilePath().toUtf8());
+    hash.addData(QByteArray::number(info.size()));
+    hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    for (const QString& sidechain : sidechainFiles) {
+        QFileInfo scInfo(sidechain);
+        hash.addData(scInfo.absoluteFilePath().toUtf8());
+        hash.addData(QByteArray::number(scInfo.lastModified().toMSecsSinceEpoch()));
+    }
+    hash.addData(analysisSignature.toUtf8());
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+bool LoudnormMeasurement::lookup(const QString& key, LoudnormMeasurement* result) {
+    if (key.isEmpty()) return false;
+    auto it = measurementCache().constFind(key);
+    if (it == measurementCache().constEnd()) return false;
+    if (result) *result = it.value();
+    return true;
+}
+
+void LoudnormMeasurement::store(const QString& key, const LoudnormMeasurement& measurement) {
+    if (key.isEmpty() || !measurement.valid) return;
+    measurementCache().insert(key, measurement);
+}
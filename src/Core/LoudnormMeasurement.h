@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * LoudnormMeasurement - First-pass results for two-pass EBU R128 normalization
+ *
+ * The loudnorm filter in single-pass mode has to guess ahead (dynamic mode).
+ * Two-pass mode measures the whole file first with print_format=json and
+ * feeds the results back as measured_* with linear=true, which applies a
+ * single static gain whenever the targets allow it.
+ *
+ *   - parse() reads the JSON block loudnorm prints to stderr on the
+ *     analysis pass (-f null, no encode)
+ *   - measureFlags() / applyTo() rewrite a loudnorm flag string for the
+ *     analysis and render passes
+ *   - A two-pass FFLoudnorm runs as the named instance
+ *     "loudnorm@ffab<filterId>", so measureCommand() / applyToCommand()
+ *     rewrite exactly that filter in a built command and nothing else
+ *   - Results are cached for the session, keyed on input path + size +
+ *     mtime + the filters feeding loudnorm, so re-renders skip the
+ *     analysis pass
+ */
+struct LoudnormMeasurement {
+    double inputI = 0.0;
+    double inputLRA = 0.0;
+    double inputTP = 0.0;
+    double inputThresh = 0.0;
+    double targetOffset = 0.0;
+    bool valid = false;
+
+    // Parse the last loudnorm JSON block in ffmpeg's stderr output
+    static LoudnormMeasurement parse(const QString& output);
+
+    // Analysis pass flags: same targets, print_format=json
+    static QString measureFlags(const QString& loudnormFlags);
+
+    // Render pass flags: measured_* values, offset += target_offset, linear=true
+    QString applyTo(const QString& loudnormFlags) const;
+
+    // ========== Named instance ==========
+
+    // "loudnorm@ffab<filterId>" — the filter name a two-pass FFLoudnorm emits
+    static QString instanceName(int filterId);
+
+    // measureFlags() / applyTo() on the instance's options inside a full
+    // command or filtergraph. Returns empty if the instance isn't in it.
+    static QString measureCommand(const QString& command, int filterId);
+    QString applyToCommand(const QString& command, int filterId) const;
+
+    // ========== Session cache ==========
+
+    // Key for a measurement of inputFile through the given analysis filters.
+    // Returns empty if inputFile doesn't exist yet (e.g. an Iterate pass) —
+    // such measurements are never cached.
+    static QString cacheKey(const QString& inputFile,
+                            const QStringList& sidechainFiles,
+                            const QString& analysisSignature);
+
+    static bool lookup(const QString& key, LoudnormMeasurement* result);
+    static void store(const QString& key, const LoudnormMeasurement& measurement);
+};
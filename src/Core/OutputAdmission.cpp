@@ -0,0 +1,211 @@
+#include "OutputAdmission.h"
+#include <QFileInfo>
+#include <QDir>
+#include <QSettings>
+#include <QDebug>
+#include <cmath>
+
+void OutputAdmission::reset(int poolSize) {
+    QSettings settings;
+    m_minFreeBytes = settings.value("processing/minFreeSpaceMB", 1024).toLongLong() * 1024 * 1024;
+    m_adaptiveWriters = settings.value("processing/adaptiveWriters", true).toBool();
+    m_poolSize = qMax(1, poolSize);
+    m_dirRoots.clear();
+    m_volumes.clear();
+    m_clock.start();
+}
+
+OutputAdmission::Volume& OutputAdmission::volumeFor(const QString& outputPath) {
+    const QString dir = QFileInfo(outputPath).absolutePath();
+    auto it = m_dirRoots.constFind(dir);
+    if (it != m_dirRoots.constEnd()) return m_volumes[it.value()];
+
+    // Output subfolders may not exist yet — the nearest existing parent is
+    // on the same volume
+    QDir existing(dir);
+    while (!existing.exists() && existing.cdUp()) {}
+
+    QStorageInfo storage(existing.absolutePath());
+    const QString root = storage.isValid() ? storage.rootPath() : QString();
+    m_dirRoots.insert(dir, root);
+
+    auto volume = m_volumes.find(root);
+    if (volume == m_volumes.end()) {
+        volume = m_volumes.insert(root, Volume{});
+        volume->storage = storage;
+        volume->refreshedMs = m_clock.elapsed();
+        volume->cap = m_poolSize;
+        volume->windowStartMs = volume->lastChangeMs = m_clock.elapsed();
+    }
+    return volume.value();
+}
+
+qint64 OutputAdmission::freeBytes(Volume& v) {
+    // statvfs per dispatch adds up over a million jobs. What the running
+    // jobs have written is already out of the free space, so their
+    // unwritten remainder is measured at the same moment.
+    const qint64 now = m_clock.elapsed();
+    if (now - v.refreshedMs >= RefreshMs) {
+        v.storage.refresh();
+        v.refreshedMs = now;
+
+        v.unwrittenBytes = 0;
+        for (auto& job : v.running) {
+            qint64 written = 0;
+            for (const auto& path : job.paths) written += QFileInfo(path).size();
+            job.unwrittenBytes = qMax<qint64>(0, job.bytes - written);
+            v.unwrittenBytes += job.unwrittenBytes;
+        }
+    }
+    return v.storage.isValid() ? v.storage.bytesAvailable() : -1;
+}
+
+void OutputAdmission::removeRunning(Volume& v, const QString& outputPath) {
+    auto it = v.running.find(outputPath);
+    if (it == v.running.end()) return;
+    v.unwrittenBytes = qMax<qint64>(0, v.unwrittenBytes - it->unwrittenBytes);
+    v.running.erase(it);
+}
+
+// ========== JOB LIFECYCLE ==========
+
+void OutputAdmission::addPending(const QString& outputPath, qint64 bytes) {
+    volumeFor(outputPath).pendingBytes += bytes;
+}
+
+void OutputAdmission::dropPending(const QString& outputPath, qint64 bytes) {
+    Volume& v = volumeFor(outputPath);
+    v.pendingBytes = qMax<qint64>(0, v.pendingBytes - bytes);
+}
+
+OutputAdmission::Verdict OutputAdmission::check(const QString& outputPath, qint64 bytes) {
+    Volume& v = volumeFor(outputPath);
+
+    if (v.writers >= v.cap) return Verdict::WriterLimit;
+
+    const qint64 free = freeBytes(v);
+    if (free < 0 || m_minFreeBytes <= 0) return Verdict::Admit;  // unknown volume — don't block
+
+    if (!v.warnedShort && free < v.pendingBytes + v.unwrittenBytes) {
+        v.warnedShort = true;
+        qWarning() << "OutputAdmission: Batch needs about" << (v.pendingBytes + v.unwrittenBytes) / (1024 * 1024)
+                   << "MB on" << v.storage.rootPath() << "but only" << free / (1024 * 1024)
+                   << "MB are free — it will pause when space runs low";
+    }
+
+    if (free - v.unwrittenBytes - bytes < m_minFreeBytes) return Verdict::LowSpace;
+    return Verdict::Admit;
+}
+
+void OutputAdmission::jobStarted(const QString& outputPath, qint64 bytes,
+                                 const QStringList& writingPaths, bool reserved) {
+    Volume& v = volumeFor(outputPath);
+    accumulate(v);
+    ++v.writers;
+    v.pendingBytes = qMax<qint64>(0, v.pendingBytes - bytes);
+
+    // Counted whole until the next refresh sees what it has written. A
+    // reservation is out of the free space from then on, however little
+    // of it the files' length shows.
+    Running job;
+    job.paths = reserved ? QStringList() : writingPaths;
+    job.bytes = reserved ? 0 : bytes;
+    job.unwrittenBytes = bytes;
+    removeRunning(v, outputPath);
+    v.running.insert(outputPath, job);
+    v.unwrittenBytes += bytes;
+}
+
+void OutputAdmission::jobFinished(const QString& outputPath, qint64 writtenBytes) {
+    Volume& v = volumeFor(outputPath);
+    accumulate(v);
+    v.writers = qMax(0, v.writers - 1);
+    removeRunning(v, outputPath);
+    if (writtenBytes > 0) {
+        v.windowBytes += writtenBytes;
+        ++v.windowJobs;
+    }
+    if (m_adaptiveWriters) sample(v);
+}
+
+void OutputAdmission::jobAborted(const QString& outputPath, qint64 bytes) {
+    Volume& v = volumeFor(outputPath);
+    accumulate(v);
+    v.writers = qMax(0, v.writers - 1);
+    removeRunning(v, outputPath);
+    v.pendingBytes += bytes;
+}
+
+OutputAdmission::VolumeStatus OutputAdmission::status(const QString& outputPath) {
+    Volume& v = volumeFor(outputPath);
+    VolumeStatus s;
+    s.rootPath = v.storage.rootPath();
+    s.freeBytes = qMax<qint64>(0, freeBytes(v));
+    s.remainingBytes = v.pendingBytes + v.unwrittenBytes;
+    return s;
+}
+
+// ========== WRITER CAP ==========
+
+void OutputAdmission::accumulate(Volume& v) {
+    const qint64 now = m_clock.elapsed();
+    v.writerMs += static_cast<double>(v.writers) * (now - v.lastChangeMs);
+    v.lastChangeMs = now;
+}
+
+void OutputAdmission::sample(Volume& v) {
+    const qint64 windowMs = m_clock.elapsed() - v.windowStartMs;
+    if (windowMs < WindowMs || v.windowJobs < 2) return;
+
+    const double writers = v.writerMs / windowMs;
+    const double throughput = v.windowBytes * 1000.0 / windowMs;
+    bool keepBaseline = false;
+
+    if (v.probe != 0) {
+        if (std::abs(writers - v.lastWriters) < 0.5) {
+            keepBaseline = true;   // jobs haven't turned over to the new cap yet
+        } else if (v.probe < 0) {
+            if (throughput >= v.lastThroughput * 0.9) {
+                // Fewer writers, as many bytes — the disk is the bottleneck
+                qDebug() << "OutputAdmission: Write throughput holds at" << throughput / (1024 * 1024)
+                         << "MB/s on" << v.storage.rootPath() << "— capping writers at" << v.cap;
+                v.holdoff = 1;
+                v.nextProbe = -1;
+            } else {
+                ++v.cap;   // the writer was pulling its weight
+                v.holdoff = 10;
+                v.nextProbe = 1;
+            }
+            v.probe = 0;
+        } else {
+            if (throughput < v.lastThroughput * 1.1) {
+                --v.cap;   // more writers, no more bytes
+                v.holdoff = 10;
+                v.nextProbe = -1;
+            } else {
+                v.holdoff = 1;
+                v.nextProbe = 1;
+            }
+            v.probe = 0;
+        }
+    } else if (v.holdoff > 0) {
+        --v.holdoff;
+    } else if (v.lastThroughput > 0.0 && writers >= v.cap - 0.5) {
+        // The cap binds — would one writer fewer (or more) do as well?
+        int direction = v.cap >= m_poolSize ? -1 : v.cap <= 1 ? 1 : v.nextProbe;
+        if (direction < 0 && v.cap <= 1) direction = 0;
+        if (direction != 0) {
+            v.probe = direction;
+            v.cap += direction;
+        }
+    }
+
+    if (!keepBaseline) {
+        v.lastWriters = writers;
+        v.lastThroughput = throughput;
+    }
+    v.windowStartMs = v.lastChangeMs;
+    v.writerMs = 0.0;
+    v.windowBytes = 0;
+    v.windowJobs = 0;
+}
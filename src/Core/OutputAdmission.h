@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QStorageInfo>
+
+/**
+ * OutputAdmission - Disk space and write bandwidth gate for batch dispatch
+ *
+ * BatchProcessor asks before dispatching each job that writes files. Jobs
+ * are grouped by the volume their output folder sits on.
+ *
+ *   Space      The job is admitted only if the volume keeps at least
+ *              "processing/minFreeSpaceMB" (default 1024, 0 = off) free
+ *              after its estimated output and what the jobs still writing
+ *              have yet to write (estimate minus their files' current
+ *              size, taken with the free space). Otherwise the batch
+ *              should stop dispatching and pause.
+ *   Bandwidth  With "processing/adaptiveWriters" (default on), at most
+ *              a per-volume cap of jobs write at once. The cap starts at
+ *              the pool size and follows measured write throughput —
+ *              output bytes of finished jobs per second over a few
+ *              seconds. While the cap binds it probes one writer fewer:
+ *              if throughput holds within 10% the disk is saturated and
+ *              the lower cap stays (and is probed again); otherwise the
+ *              writer is restored. Below the pool it also probes one
+ *              writer more, kept only if it adds 10%.
+ *
+ * Estimates are JobInfo::expectedBytes (JobListBuilder::setExpectedOutputSizes);
+ * jobs without one still need the minimum free space.
+ */
+class OutputAdmission {
+public:
+    enum class Verdict { Admit, WriterLimit, LowSpace };
+
+    struct VolumeStatus {
+        QString rootPath;
+        qint64 freeBytes = 0;
+        qint64 remainingBytes = 0;   // estimate of every output not yet finished
+    };
+
+    void reset(int poolSize);
+
+    // Job lifecycle — bytes is the job's whole output estimate
+    void addPending(const QString& outputPath, qint64 bytes);    // once per job at start()
+    void dropPending(const QString& outputPath, qint64 bytes);   // will never run (cascade broken)
+    Verdict check(const QString& outputPath, qint64 bytes);
+    // writingPaths are the files the job grows (temp names when staged);
+    // reserved = their space was preallocated, so free space already has it
+    void jobStarted(const QString& outputPath, qint64 bytes,
+                    const QStringList& writingPaths, bool reserved);
+    void jobFinished(const QString& outputPath, qint64 writtenBytes);
+    void jobAborted(const QString& outputPath, qint64 bytes);    // re-queued by pause
+
+    VolumeStatus status(const QString& outputPath);
+
+private:
+    struct Running {
+        QStringList paths;
+        qint64 bytes = 0;
+        qint64 unwrittenBytes = 0;   // as of the last free-space refresh
+    };
+
+    struct Volume {
+        QStorageInfo storage;
+        qint64 refreshedMs = -1;
+        qint64 pendingBytes = 0;     // queued or waiting
+        qint64 unwrittenBytes = 0;   // sum of running[].unwrittenBytes
+        QHash<QString, Running> running;   // output path → dispatched, not finished
+        int writers = 0;
+        int cap = 1;
+        bool warnedShort = false;
+
+        // Current throughput window
+        qint64 windowStartMs = 0;
+        qint64 lastChangeMs = 0;
+        double writerMs = 0.0;       // writers integrated over the window
+        qint64 windowBytes = 0;
+        int windowJobs = 0;
+
+        // Previous window
+        double lastWriters = 0.0;
+        double lastThroughput = 0.0;
+        int holdoff = 0;             // windows to wait before the next probe
+        int probe = 0;               // cap change being measured (-1, +1), 0 = none
+        int nextProbe = -1;          // direction of the next probe
+    };
+
+    Volume& volumeFor(const QString& outputPath);
+    qint64 freeBytes(Volume& v);
+    void removeRunning(Volume& v, const QString& outputPath);
+    void accumulate(Volume& v);
+    void sample(Volume& v);
+
+    static constexpr qint64 RefreshMs = 1000;
+    static constexpr qint64 WindowMs = 3000;
+
+    QHash<QString, QString> m_dirRoots;   // output folder → volume root
+    QHash<QString, Volume> m_volumes;
+    QElapsedTimer m_clock;
+    int m_poolSize = 1;
+    qint64 m_minFreeBytes = 0;
+    bool m_adaptiveWriters = true;
+};
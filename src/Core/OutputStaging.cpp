@@ -0,0 +1,122 @@
+#include "OutputStaging.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDebug>
+#include <filesystem>
+#include <system_error>
+
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+std::filesystem::path toFsPath(const QString& path) {
+    return std::filesystem::path(path.toStdU16String());
+}
+}
+
+QString OutputStaging::tempPathFor(const QString& outputPath) {
+    QFileInfo info(outputPath);
+    return info.dir().filePath(".ffabtmp_" + info.fileName());
+}
+
+// ========== STAGE ==========
+
+OutputStaging::Staged OutputStaging::stage(const QString& command,
+                                           const QStringList& outputPaths,
+                                           qint64 expectedBytes,
+                                           const QStringList& branchPaths) {
+    Staged staged;
+    staged.command = command;
+
+    const QStringList allPaths = outputPaths + branchPaths;
+    for (int i = 0; i < allPaths.size(); ++i) {
+        const QString& outputPath = allPaths[i];
+        const QString quoted = QString("\"%1\"").arg(outputPath);
+        if (outputPath.isEmpty() || !staged.command.contains(quoted)) continue;
+
+        const QString tempPath = tempPathFor(outputPath);
+
+        // Without -truncate 0 ffmpeg opens with O_TRUNC and drops the reservation
+        QString replacement = QString("\"%1\"").arg(tempPath);
+        if (i < outputPaths.size() && expectedBytes > 0 && preallocate(tempPath, expectedBytes)) {
+            replacement.prepend("-truncate 0 ");
+            staged.preallocated = true;
+        }
+
+        staged.command.replace(quoted, replacement);
+        staged.tempPaths.append(tempPath);
+        staged.finalPaths.append(outputPath);
+    }
+    return staged;
+}
+
+bool OutputStaging::preallocate(const QString& path, qint64 bytes) {
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+    // O_TRUNC: a leftover temp from an interrupted run must not leave its tail behind
+    int fd = ::open(QFile::encodeName(path).constData(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+#if defined(Q_OS_LINUX)
+    bool ok = ::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(bytes)) == 0;
+#else
+    fstore_t store = { F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, static_cast<off_t>(bytes), 0 };
+    bool ok = ::fcntl(fd, F_PREALLOCATE, &store) != -1;
+    if (!ok) {
+        store.fst_flags = F_ALLOCATEALL;
+        ok = ::fcntl(fd, F_PREALLOCATE, &store) != -1;
+    }
+#endif
+    ::close(fd);
+    return ok;
+#else
+    Q_UNUSED(path);
+    Q_UNUSED(bytes);
+    return false;
+#endif
+}
+
+// ========== COMMIT / DISCARD ==========
+
+bool OutputStaging::commit(const Staged& staged) {
+    bool ok = true;
+    for (int i = 0; i < staged.tempPaths.size(); ++i) {
+        if (!ok) {
+            QFile::remove(staged.tempPaths[i]);
+            continue;
+        }
+        if (staged.preallocated) releaseUnused(staged.tempPaths[i]);
+
+        // Same directory — rename(2) replaces an existing output atomically
+        std::error_code ec;
+        std::filesystem::rename(toFsPath(staged.tempPaths[i]), toFsPath(staged.finalPaths[i]), ec);
+        if (ec) {
+            qWarning() << "OutputStaging: Failed to rename" << staged.tempPaths[i]
+                       << "to" << staged.finalPaths[i] << "-" << QString::fromStdString(ec.message());
+            QFile::remove(staged.tempPaths[i]);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+void OutputStaging::discard(const Staged& staged) {
+    for (const auto& tempPath : staged.tempPaths) {
+        QFile::remove(tempPath);
+    }
+}
+
+void OutputStaging::releaseUnused(const QString& path) {
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+    // Truncating to the current length frees blocks reserved past EOF
+    const QByteArray name = QFile::encodeName(path);
+    const qint64 size = QFileInfo(path).size();
+    if (::truncate(name.constData(), static_cast<off_t>(size)) != 0) {
+        qWarning() << "OutputStaging: Could not release preallocated space of" << path;
+    }
+#else
+    Q_UNUSED(path);
+#endif
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * OutputStaging - Write-then-rename for batch outputs
+ *
+ * A job writes to a hidden temp name in its output folder
+ * (".ffabtmp_<name>", extension kept so ffmpeg still picks the muxer)
+ * and the file is renamed onto its real name only once ffmpeg succeeds.
+ * A cancelled, paused or failed job never leaves a truncated file under
+ * a name that skip-existing logic or the next Iterate pass would trust.
+ *
+ * Temp and final name share a directory, so the rename is atomic and
+ * replaces an existing output in one step.
+ *
+ * Preallocation (PCM outputs with a known size): the temp file's blocks
+ * are reserved up front without changing its length (Linux fallocate
+ * KEEP_SIZE, macOS F_PREALLOCATE), and ffmpeg is told not to truncate it
+ * on open. Unused reserved blocks are released at commit.
+ */
+class OutputStaging {
+public:
+    struct Staged {
+        QString command;          // outputs rewritten to their temp paths
+        QStringList tempPaths;    // parallel to the outputs passed in
+        QStringList finalPaths;
+        bool preallocated = false;
+    };
+
+    static QString tempPathFor(const QString& outputPath);
+
+    // Rewrite each quoted output path in the command to its temp path.
+    // Outputs not found in the command are left alone (and not staged).
+    // expectedBytes > 0 reserves that much per output; branchPaths (aux and
+    // image outputs) are staged the same way but never reserved.
+    static Staged stage(const QString& command,
+                        const QStringList& outputPaths,
+                        qint64 expectedBytes = 0,
+                        const QStringList& branchPaths = QStringList());
+
+    // Rename every temp file onto its final name. False if any rename failed
+    // (the remaining temp files are removed).
+    static bool commit(const Staged& staged);
+
+    // Remove the temp files of a job that did not succeed
+    static void discard(const Staged& staged);
+
+private:
+    static bool preallocate(const QString& path, qint64 bytes);
+    static void releaseUnused(const QString& path);
+};
@@ -140,6 +140,16 @@ void Preferences::setFilterPresetBarVisible(bool visible) {
     m_settings.setValue("view/filterPresetBar", visible);
 }
 
+// ========== Playback ==========
+
+bool Preferences::streamPreview() const {
+    return m_settings.value("playback/streamPreview", false).toBool();
+}
+
+void Preferences::setStreamPreview(bool enabled) {
+    m_settings.setValue("playback/streamPreview", enabled);
+}
+
 void Preferences::sync() {
     m_settings.sync();
 }
@@ -12,6 +12,7 @@
  * - Window geometry (MainWindow, CommandViewWindow)
  * - Last used directories for file browsers
  * - Recent presets list
+ * - Playback options (streaming preview)
  * 
  * Storage location:
  * - macOS: ~/Library/Preferences/com.disuye.FFAB.plist
@@ -70,6 +71,11 @@ public:
     bool filterPresetBarVisible() const;
     void setFilterPresetBarVisible(bool visible);
 
+    // ========== Playback ==========
+
+    bool streamPreview() const;
+    void setStreamPreview(bool enabled);
+
     // Force sync to disk
     void sync();
     
@@ -1,15 +1,22 @@
 #include "PreviewGenerator.h"
 #include "LogFileWriter.h"
 #include "FilterChain.h"
+#include "PreviewInputCache.h"
+#include "Filters/OutputFilter.h"
 #include <QProcess>
 #include <QDebug>
 #include <QFileInfo>
 #include <QDir>
 #include <QStandardPaths>
 #include <QSettings>
+#include <QFile>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QRegularExpression>
 
 PreviewGenerator::PreviewGenerator(QObject* parent)
-    : QObject(parent), audioProcess(nullptr), waveformProcess(nullptr)
+    : QObject(parent), m_inputCache(new PreviewInputCache(this))
+    , audioProcess(nullptr), waveformProcess(nullptr)
     , logWriter(new LogFileWriter(this))
 {
     connect(logWriter, &LogFileWriter::contentWritten, this, &PreviewGenerator::logContentWritten);
@@ -17,6 +24,12 @@ PreviewGenerator::PreviewGenerator(QObject* parent)
 
 PreviewGenerator::~PreviewGenerator() {
     cancel();
+    clearStageCache();
+}
+
+void PreviewGenerator::prefetch(const QStringList& sourceFiles, const QString& ffmpegPath) {
+    m_inputCache->setFFmpegPath(ffmpegPath);
+    m_inputCache->prefetch(sourceFiles);
 }
 
 void PreviewGenerator::generate(
@@ -77,53 +90,98 @@ void PreviewGenerator::generate(
         // Build FFmpeg command for audio processing
         emit progress(0, "Processing audio...");
 
-        audioProcess = new QProcess(this);
-        connect(audioProcess, &QProcess::finished,
-                this, &PreviewGenerator::onAudioProcessFinished);
-
-        // Capture stderr for logging (line-buffered to avoid split lines)
-        connect(audioProcess, &QProcess::readyReadStandardError, this, [this]() {
-            if (!audioProcess) return;
-            QByteArray rawData = audioProcess->readAllStandardError();
-            m_stderrBuffer += QString::fromUtf8(rawData);
-
-            int lastNewline = m_stderrBuffer.lastIndexOf('\n');
-            if (lastNewline < 0) return;  // No complete lines yet
-
-            QString completeLines = m_stderrBuffer.left(lastNewline + 1);
-            m_stderrBuffer = m_stderrBuffer.mid(lastNewline + 1);
-
-            accumulatedStderr += completeLines;
-            if (logWriter->isOpen()) {
-                logWriter->writeLines(currentInputFileName, completeLines);
-            }
-        });
-
         // ========== USE FILTERCHAIN AS SOURCE OF TRUTH ==========
         // Build preview command (aux outputs discarded to null muxer)
         // When preview logging is active, use user's log settings so analysis
         // filters produce output; otherwise use safe defaults (-loglevel error).
         auto logSettings = previewLoggingActive ? LogSettings::fromQSettings() : LogSettings();
-        QString command = filterChain->buildPreviewCommand(
-            sourceFile,
-            sidechainFiles,
-            tempAudioPath,
-            mutedPositions,
-            logSettings
-        );
 
-        // Parse command string to QStringList for QProcess
-        QStringList args = FilterChain::parseCommandToArgs(command);
+        // Read the pre-decoded PCM when the File List prefetch already has it
+        QString renderSource = m_inputCache->decodedPath(sourceFile);
+        if (renderSource.isEmpty()) renderSource = sourceFile;
+
+        m_pendingStages.clear();
+        m_stageCount = 0;
+        m_streamingActive = m_streamingEnabled;
+
+        // Streaming: the final stage writes float WAV to stdout
+        QString finalOutput = m_streamingActive ? QString("pipe:1") : tempAudioPath;
+        QString finalFlags = m_streamingActive ? streamOutputFlags(filterChain.get()) : QString();
+        int lastPos = static_cast<int>(filterChain->filterCount()) - 2;
+
+        // Stage caching is skipped while logging previews — cached stages
+        // would silently drop the analysis output of upstream filters.
+        QList<int> cutPoints = previewLoggingActive
+            ? QList<int>()
+            : filterChain->findPreviewCutPoints(mutedPositions);
+
+        if (cutPoints.isEmpty()) {
+            QString command = m_streamingActive
+                ? filterChain->buildPreviewStageCommand(
+                      renderSource, sidechainFiles, finalOutput,
+                      1, lastPos, mutedPositions, true, logSettings, finalFlags)
+                : filterChain->buildPreviewCommand(
+                      renderSource,
+                      sidechainFiles,
+                      tempAudioPath,
+                      mutedPositions,
+                      logSettings
+                  );
+            m_pendingStages.append({ FilterChain::parseCommandToArgs(command), QString(), tempAudioPath });
+        } else {
+            // Key prefix: anything outside the chain that changes stage content
+            QString keyBase = sourceFile + "|" +
+                QString::number(QFileInfo(sourceFile).lastModified().toMSecsSinceEpoch());
+            for (const QString& sc : sidechainFiles) {
+                keyBase += "|" + sc + "|" +
+                    QString::number(QFileInfo(sc).lastModified().toMSecsSinceEpoch());
+            }
+
+            QStringList signatures = filterChain->buildStageSignatures(mutedPositions);
+            auto stageKey = [&](int cutPos) {
+                QString material = keyBase + "\n" + signatures.mid(0, cutPos + 1).join("\n");
+                return QString::fromLatin1(
+                    QCryptographicHash::hash(material.toUtf8(), QCryptographicHash::Sha1).toHex());
+            };
+
+            // Resume from the deepest cut whose upstream is unchanged
+            int resumeIdx = -1;
+            QString stageInput = renderSource;
+            for (int c = cutPoints.size() - 1; c >= 0; --c) {
+                QString cached = findCachedStage(stageKey(cutPoints[c]));
+                if (!cached.isEmpty()) {
+                    resumeIdx = c;
+                    stageInput = cached;
+                    break;
+                }
+            }
+
+            int firstPos = resumeIdx >= 0 ? cutPoints[resumeIdx] + 1 : 1;
+            for (int c = resumeIdx + 1; c < cutPoints.size(); ++c) {
+                QString key = stageKey(cutPoints[c]);
+                QString stagePath = ffabTempDir + QString("/ffab_stage_%1.wav").arg(key.left(12));
+                QString command = filterChain->buildPreviewStageCommand(
+                    stageInput, sidechainFiles, stagePath,
+                    firstPos, cutPoints[c], mutedPositions, false, logSettings);
+                m_pendingStages.append({ FilterChain::parseCommandToArgs(command), key, stagePath });
+                stageInput = stagePath;
+                firstPos = cutPoints[c] + 1;
+            }
+
+            QString command = filterChain->buildPreviewStageCommand(
+                stageInput, sidechainFiles, finalOutput,
+                firstPos, lastPos, mutedPositions, true, logSettings, finalFlags);
+            m_pendingStages.append({ FilterChain::parseCommandToArgs(command), QString(), tempAudioPath });
+        }
 
         qDebug() << "=== PREVIEW GENERATION DEBUG ===";
         qDebug() << "Muted positions:" << mutedPositions;
         qDebug() << "Sidechain files:" << sidechainFiles;
-        qDebug() << "Full FFmpeg command:" << ffmpegPath << args.join(" ");
         qDebug() << "================================";
 
-        audioProcess->start(ffmpegPath, args);
-
+        m_stageCount = m_pendingStages.size();
         audioFileForPlayback = tempAudioPath;
+        startNextStage();
 
     } else {
         // No processing needed - generate waveform directly from source
@@ -134,6 +192,60 @@ void PreviewGenerator::generate(
     }
 }
 
+void PreviewGenerator::startNextStage() {
+    PendingStage stage = m_pendingStages.takeFirst();
+    m_runningStageKey = stage.cacheKey;
+    m_runningStagePath = stage.outputPath;
+
+    int stageNumber = m_stageCount - m_pendingStages.size();
+    if (m_stageCount > 1) {
+        emit progress((stageNumber - 1) * 50 / m_stageCount,
+                      QString("Processing audio (stage %1/%2)...").arg(stageNumber).arg(m_stageCount));
+    }
+
+    audioProcess = new QProcess(this);
+    connect(audioProcess, &QProcess::finished,
+            this, &PreviewGenerator::onAudioProcessFinished);
+
+    // Capture stderr for logging (line-buffered to avoid split lines)
+    connect(audioProcess, &QProcess::readyReadStandardError, this, [this]() {
+        if (!audioProcess) return;
+        QByteArray rawData = audioProcess->readAllStandardError();
+        m_stderrBuffer += QString::fromUtf8(rawData);
+
+        int lastNewline = m_stderrBuffer.lastIndexOf('\n');
+        if (lastNewline < 0) return;  // No complete lines yet
+
+        QString completeLines = m_stderrBuffer.left(lastNewline + 1);
+        m_stderrBuffer = m_stderrBuffer.mid(lastNewline + 1);
+
+        accumulatedStderr += completeLines;
+        if (logWriter->isOpen()) {
+            logWriter->writeLines(currentInputFileName, completeLines);
+        }
+    });
+
+    // Final stage of a streaming preview: tee stdout PCM into the temp WAV.
+    // streamStarted follows once ffmpeg's header says what it renders.
+    if (m_pendingStages.isEmpty() && m_streamingActive) {
+        m_streamFile = new QFile(stage.outputPath);
+        if (!m_streamFile->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qWarning() << "Failed to open streaming preview file:" << stage.outputPath;
+        }
+        m_streamHeader.clear();
+        m_streamSampleRate = 0;
+        m_streamChannels = 0;
+        m_streamBytes = 0;
+
+        connect(audioProcess, &QProcess::readyReadStandardOutput,
+                this, &PreviewGenerator::readStreamOutput);
+    }
+
+    qDebug() << "Full FFmpeg command:" << ffmpegPath << stage.args.join(" ");
+
+    audioProcess->start(ffmpegPath, stage.args);
+}
+
 void PreviewGenerator::onAudioProcessFinished(int exitCode, QProcess::ExitStatus exitStatus) {
     if (!audioProcess) return;  // Safety check
 
@@ -148,14 +260,31 @@ void PreviewGenerator::onAudioProcessFinished(int exitCode, QProcess::ExitStatus
         m_stderrBuffer.clear();
     }
 
+    if (m_streamFile) {
+        readStreamOutput();
+        finishStreamFile();
+    }
+
     if (exitCode != 0) {
         QString errorMsg = accumulatedStderr;
         accumulatedStderr.clear();
         qWarning() << "Audio processing failed:" << errorMsg;
         logWriter->close();
         emit error("Failed to process audio: " + errorMsg);
+        m_pendingStages.clear();
+        audioProcess->deleteLater();
+        audioProcess = nullptr;
+        return;
+    }
+
+    // Intermediate stage done — remember it and run the next one
+    if (!m_pendingStages.isEmpty()) {
+        if (!m_runningStageKey.isEmpty()) {
+            storeCachedStage(m_runningStageKey, m_runningStagePath);
+        }
         audioProcess->deleteLater();
         audioProcess = nullptr;
+        startNextStage();
         return;
     }
 
@@ -248,8 +377,160 @@ bool PreviewGenerator::needsProcessing(
     return false;
 }
 
+void PreviewGenerator::readStreamOutput() {
+    if (!audioProcess) return;
+    QByteArray chunk = audioProcess->readAllStandardOutput();
+    if (chunk.isEmpty()) return;
+
+    if (m_streamSampleRate == 0) {
+        m_streamHeader += chunk;
+        int dataOffset = 0;
+        if (!parseWavHeader(m_streamHeader, &m_streamSampleRate, &m_streamChannels, &dataOffset)) return;
+
+        chunk = m_streamHeader.mid(dataOffset);
+        m_streamHeader.clear();
+        if (m_streamFile && m_streamFile->isOpen()) {
+            writeFloatWavHeader(m_streamFile, 0, m_streamSampleRate, m_streamChannels);
+        }
+        emit streamStarted(m_streamSampleRate, m_streamChannels, m_streamFile->fileName());
+        if (chunk.isEmpty()) return;
+    }
+
+    // Flushed before streamData so a player can read back what it didn't buffer
+    if (m_streamFile && m_streamFile->isOpen()) {
+        m_streamFile->write(chunk);
+        m_streamFile->flush();
+    }
+    m_streamBytes += chunk.size();
+    emit streamData(chunk);
+}
+
+QString PreviewGenerator::streamOutputFlags(const FilterChain* filterChain) {
+    // Float WAV at the OUTPUT filter's rate and channel count. The header
+    // tells the player what arrived, so chains that set neither stream as-is.
+    QString flags = "-c:a pcm_f32le";
+    auto* outputFilter = dynamic_cast<OutputFilter*>(
+        filterChain->getFilter(filterChain->filterCount() - 1).get());
+    if (outputFilter) {
+        static const QRegularExpression formatRe("(?:^|\\s)(-a[rc])\\s+(\\d+)");
+        auto it = formatRe.globalMatch(outputFilter->buildFFmpegFlags());
+        while (it.hasNext()) {
+            auto match = it.next();
+            flags += QString(" %1 %2").arg(match.captured(1), match.captured(2));
+        }
+    }
+    return flags + " -f wav";
+}
+
+bool PreviewGenerator::parseWavHeader(const QByteArray& data, int* sampleRate, int* channels, int* dataOffset) {
+    auto le16 = [&data](int pos) {
+        return quint16(uchar(data[pos])) | quint16(uchar(data[pos + 1])) << 8;
+    };
+    auto le32 = [&data](int pos) {
+        return quint32(uchar(data[pos])) | quint32(uchar(data[pos + 1])) << 8 |
+               quint32(uchar(data[pos + 2])) << 16 | quint32(uchar(data[pos + 3])) << 24;
+    };
+
+    if (data.size() < 12 || !data.startsWith("RIFF") || data.mid(8, 4) != "WAVE") return false;
+
+    // Walk chunks up to "data"; a piped header has no usable sizes there
+    int pos = 12;
+    int rate = 0, channelCount = 0;
+    while (pos + 8 <= data.size()) {
+        const QByteArray id = data.mid(pos, 4);
+        const quint32 size = le32(pos + 4);
+        if (id == "data") {
+            if (rate <= 0 || channelCount <= 0) return false;
+            *sampleRate = rate;
+            *channels = channelCount;
+            *dataOffset = pos + 8;
+            return true;
+        }
+        if (id == "fmt ") {
+            if (pos + 8 + 16 > data.size()) return false;
+            channelCount = le16(pos + 10);
+            rate = static_cast<int>(le32(pos + 12));
+        }
+        pos += 8 + static_cast<int>(size) + (size & 1);
+    }
+    return false;
+}
+
+void PreviewGenerator::finishStreamFile() {
+    if (!m_streamFile) return;
+    if (m_streamFile->isOpen()) {
+        if (m_streamSampleRate > 0) {   // no header yet = nothing rendered
+            m_streamFile->seek(0);
+            writeFloatWavHeader(m_streamFile, m_streamBytes, m_streamSampleRate, m_streamChannels);
+        }
+        m_streamFile->close();
+    }
+    delete m_streamFile;
+    m_streamFile = nullptr;
+}
+
+void PreviewGenerator::writeFloatWavHeader(QIODevice* device, qint64 dataBytes, int sampleRate, int channels) {
+    auto put32 = [device](quint32 v) {
+        char b[4] = { char(v & 0xFF), char((v >> 8) & 0xFF), char((v >> 16) & 0xFF), char((v >> 24) & 0xFF) };
+        device->write(b, 4);
+    };
+    auto put16 = [device](quint16 v) {
+        char b[2] = { char(v & 0xFF), char((v >> 8) & 0xFF) };
+        device->write(b, 2);
+    };
+
+    const quint16 bitsPerSample = 32;
+    const quint16 blockAlign = channels * bitsPerSample / 8;
+    const quint32 dataSize = static_cast<quint32>(qMin<qint64>(dataBytes, 0xFFFFFFFF - 36));
+
+    device->write("RIFF", 4);
+    put32(36 + dataSize);
+    device->write("WAVE", 4);
+    device->write("fmt ", 4);
+    put32(16);
+    put16(3);  // WAVE_FORMAT_IEEE_FLOAT
+    put16(static_cast<quint16>(channels));
+    put32(static_cast<quint32>(sampleRate));
+    put32(static_cast<quint32>(sampleRate) * blockAlign);
+    put16(blockAlign);
+    put16(bitsPerSample);
+    device->write("data", 4);
+    put32(dataSize);
+}
+
+QString PreviewGenerator::findCachedStage(const QString& key) const {
+    for (const auto& entry : m_stageCache) {
+        if (entry.key == key && QFileInfo::exists(entry.path)) {
+            return entry.path;
+        }
+    }
+    return QString();
+}
+
+void PreviewGenerator::storeCachedStage(const QString& key, const QString& path) {
+    for (int i = 0; i < m_stageCache.size(); ++i) {
+        if (m_stageCache[i].key == key) {
+            m_stageCache.removeAt(i);
+            break;
+        }
+    }
+    m_stageCache.prepend({ key, path });
+
+    while (m_stageCache.size() > kStageCacheSlots) {
+        QFile::remove(m_stageCache.takeLast().path);
+    }
+}
+
+void PreviewGenerator::clearStageCache() {
+    for (const auto& entry : m_stageCache) {
+        QFile::remove(entry.path);
+    }
+    m_stageCache.clear();
+}
+
 void PreviewGenerator::cancel() {
     logWriter->close();
+    m_pendingStages.clear();
 
     if (audioProcess) {
         disconnect(audioProcess, nullptr, this, nullptr);  // Prevent finished/readyRead from firing during waitForFinished
@@ -259,6 +540,9 @@ void PreviewGenerator::cancel() {
         audioProcess = nullptr;
     }
 
+    finishStreamFile();
+    m_streamingActive = false;
+
     if (waveformProcess) {
         disconnect(waveformProcess, nullptr, this, nullptr);
         waveformProcess->kill();
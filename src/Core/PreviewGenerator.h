@@ -4,10 +4,14 @@
 #include <QObject>
 #include <QString>
 #include <QProcess>
+#include <QStringList>
 #include <memory>
 
 class FilterChain;
 class LogFileWriter;
+class PreviewInputCache;
+class QFile;
+class QIODevice;
 
 class PreviewGenerator : public QObject {
     Q_OBJECT
@@ -31,6 +35,20 @@ public:
     );
     
     void cancel();
+
+    // Decode upcoming preview sources in the background (e.g. the highlighted
+    // File List row and the one after it) so the next generate() skips decoding
+    void prefetch(const QStringList& sourceFiles, const QString& ffmpegPath);
+
+    // Streaming preview: the final stage writes float WAV to stdout so playback
+    // can begin after a short buffer instead of after the full render. Rate and
+    // channel count follow the OUTPUT filter (or the chain when it sets none).
+    // The PCM is written to the temp WAV as it arrives, so finished() still
+    // delivers a file and a player can read back what it didn't buffer.
+    void setStreamingEnabled(bool enabled) { m_streamingEnabled = enabled; }
+    bool isStreamingEnabled() const { return m_streamingEnabled; }
+
+    static constexpr int kStreamDataOffset = 44;   // PCM start in the streamed temp WAV
     
 signals:
     void started();
@@ -40,6 +58,11 @@ signals:
     void logFileCreated(const QString& filePath);
     void logContentWritten();
 
+    // Streaming preview (only emitted when streaming is enabled). pcmFile is
+    // the temp WAV being written; streamData bytes land at kStreamDataOffset on.
+    void streamStarted(int sampleRate, int channels, const QString& pcmFile);
+    void streamData(const QByteArray& pcm);
+
 private slots:
     void onAudioProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
     void onWaveformProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
@@ -54,6 +77,50 @@ private:
     );
     
     void generateWaveform(const QString& audioFile);
+
+    // ========== Stage cache ==========
+    // Chains with expensive filters (AFIR, Rubberband, AFFTDN) are rendered in
+    // stages split after those filters. Each intermediate stage is kept as a
+    // float WAV keyed by everything upstream of it, so editing a later filter
+    // only re-runs the stages after the last unchanged cut.
+    struct StageCacheEntry {
+        QString key;   // hash of source + sidechains + upstream stage signatures
+        QString path;  // cached stage WAV
+    };
+
+    struct PendingStage {
+        QStringList args;
+        QString cacheKey;   // empty for the final stage
+        QString outputPath;
+    };
+
+    void startNextStage();
+
+    // Streaming output: PCM from stdout is appended to a float WAV whose
+    // header sizes are patched once the process exits.
+    void readStreamOutput();
+    void finishStreamFile();
+    static QString streamOutputFlags(const FilterChain* filterChain);
+    static bool parseWavHeader(const QByteArray& data, int* sampleRate, int* channels, int* dataOffset);
+    static void writeFloatWavHeader(QIODevice* device, qint64 dataBytes, int sampleRate, int channels);
+    QString findCachedStage(const QString& key) const;
+    void storeCachedStage(const QString& key, const QString& path);
+    void clearStageCache();
+
+    static constexpr int kStageCacheSlots = 6;
+    QList<StageCacheEntry> m_stageCache;   // Most recently used first
+    QList<PendingStage> m_pendingStages;
+    QString m_runningStageKey;
+    QString m_runningStagePath;
+    int m_stageCount = 0;
+
+    bool m_streamingEnabled = false;
+    bool m_streamingActive = false;    // Current generation streams its final stage
+    QFile* m_streamFile = nullptr;
+    QByteArray m_streamHeader;         // ffmpeg's WAV header until its data chunk starts
+    int m_streamSampleRate = 0;        // 0 until the header has been parsed
+    int m_streamChannels = 0;
+    qint64 m_streamBytes = 0;
     
     static constexpr int kTempSlots = 3;  // Rotating buffer — never overwrite the playing file
     int m_tempSlot = 0;
@@ -65,6 +132,7 @@ private:
     QString audioFileForPlayback;
     QString waveformSize;
     
+    PreviewInputCache* m_inputCache;
     QProcess* audioProcess;
     QProcess* waveformProcess;
     LogFileWriter* logWriter;
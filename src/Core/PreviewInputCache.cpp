@@ -0,0 +1,132 @@
+#include "PreviewInputCache.h"
+#include <QProcess>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QDebug>
+
+PreviewInputCache::PreviewInputCache(QObject* parent)
+    : QObject(parent)
+{
+}
+
+PreviewInputCache::~PreviewInputCache() {
+    clear();
+}
+
+void PreviewInputCache::prefetch(const QStringList& sourceFiles) {
+    // Newest request wins — whatever the user moved away from is dropped
+    m_queue.clear();
+    for (const QString& source : sourceFiles) {
+        if (!isWorthDecoding(source)) continue;
+        QString key = cacheKey(source);
+        if (key == m_runningKey) continue;
+        if (!decodedPath(source).isEmpty()) continue;
+        m_queue.append(source);
+    }
+
+    if (!m_process) {
+        startNext();
+    }
+}
+
+QString PreviewInputCache::decodedPath(const QString& sourceFile) {
+    QString key = cacheKey(sourceFile);
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].key != key) continue;
+        if (!QFileInfo::exists(m_entries[i].path)) return QString();
+        if (i > 0) m_entries.move(i, 0);  // LRU: a hit moves to the front
+        return m_entries.first().path;
+    }
+    return QString();
+}
+
+void PreviewInputCache::clear() {
+    m_queue.clear();
+
+    if (m_process) {
+        disconnect(m_process, nullptr, this, nullptr);
+        m_process->kill();
+        m_process->waitForFinished(1000);
+        delete m_process;
+        m_process = nullptr;
+        QFile::remove(m_runningPath + ".part");
+    }
+    m_runningKey.clear();
+    m_runningPath.clear();
+
+    for (const auto& entry : m_entries) {
+        QFile::remove(entry.path);
+    }
+    m_entries.clear();
+}
+
+void PreviewInputCache::startNext() {
+    if (m_queue.isEmpty() || m_ffmpegPath.isEmpty()) return;
+
+    QString source = m_queue.takeFirst();
+    QString ffabTempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/FFAB";
+    QDir().mkpath(ffabTempDir);
+
+    m_runningKey = cacheKey(source);
+    m_runningPath = ffabTempDir + QString("/ffab_decoded_%1.wav").arg(m_runningKey.left(12));
+
+    QStringList args;
+    args << "-y" << "-hide_banner" << "-loglevel" << "error"
+         << "-i" << source
+         << "-map" << "0:a:0"
+         << "-c:a" << "pcm_f32le"
+         << "-f" << "wav"
+         << m_runningPath + ".part";
+
+    m_process = new QProcess(this);
+    connect(m_process, &QProcess::finished, this, [this](int exitCode, QProcess::ExitStatus) {
+        onDecodeFinished(exitCode);
+    });
+    m_process->start(m_ffmpegPath, args);
+}
+
+void PreviewInputCache::onDecodeFinished(int exitCode) {
+    QString partPath = m_runningPath + ".part";
+
+    if (exitCode == 0) {
+        QFile::remove(m_runningPath);
+        if (QFile::rename(partPath, m_runningPath)) {
+            m_entries.prepend({ m_runningKey, m_runningPath });
+            while (m_entries.size() > kMaxEntries) {
+                QFile::remove(m_entries.takeLast().path);
+            }
+        }
+    } else {
+        qWarning() << "Preview pre-decode failed:" << m_process->readAllStandardError();
+        QFile::remove(partPath);
+    }
+
+    m_process->deleteLater();
+    m_process = nullptr;
+    m_runningKey.clear();
+    m_runningPath.clear();
+
+    startNext();
+}
+
+bool PreviewInputCache::isWorthDecoding(const QString& sourceFile) const {
+    QFileInfo info(sourceFile);
+    if (!info.exists() || info.size() > kMaxSourceBytes) return false;
+
+    // Already PCM — reading it directly is as fast as reading a decode
+    static const QStringList uncompressed = { "wav", "wave", "aif", "aiff", "w64", "caf" };
+    return !uncompressed.contains(info.suffix().toLower());
+}
+
+QString PreviewInputCache::cacheKey(const QString& sourceFile) {
+    QFileInfo info(sourceFile);
+    QString material = info.absoluteFilePath() + "|" +
+                       QString::number(info.size()) + "|" +
+                       QString::number(info.lastModified().toMSecsSinceEpoch());
+    return QString::fromLatin1(
+        QCryptographicHash::hash(material.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
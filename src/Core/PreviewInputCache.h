@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+class QProcess;
+
+/**
+ * PreviewInputCache - Background pre-decode of preview source files
+ *
+ * For short samples, preview latency is dominated by ffmpeg startup plus
+ * demuxing/decoding compressed input. Files highlighted in the File List
+ * (and the rows just after them) are decoded ahead of time to 32-bit float
+ * WAV in the FFAB temp folder, so a preview render only pays for filtergraph
+ * construction and reading hot PCM from the page cache.
+ *
+ *   - One decode at a time; the newest prefetch request replaces the queue
+ *   - Entries keyed on path + size + mtime, so edited sources are re-decoded
+ *   - LRU eviction deletes the decoded file
+ *   - Uncompressed sources (WAV/AIFF) and very large files are used as-is
+ *   - Decodes land in a .part file and are renamed on success, so a
+ *     half-written file is never handed to the preview
+ */
+class PreviewInputCache : public QObject {
+    Q_OBJECT
+
+public:
+    explicit PreviewInputCache(QObject* parent = nullptr);
+    ~PreviewInputCache() override;
+
+    void setFFmpegPath(const QString& path) { m_ffmpegPath = path; }
+
+    // Queue sources for decoding (first = highest priority).
+    // Already-cached and in-flight sources are skipped.
+    void prefetch(const QStringList& sourceFiles);
+
+    // Decoded WAV for sourceFile, or empty if not (yet) available.
+    // A hit makes the entry the most recently used.
+    QString decodedPath(const QString& sourceFile);
+
+    // Stop decoding and delete all decoded files
+    void clear();
+
+private:
+    void startNext();
+    void onDecodeFinished(int exitCode);
+    bool isWorthDecoding(const QString& sourceFile) const;
+    static QString cacheKey(const QString& sourceFile);
+
+    struct Entry {
+        QString key;
+        QString path;
+    };
+
+    static constexpr int kMaxEntries = 8;
+    static constexpr qint64 kMaxSourceBytes = 256LL * 1024 * 1024;
+
+    QList<Entry> m_entries;      // Most recently used first
+    QStringList m_queue;         // Sources waiting to be decoded
+    QProcess* m_process = nullptr;
+    QString m_runningKey;
+    QString m_runningPath;
+    QString m_ffmpegPath;
+};
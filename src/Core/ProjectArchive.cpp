@@ -0,0 +1,221 @@
+#include "ProjectArchive.h"
+#include <QSaveFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QStringList>
+#include <QVector>
+#include <QDebug>
+
+namespace {
+constexpr QDataStream::Version StreamVersion = QDataStream::Qt_6_0;
+}
+
+bool ProjectArchive::isArchive(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    stream >> magic;
+    return stream.status() == QDataStream::Ok && magic == Magic;
+}
+
+// ========== WRITE ==========
+
+bool ProjectArchive::write(const QString& filePath,
+                           const QJsonObject& document,
+                           const QList<FileListBlock>& fileLists) {
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "ProjectArchive: Failed to open" << filePath;
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(StreamVersion);
+    stream << Magic << FormatVersion;
+    stream << qCompress(QJsonDocument(document).toJson(QJsonDocument::Compact));
+
+    stream << quint32(fileLists.size());
+    for (const auto& list : fileLists) {
+        stream << list.key << quint32(list.entries.size()) << packColumns(list.entries);
+    }
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        qWarning() << "ProjectArchive: Failed to write" << filePath;
+        return false;
+    }
+    return true;
+}
+
+QByteArray ProjectArchive::packColumns(const QList<QJsonObject>& entries) {
+    // Column-major so similar values sit together — shared path prefixes
+    // and repeated formats/rates compress far better than row records
+    QStringList paths, formats, durations;
+    QByteArray enabled, probed;
+    QVector<qint32> sampleRates, bitsPerSample, channels, bitrates;
+    QVector<qint64> sizes, mtimes;
+
+    for (const auto& entry : entries) {
+        paths.append(entry["path"].toString());
+        enabled.append(entry["enabled"].toBool() ? char(1) : char(0));
+
+        bool hasMetadata = entry.contains("sample_rate");
+        probed.append(hasMetadata ? char(1) : char(0));
+        if (!hasMetadata) continue;
+
+        formats.append(entry["format"].toString());
+        durations.append(entry["duration"].toString());
+        sampleRates.append(entry["sample_rate"].toInt());
+        bitsPerSample.append(entry["bits_per_sample"].toInt());
+        channels.append(entry["channels"].toInt());
+        bitrates.append(entry["bitrate"].toInt());
+        sizes.append(entry["size"].toInteger());
+        mtimes.append(entry["mtime"].toInteger());
+    }
+
+    QByteArray raw;
+    QDataStream stream(&raw, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+    stream << paths << enabled << probed
+           << formats << durations
+           << sampleRates << bitsPerSample << channels << bitrates
+           << sizes << mtimes;
+    return qCompress(raw);
+}
+
+// ========== READ ==========
+
+bool ProjectArchive::unpackColumns(const QByteArray& packed, int rowCount, QList<QJsonObject>* entries) {
+    QByteArray raw = qUncompress(packed);
+    QDataStream stream(raw);
+    stream.setVersion(StreamVersion);
+
+    QStringList paths, formats, durations;
+    QByteArray enabled, probed;
+    QVector<qint32> sampleRates, bitsPerSample, channels, bitrates;
+    QVector<qint64> sizes, mtimes;
+    stream >> paths >> enabled >> probed
+           >> formats >> durations
+           >> sampleRates >> bitsPerSample >> channels >> bitrates
+           >> sizes >> mtimes;
+
+    const qsizetype probedCount = probed.count(char(1));
+    if (stream.status() != QDataStream::Ok
+        || paths.size() != rowCount || enabled.size() != rowCount || probed.size() != rowCount
+        || formats.size() != probedCount || durations.size() != probedCount
+        || sampleRates.size() != probedCount || bitsPerSample.size() != probedCount
+        || channels.size() != probedCount || bitrates.size() != probedCount
+        || sizes.size() != probedCount || mtimes.size() != probedCount) {
+        return false;
+    }
+
+    entries->clear();
+    entries->reserve(rowCount);
+    int m = 0;  // metadata column index (probed rows only)
+    for (int i = 0; i < rowCount; ++i) {
+        QJsonObject entry;
+        entry["path"] = paths[i];
+        entry["enabled"] = enabled[i] != 0;
+        if (probed[i]) {
+            entry["format"] = formats[m];
+            entry["duration"] = durations[m];
+            entry["sample_rate"] = sampleRates[m];
+            entry["bits_per_sample"] = bitsPerSample[m];
+            entry["channels"] = channels[m];
+            entry["bitrate"] = bitrates[m];
+            entry["size"] = sizes[m];
+            entry["mtime"] = mtimes[m];
+            ++m;
+        }
+        entries->append(entry);
+    }
+    return true;
+}
+
+bool ProjectArchive::Reader::open(const QString& filePath) {
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = "Cannot open " + filePath;
+        return false;
+    }
+
+    m_stream.setDevice(&m_file);
+    m_stream.setVersion(StreamVersion);
+
+    quint32 magic = 0, version = 0;
+    m_stream >> magic >> version;
+    if (m_stream.status() != QDataStream::Ok || magic != Magic) {
+        m_error = "Not an FFAB project archive";
+        return false;
+    }
+    if (version > FormatVersion) {
+        m_error = QString("Archive format %1 is newer than supported (%2)").arg(version).arg(FormatVersion);
+        return false;
+    }
+
+    QByteArray compressed;
+    quint32 listCount = 0;
+    m_stream >> compressed >> listCount;
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(qUncompress(compressed), &parseError);
+    if (m_stream.status() != QDataStream::Ok || !doc.isObject()) {
+        m_error = "Corrupt preset document: " + parseError.errorString();
+        return false;
+    }
+
+    m_document = doc.object();
+    m_listCount = static_cast<int>(listCount);
+    m_listsRead = 0;
+    return true;
+}
+
+bool ProjectArchive::Reader::readNext(FileListBlock* block) {
+    if (!hasNext()) return false;
+
+    quint32 rowCount = 0;
+    QByteArray packed;
+    m_stream >> block->key >> rowCount >> packed;
+    ++m_listsRead;
+
+    if (m_stream.status() != QDataStream::Ok
+        || !unpackColumns(packed, static_cast<int>(rowCount), &block->entries)) {
+        m_error = "Corrupt file list block";
+        m_listsRead = m_listCount;  // stream position is lost — stop here
+        return false;
+    }
+    return true;
+}
+
+bool ProjectArchive::readAsJson(const QString& filePath, QJsonObject* preset, QString* error) {
+    Reader reader;
+    if (!reader.open(filePath)) {
+        if (error) *error = reader.errorString();
+        return false;
+    }
+
+    QJsonObject root = reader.document();
+    QJsonObject fileLists = root["file_lists"].toObject();
+    QJsonObject audioInputs;
+
+    FileListBlock block;
+    while (reader.hasNext()) {
+        if (!reader.readNext(&block)) {
+            if (error) *error = reader.errorString();
+            return false;
+        }
+        QJsonArray array;
+        for (const auto& entry : block.entries) array.append(entry);
+
+        if (block.key == "main") fileLists["main_files"] = array;
+        else audioInputs[block.key] = array;
+    }
+
+    if (!fileLists.isEmpty()) {
+        fileLists["audio_inputs"] = audioInputs;
+        root["file_lists"] = fileLists;
+    }
+    *preset = root;
+    return true;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QString>
+#include <QList>
+#include <QJsonObject>
+#include <QFile>
+#include <QDataStream>
+
+/**
+ * ProjectArchive - Compact binary container for large presets (.ffabproj)
+ *
+ * Same content as a .ffabjson preset, laid out for sessions with very large
+ * file lists:
+ *
+ *   "FFAB" magic, format version
+ *   preset document   — the usual preset JSON minus the file list entries,
+ *                       compact and qCompress'd
+ *   list count
+ *   per file list:      key ("main" or AudioInput index), row count, and one
+ *                       qCompress'd block holding the entries column by
+ *                       column (paths, enabled flags, formats, ..., mtimes)
+ *
+ * The document comes first so a reader can rebuild the chain before any
+ * file list is decoded; lists are then read one block at a time. Entry
+ * objects use the AudioFileScanner::toPresetEntry layout, so both formats
+ * share the load path.
+ */
+class ProjectArchive {
+public:
+    static constexpr quint32 Magic = 0x46464142;  // "FFAB"
+    static constexpr quint32 FormatVersion = 1;
+
+    static QString fileExtension() { return "ffabproj"; }
+
+    struct FileListBlock {
+        QString key;                   // "main" or QString::number(inputIndex)
+        QList<QJsonObject> entries;
+    };
+
+    // True if the file starts with the archive magic (extension is not checked)
+    static bool isArchive(const QString& filePath);
+
+    // Atomic write (QSaveFile)
+    static bool write(const QString& filePath,
+                      const QJsonObject& document,
+                      const QList<FileListBlock>& fileLists);
+
+    // Whole archive as the equivalent .ffabjson object (ffab-cli)
+    static bool readAsJson(const QString& filePath, QJsonObject* preset, QString* error = nullptr);
+
+    /**
+     * Reader - Streaming load: document() is available right after open(),
+     * file lists follow one readNext() at a time
+     */
+    class Reader {
+    public:
+        bool open(const QString& filePath);
+        QString errorString() const { return m_error; }
+
+        QJsonObject document() const { return m_document; }
+        int fileListCount() const { return m_listCount; }
+
+        bool hasNext() const { return m_listsRead < m_listCount; }
+        bool readNext(FileListBlock* block);
+
+    private:
+        QFile m_file;
+        QDataStream m_stream;
+        QJsonObject m_document;
+        int m_listCount = 0;
+        int m_listsRead = 0;
+        QString m_error;
+    };
+
+private:
+    static QByteArray packColumns(const QList<QJsonObject>& entries);
+    static bool unpackColumns(const QByteArray& packed, int rowCount, QList<QJsonObject>* entries);
+};
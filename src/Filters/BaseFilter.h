@@ -8,6 +8,8 @@
 #include <QJsonObject>
 #include "Core/Port.h"
 
+struct FilterTypeInfo;
+
 /**
  * FFAB Filter Naming Conventions:
  * 
@@ -83,6 +85,11 @@ public:
     // Command builder will prepend mainChainInput but NOT all sidechain inputs
     virtual bool handlesOwnInputRouting() const { return false; }
 
+    // FilterRegistry entry this filter was created from — nullptr for
+    // filters constructed directly (e.g. Iterate's gain stage)
+    const FilterTypeInfo* typeInfo() const { return m_typeInfo; }
+    void setTypeInfo(const FilterTypeInfo* info) { m_typeInfo = info; }
+
     // DAG port declarations — override in filters with non-standard topology
     // Default: 1 main audio input, 1 main audio output (simple 1→1 filter)
     virtual std::vector<DAG::PortDescriptor> inputPorts() const {
@@ -98,4 +105,5 @@ protected:
     bool m_useCustomOutputStream = false;  // false = normal chain, true = branch to custom stream
     bool m_effectivelyMuted = false;       // stamped before each build by FilterChainWidget
     QString m_loadedPresetName; // filter preset name persistence in UI
+    const FilterTypeInfo* m_typeInfo = nullptr;  // stamped by FilterRegistry::create
 };
\ No newline at end of file
@@ -410,6 +410,40 @@ QString OutputFilter::getFileExtension() const {
     return "wav";
 }
 
+int OutputFilter::pcmBitsPerSample() const {
+    if (m_category != Category::Uncompressed || m_videoPassthrough) return 0;
+    
+    switch (m_bitDepth) {
+        case BitDepth::Float32: return 32;
+        case BitDepth::Int24:   return 24;
+        case BitDepth::Int16:   return 16;
+        case BitDepth::Int8:    return 8;
+    }
+    return 0;
+}
+
+QString OutputFilter::passFormatFilter() const {
+    switch (m_category) {
+        case Category::Uncompressed: {
+            // 24-bit travels as s32; the encoder drops the low byte on write
+            QString sampleFormat;
+            switch (m_bitDepth) {
+                case BitDepth::Float32: sampleFormat = "flt"; break;
+                case BitDepth::Int24:   sampleFormat = "s32"; break;
+                case BitDepth::Int16:   sampleFormat = "s16"; break;
+                case BitDepth::Int8:    sampleFormat = "u8";  break;
+            }
+            return QString("aformat=sample_fmts=%1:sample_rates=%2").arg(sampleFormat).arg(m_sampleRate);
+        }
+        case Category::Lossless:
+            return "aformat=sample_fmts=s32";   // what the FLAC encoder negotiates from float
+        case Category::Compressed:
+        case Category::Advanced:
+            break;
+    }
+    return QString();
+}
+
 void OutputFilter::setVideoPassthrough(bool enabled) {
     if (m_videoPassthrough == enabled) return;
     m_videoPassthrough = enabled;
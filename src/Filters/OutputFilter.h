@@ -35,6 +35,8 @@ public:
     enum class LosslessFormat { FLAC = 0 };
     enum class CompressedFormat { MP3 = 0, AAC };
 
+    Category getCategory() const { return m_category; }
+
     QString getOutputFolder() const { return m_outputFolder; }
     void setOutputFolder(const QString& folder) { m_outputFolder = folder; }
     QString getFilenameSuffix() const { return m_filenameSuffix; }
@@ -43,6 +45,16 @@ public:
     // Get the file extension for this output (wav, flac, mp3, etc.)
     QString getFileExtension() const;
     
+    // Output sample rate in Hz
+    int getSampleRate() const { return m_sampleRate; }
+    // Bits per sample of uncompressed output; 0 when the output isn't plain PCM
+    int pcmBitsPerSample() const;
+
+    // aformat matching what a file written in this format reads back as, for
+    // chaining passes inside one filtergraph. Empty when a filtergraph can't
+    // reproduce it (lossy codecs, custom flags).
+    QString passFormatFilter() const;
+    
     // Video passthrough — copy video/subtitle streams through untouched
     bool isVideoPassthrough() const { return m_videoPassthrough; }
     void setVideoPassthrough(bool enabled);
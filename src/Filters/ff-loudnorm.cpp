@@ -1,4 +1,5 @@
 #include "ff-loudnorm.h"
+#include "Core/LoudnormMeasurement.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QSlider>
@@ -164,6 +165,13 @@ QWidget* FFLoudnorm::getParametersWidget() {
     linearHint->setStyleSheet("color: gray; font-size: 11px;");
     linearLayout->addWidget(linearCheck);
     linearLayout->addWidget(linearHint);
+
+    twoPassCheck = new QCheckBox("Automatic two-pass (batch)");
+    twoPassCheck->setChecked(m_twoPass);
+    auto twoPassHint = new QLabel("Measures each file first, then normalizes with the measured values");
+    twoPassHint->setStyleSheet("color: gray; font-size: 11px;");
+    linearLayout->addWidget(twoPassCheck);
+    linearLayout->addWidget(twoPassHint);
     optionsLayout->addWidget(linearGroup);
 
     // Dual mono checkbox
@@ -269,6 +277,9 @@ QWidget* FFLoudnorm::getParametersWidget() {
         m_linear = checked;
         updateFFmpegFlags();
     });
+    connect(twoPassCheck, &QCheckBox::toggled, [this](bool checked) {
+        m_twoPass = checked;
+    });
     connect(dualMonoCheck, &QCheckBox::toggled, [this](bool checked) {
         m_dualMono = checked;
         updateFFmpegFlags();
@@ -298,6 +309,10 @@ void FFLoudnorm::updateFFmpegFlags() {
 }
 
 QString FFLoudnorm::buildFFmpegFlags() const {
+    // Named so batch can find this instance to measure and apply (see LoudnormMeasurement)
+    if (m_twoPass) {
+        return LoudnormMeasurement::instanceName(getFilterId()) + ffmpegFlags.mid(8);
+    }
     return ffmpegFlags;
 }
 
@@ -310,6 +325,7 @@ void FFLoudnorm::toJSON(QJsonObject& json) const {
     json["linear"] = m_linear;
     json["dualMono"] = m_dualMono;
     json["printFormat"] = m_printFormat;
+    json["twoPass"] = m_twoPass;
 }
 
 void FFLoudnorm::fromJSON(const QJsonObject& json) {
@@ -320,6 +336,7 @@ void FFLoudnorm::fromJSON(const QJsonObject& json) {
     m_linear = json["linear"].toBool(true);
     m_dualMono = json["dualMono"].toBool(false);
     m_printFormat = json["printFormat"].toInt(0);
+    m_twoPass = json["twoPass"].toBool(false);
     updateFFmpegFlags();
 }
 
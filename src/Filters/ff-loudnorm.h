@@ -29,6 +29,9 @@ public:
     void fromJSON(const QJsonObject& json) override;
     void resetParametersWidget() override;
 
+    // Batch runs a measurement pass first and renders with the measured values
+    bool isTwoPass() const { return m_twoPass; }
+
 private:
     void updateFFmpegFlags();
 
@@ -40,6 +43,7 @@ private:
     bool m_linear = true;                  // default true
     bool m_dualMono = false;               // default false
     int m_printFormat = 0;                 // 0=none, 1=json, 2=summary
+    bool m_twoPass = false;                // batch: measure first, then linear render
 
     QString ffmpegFlags;
 
@@ -54,6 +58,7 @@ private:
     QDoubleSpinBox* offsetSpinBox = nullptr;
     QSlider* offsetSlider = nullptr;
     QCheckBox* linearCheck = nullptr;
+    QCheckBox* twoPassCheck = nullptr;
     QCheckBox* dualMonoCheck = nullptr;
     QComboBox* printFormatCombo = nullptr;
 };
@@ -13,10 +13,10 @@
 #include <QDebug>
 #include <QColor>
 
-AsplitRowWidget::AsplitRowWidget(AsplitFilter* filter, FilterChain* chain, int position,
+AsplitRowWidget::AsplitRowWidget(AsplitFilter* filter, FilterChain* chain,
                                  FilterChainWidget* widget, QWidget* parent)
     : QWidget(parent), asplitFilter(filter), filterChain(chain), 
-      chainWidget(widget), filterPosition(position) {
+      chainWidget(widget) {
     setupUI();
     updateButtonStates();
     updateControlButtonStates();  // Set initial M/S/O button colors
@@ -246,9 +246,11 @@ void AsplitRowWidget::updateControlButtonStates() {
     if (!chainWidget) return;
     
     // Query current mute/solo/custom output states from FilterChainWidget
-    bool isExplicitMute = chainWidget->isFilterExplicitMute(filterPosition);
-    bool isImpliedMute = chainWidget->isFilterImpliedMute(filterPosition);
-    bool isSoloed = chainWidget->isFilterSoloed(filterPosition);
+    // By ID — the row widget outlives moves of the filter within the chain
+    int filterId = asplitFilter->getFilterId();
+    bool isExplicitMute = chainWidget->isFilterExplicitMuteById(filterId);
+    bool isImpliedMute = chainWidget->isFilterImpliedMuteById(filterId);
+    bool isSoloed = chainWidget->isFilterSoloedById(filterId);
     bool hasCustomOutput = asplitFilter->usesCustomOutputStream();
     bool anySoloActive = chainWidget->isAnySoloActive();
     
@@ -280,7 +282,6 @@ void AsplitRowWidget::updateControlButtonStates() {
     }
     
     // CUSTOM OUTPUT BUTTON
-    int filterId = asplitFilter->getFilterId();
     if (hasCustomOutput) {
         customOutputButton->setStyleSheet(buttonActiveStyle.arg("color: #FFFFFF; background-color: rgba(67, 139, 33, 0.5);"));
         customOutputButton->setToolTip("Custom Output: ON\nThis filter branches to [" + 
@@ -24,7 +24,7 @@ class AsplitRowWidget : public QWidget {
     Q_OBJECT
     
 public:
-    AsplitRowWidget(AsplitFilter* filter, FilterChain* chain, int position, 
+    AsplitRowWidget(AsplitFilter* filter, FilterChain* chain,
                     class FilterChainWidget* chainWidget, QWidget* parent = nullptr);
     
     void updateButtonStates();  // Refresh which streams are active
@@ -53,7 +53,6 @@ private:
     AsplitFilter* asplitFilter;
     FilterChain* filterChain;
     class FilterChainWidget* chainWidget;
-    int filterPosition;
     
     // Control buttons
     QPushButton* upButton;
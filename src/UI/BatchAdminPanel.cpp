@@ -1,6 +1,92 @@
 #include "BatchAdminPanel.h"
+#include <QGridLayout>
+#include <QVBoxLayout>
+#include <QLabel>
+#include <QFileInfo>
+#include <QLocale>
 
 BatchAdminPanel::BatchAdminPanel(QWidget* parent) : QWidget(parent) {
+    auto* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(4);
+
+    layout->addWidget(new QLabel("Throughput:"));
+
+    auto* grid = new QGridLayout();
+    grid->setSpacing(4);
+
+    auto addValue = [grid](int row, int col, const QString& caption) {
+        auto* captionLabel = new QLabel(caption);
+        captionLabel->setStyleSheet("color: #808080;");
+        grid->addWidget(captionLabel, row, col * 2);
+        auto* valueLabel = new QLabel("—");
+        grid->addWidget(valueLabel, row, col * 2 + 1);
+        return valueLabel;
+    };
+
+    m_realtimeLabel    = addValue(0, 0, "Speed:");
+    m_filesPerMinLabel = addValue(0, 1, "Files/min:");
+    m_audioLabel       = addValue(1, 0, "Audio:");
+    m_queueLabel       = addValue(1, 1, "Queue:");
+    m_workersLabel     = addValue(2, 0, "Workers:");
+    m_idleLabel        = addValue(2, 1, "Idle:");
+    m_etaLabel         = addValue(3, 0, "ETA:");
+
+    grid->setColumnStretch(1, 1);
+    grid->setColumnStretch(3, 1);
+    layout->addLayout(grid);
+
+    m_exportLabel = new QLabel();
+    m_exportLabel->setStyleSheet("color: #808080;");
+    m_exportLabel->setVisible(false);
+    layout->addWidget(m_exportLabel);
 }
 
 BatchAdminPanel::~BatchAdminPanel() = default;
+
+void BatchAdminPanel::reset() {
+    for (auto* label : {m_realtimeLabel, m_filesPerMinLabel, m_audioLabel, m_queueLabel,
+                        m_workersLabel, m_idleLabel, m_etaLabel}) {
+        label->setText("—");
+    }
+    m_exportLabel->clear();
+    m_exportLabel->setVisible(false);
+}
+
+void BatchAdminPanel::updateMetrics(const BatchMetricsSnapshot& s) {
+    QLocale loc;
+
+    m_realtimeLabel->setText(s.realtimeFactor > 0.0
+        ? QString("%1× realtime").arg(s.realtimeFactor, 0, 'f', s.realtimeFactor < 10.0 ? 2 : 1)
+        : QString("—"));
+    m_filesPerMinLabel->setText(QString::number(s.filesPerMinute, 'f', 1));
+
+    m_audioLabel->setText(s.audioTotalSec > 0.0
+        ? QString("%1 / %2").arg(formatDuration(s.audioDoneSec), formatDuration(s.audioTotalSec))
+        : QString("—"));
+
+    QString queue = loc.toString(s.queuedJobs) + " ready";
+    if (s.waitingJobs > 0) queue += QString(", %1 waiting").arg(loc.toString(s.waitingJobs));
+    m_queueLabel->setText(queue);
+
+    m_workersLabel->setText(QString("%1 / %2 busy (%3%)")
+        .arg(s.runningJobs).arg(s.workerCount)
+        .arg(qRound(s.workerUtilization * 100.0)));
+    m_idleLabel->setText(formatDuration(s.workerIdleSec));
+    m_etaLabel->setText(s.etaSec >= 0.0 ? formatDuration(s.etaSec) : QString("—"));
+}
+
+void BatchAdminPanel::setExportFile(const QString& filePath) {
+    m_exportLabel->setText(QString("<small>Metrics → %1</small>").arg(QFileInfo(filePath).fileName()));
+    m_exportLabel->setToolTip(filePath);
+    m_exportLabel->setVisible(!filePath.isEmpty());
+}
+
+QString BatchAdminPanel::formatDuration(double seconds) {
+    int total = qMax(0, qRound(seconds));
+    int h = total / 3600;
+    int m = (total / 60) % 60;
+    int s = total % 60;
+    if (h > 0) return QString("%1h %2m").arg(h).arg(m);
+    return QString("%1:%2").arg(m).arg(s, 2, 10, QChar('0'));
+}
@@ -1,9 +1,38 @@
 #pragma once
 #include <QWidget>
+#include "Core/BatchMetrics.h"
 
+class QLabel;
+
+/**
+ * BatchAdminPanel - Live throughput telemetry for the running batch
+ *
+ * Shows the BatchMetrics snapshot: aggregate realtime factor, files/min,
+ * audio processed, queue depth, worker utilization/idle time and ETA,
+ * plus the path of the exported metrics file when enabled in
+ * Settings → Log File.
+ */
 class BatchAdminPanel : public QWidget {
     Q_OBJECT
 public:
     explicit BatchAdminPanel(QWidget* parent = nullptr);
     ~BatchAdminPanel() override;
+
+    void reset();
+
+public slots:
+    void updateMetrics(const BatchMetricsSnapshot& snapshot);
+    void setExportFile(const QString& filePath);
+
+private:
+    static QString formatDuration(double seconds);
+
+    QLabel* m_realtimeLabel = nullptr;
+    QLabel* m_filesPerMinLabel = nullptr;
+    QLabel* m_audioLabel = nullptr;
+    QLabel* m_queueLabel = nullptr;
+    QLabel* m_workersLabel = nullptr;
+    QLabel* m_idleLabel = nullptr;
+    QLabel* m_etaLabel = nullptr;
+    QLabel* m_exportLabel = nullptr;
 };
@@ -6,6 +6,7 @@
 #include "InputPanel.h"
 #include "FileListWidget.h"
 #include "FilterChainWidget.h"
+#include "BatchAdminPanel.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
@@ -16,6 +17,7 @@
 #include <QDebug>
 #include <QSettings>
 #include <QToolButton>
+#include <QMessageBox>
 
 BatchSettingsWindow::BatchSettingsWindow(QWidget* parent)
     : QDialog(parent)
@@ -62,6 +64,15 @@ void BatchSettingsWindow::setContext(std::shared_ptr<FilterChain> chain,
     filterChainWidget = chainWidget;
     ffmpegPath = ffmpeg;
     
+    if (batchProcessor) {
+        connect(batchProcessor->metrics(), &BatchMetrics::updated,
+                m_adminPanel, &BatchAdminPanel::updateMetrics, Qt::UniqueConnection);
+        connect(batchProcessor->metrics(), &BatchMetrics::exportFileCreated,
+                m_adminPanel, &BatchAdminPanel::setExportFile, Qt::UniqueConnection);
+        connect(batchProcessor->metrics(), &BatchMetrics::updated,
+                this, &BatchSettingsWindow::onMetricsUpdated, Qt::UniqueConnection);
+    }
+    
     refreshOutputEstimate();
 }
 
@@ -192,6 +203,39 @@ void BatchSettingsWindow::setupSettingsView() {
     
     layout->addWidget(iterateSettingsWidget);
     
+    // Output subfolders — order matches OutputLayout::Sharding
+    QSettings settings;
+    auto* shardRow = new QHBoxLayout();
+    auto* shardLabel = new QLabel("Subfolders:");
+    shardingCombo = new QComboBox();
+    shardingCombo->addItems({"None (flat)", "Per main file", "Per aux file",
+                             "Hash prefix (256)", "Every N files"});
+    shardingCombo->setToolTip("Spread outputs over subfolders of the OUTPUT folder.\n"
+                              "Keeps very large batches out of a single directory.");
+    shardingCombo->setCurrentIndex(settings.value("batch/outputSharding", 0).toInt());
+    
+    filesPerFolderSpin = new QSpinBox();
+    filesPerFolderSpin->setRange(10, 100000);
+    filesPerFolderSpin->setSingleStep(100);
+    filesPerFolderSpin->setSuffix(" files");
+    filesPerFolderSpin->setValue(settings.value("batch/filesPerFolder", 1000).toInt());
+    filesPerFolderSpin->setVisible(shardingCombo->currentIndex() ==
+                                   static_cast<int>(OutputLayout::Sharding::Count));
+    
+    connect(shardingCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        filesPerFolderSpin->setVisible(index == static_cast<int>(OutputLayout::Sharding::Count));
+        QSettings().setValue("batch/outputSharding", index);
+    });
+    connect(filesPerFolderSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [](int value) {
+        QSettings().setValue("batch/filesPerFolder", value);
+    });
+    
+    shardRow->addWidget(shardLabel);
+    shardRow->addWidget(shardingCombo);
+    shardRow->addWidget(filesPerFolderSpin);
+    shardRow->addStretch();
+    layout->addLayout(shardRow);
+    
     // Output estimate
     auto* estimateGroup = new QGroupBox("Output Estimate");
     auto* estLayout = new QVBoxLayout(estimateGroup);
@@ -312,6 +356,11 @@ void BatchSettingsWindow::setupProgressView() {
 
     layout->addSpacing(4);
 
+    m_adminPanel = new BatchAdminPanel();
+    layout->addWidget(m_adminPanel);
+
+    layout->addSpacing(4);
+
     // Results — hidden during processing, shown at completion (only if failures)
     auto* resultsRow = new QHBoxLayout();
     succeededLabel = new QLabel();
@@ -629,6 +678,7 @@ void BatchSettingsWindow::showProgressView() {
 
 void BatchSettingsWindow::showSettingsView() {
     etaTimer->stop();
+    m_adminPanel->reset();
     mainStack->setCurrentWidget(settingsPage);
     setWindowTitle("Batch Settings");
     refreshOutputEstimate();
@@ -650,6 +700,13 @@ int BatchSettingsWindow::iterateRepeatCount() const {
     return iterateRepeatSpin ? iterateRepeatSpin->value() : JobListBuilder::ITERATE_DEFAULT_REPEATS;
 }
 
+OutputLayout BatchSettingsWindow::outputLayout() const {
+    OutputLayout layout;
+    if (shardingCombo) layout.sharding = static_cast<OutputLayout::Sharding>(shardingCombo->currentIndex());
+    if (filesPerFolderSpin) layout.filesPerFolder = filesPerFolderSpin->value();
+    return layout;
+}
+
 double BatchSettingsWindow::iterateGainDb() const {
     return iterateGainSlider ? iterateGainSlider->value() / 10.0 : JobListBuilder::ITERATE_DEFAULT_GAIN_DB;
 }
@@ -666,7 +723,7 @@ void BatchSettingsWindow::onBatchStarted(int total) {
 
     QLocale loc;
     progressDetailLabel->setText(QString("0 / %1").arg(loc.toString(total)));
-    progressBar->setRange(0, total);
+    progressBar->setRange(0, 10000);  // Fraction of total audio (see onMetricsUpdated)
     progressBar->setValue(0);
 
     // Hide results until completion
@@ -681,7 +738,9 @@ void BatchSettingsWindow::onBatchStarted(int total) {
     }
     m_workerRows.clear();
 
-    m_batchWorkerCount = QSettings().value("processing/maxConcurrent", 1).toInt();
+    // Pool size as actually started (analysis-only batches may use more workers)
+    m_batchWorkerCount = batchProcessor ? batchProcessor->getWorkerCount()
+                                        : QSettings().value("processing/maxConcurrent", 1).toInt();
     m_batchWorkerCount = qMax(1, m_batchWorkerCount);
 
     static const QString kBarStyle =
@@ -783,7 +842,6 @@ void BatchSettingsWindow::onFileFinished(const QString& fileName, bool success,
         QLocale loc;
         progressDetailLabel->setText(
             QString("%1 / %2").arg(loc.toString(done)).arg(loc.toString(totalFiles)));
-        progressBar->setValue(done);
     }
 }
 
@@ -800,7 +858,7 @@ void BatchSettingsWindow::onBatchFinished(int completed, int failed) {
     failedFiles = failed;
     
     // Final bar state
-    progressBar->setValue(totalFiles);
+    progressBar->setValue(progressBar->maximum());
     
     // Format elapsed time
     qint64 elapsedMs = elapsedTimer.elapsed();
@@ -831,21 +889,51 @@ void BatchSettingsWindow::onBatchFinished(int completed, int failed) {
     cancelButton->setText("Close");
 }
 
+void BatchSettingsWindow::onDiskSpaceLow(const QString& volumePath, qint64 freeBytes, qint64 remainingBytes) {
+    // BatchProcessor pauses by itself once the running jobs finish
+    pauseButton->setVisible(false);
+    resumeButton->setVisible(true);
+    etaTimer->stop();
+    remainingLabel->setText("Disk full");
+    
+    // Not exec() — this arrives from inside BatchProcessor's dispatch
+    auto* box = new QMessageBox(QMessageBox::Warning, "Low Disk Space",
+        QString("The batch is pausing: %1 has %2 free, and about %3 of output "
+                "is still to be written.\n\n"
+                "Free up space (or lower the minimum in Settings → Processing), "
+                "then click Resume.")
+            .arg(volumePath, JobListBuilder::formatBytes(freeBytes),
+                 JobListBuilder::formatBytes(remainingBytes)),
+        QMessageBox::Ok, this);
+    box->setAttribute(Qt::WA_DeleteOnClose);
+    box->open();
+}
+
 void BatchSettingsWindow::updateETA() {
     qint64 elapsedMs = elapsedTimer.elapsed();
-    int done = completedFiles + failedFiles;
     
     // Elapsed
     int totalSec = static_cast<int>(elapsedMs / 1000);
     int m = totalSec / 60;
     int s = totalSec % 60;
     elapsedLabel->setText(QString("%1:%2").arg(m).arg(s, 2, 10, QChar('0')));
-    
-    // Remaining estimate
-    if (done > 0 && done < totalFiles) {
-        double msPerFile = static_cast<double>(elapsedMs) / done;
-        int remaining = totalFiles - done;
-        int remainingSec = static_cast<int>((msPerFile * remaining) / 1000);
+}
+
+void BatchSettingsWindow::onMetricsUpdated(const BatchMetricsSnapshot& snapshot) {
+    if (!isShowingProgress() || !etaTimer->isActive()) return;
+    
+    // Overall progress by audio duration, so one long file among many short
+    // ones isn't reported as "almost done". Falls back to file counts when
+    // durations are unknown.
+    int done = snapshot.completedJobs + snapshot.failedJobs;
+    double fraction = snapshot.audioTotalSec > 0.0
+        ? snapshot.audioDoneSec / snapshot.audioTotalSec
+        : (snapshot.totalJobs > 0 ? static_cast<double>(done) / snapshot.totalJobs : 0.0);
+    progressBar->setValue(qBound(0, static_cast<int>(fraction * 10000), 10000));
+    
+    // Remaining estimate: remaining audio at the observed aggregate speed
+    if (snapshot.etaSec >= 0.0 && done < snapshot.totalJobs) {
+        int remainingSec = static_cast<int>(snapshot.etaSec);
         int rm = remainingSec / 60;
         int rs = remainingSec % 60;
         
@@ -14,11 +14,13 @@
 #include <memory>
 #include "Core/JobListBuilder.h"
 #include "Core/FFmpegRunner.h"
+#include "Core/BatchMetrics.h"
 
 class FilterChain;
 class BatchProcessor;
 class InputPanel;
 class FilterChainWidget;
+class BatchAdminPanel;
 
 /**
  * BatchSettingsWindow - Modeless window for batch configuration and progress
@@ -35,9 +37,10 @@ class FilterChainWidget;
  * 
  * 2. Progress View:
  *    - Algorithm summary
- *    - Overall progress bar (capped at ~200 visual updates)
- *    - Elapsed / remaining time
+ *    - Overall progress bar, weighted by audio duration
+ *    - Elapsed / remaining time (ETA from remaining audio at the observed speed)
  *    - Speed (x realtime)
+ *    - Throughput telemetry (BatchAdminPanel)
  *    - Succeeded / failed counts
  *    - [Pause] [Resume] [Cancel Batch] buttons
  * 
@@ -85,6 +88,9 @@ public:
     int iterateRepeatCount() const;
     double iterateGainDb() const;
     
+    // Output subfolder layout ("batch/outputSharding", "batch/filesPerFolder")
+    OutputLayout outputLayout() const;
+    
 signals:
     // Emitted when user clicks [Process Batch] — MainWindow handles job building + confirmation
     void processRequested(JobListBuilder::Algorithm algorithm,
@@ -97,6 +103,7 @@ public slots:
     void onFileProgress(const FFmpegRunner::ProgressInfo& info, int workerIndex);
     void onFileFinished(const QString& fileName, bool success, int workerIndex);
     void onBatchFinished(int completed, int failed);
+    void onDiskSpaceLow(const QString& volumePath, qint64 freeBytes, qint64 remainingBytes);
     
 protected:
     void closeEvent(QCloseEvent* event) override;
@@ -108,6 +115,7 @@ private slots:
     void onResumeClicked();
     void onCancelClicked();
     void updateETA();
+    void onMetricsUpdated(const BatchMetricsSnapshot& snapshot);
     
 private:
     void setupSettingsView();
@@ -151,6 +159,10 @@ private:
     QLabel* iterateGainValueLabel = nullptr;
     QWidget* iterateSettingsWidget = nullptr;  // Container for show/hide
     
+    // Output subfolders
+    QComboBox* shardingCombo = nullptr;
+    QSpinBox* filesPerFolderSpin = nullptr;
+    
     int currentAlgoIndex = 0;  // 0-based (maps to Algorithm 1-7)
     
     // ===== Progress View Widgets =====
@@ -180,6 +192,9 @@ private:
     QLabel*   m_instanceFooterLabel  = nullptr;
     int       m_batchWorkerCount     = 1;
 
+    // Throughput telemetry (fed by BatchProcessor's BatchMetrics)
+    BatchAdminPanel* m_adminPanel = nullptr;
+
     // Progress state
     int totalFiles = 0;
     int completedFiles = 0;
@@ -7,6 +7,7 @@
 #include <QKeyEvent>
 #include <QCloseEvent>
 #include <QLabel>
+#include <QtConcurrent>
 
 CommandViewWindow::CommandViewWindow(QWidget* parent)
     : QWidget(parent, Qt::Window)
@@ -43,6 +44,15 @@ CommandViewWindow::CommandViewWindow(QWidget* parent)
     // Create syntax highlighter (attaches to document)
     highlighter = new FFmpegHighlighter(commandText->document());
     
+    buildWatcher = new QFutureWatcher<Rendering>(this);
+    connect(buildWatcher, &QFutureWatcher<Rendering>::finished, this, [this]() {
+        rendering = buildWatcher->result();
+        updateDisplay();
+        
+        // Requests that arrived meanwhile collapsed into the newest one
+        if (pendingBuild) startPendingBuild();
+    });
+    
     auto infoLabel = new QLabel("Press [\\] to toggle formatting");
     infoLabel->setStyleSheet("padding: 0; margin: 0; font-size: 9px; color: #808080");
     layout->addWidget(infoLabel);
@@ -67,13 +77,36 @@ bool CommandViewWindow::eventFilter(QObject* obj, QEvent* event) {
     return QWidget::eventFilter(obj, event);
 }
 
-void CommandViewWindow::setCommand(const QString& command) {
-    rawCommand = command;
-    updateDisplay();
+QString CommandViewWindow::getCommand() const {
+    return rendering.rawCommand;
 }
 
-QString CommandViewWindow::getCommand() const {
-    return rawCommand;
+void CommandViewWindow::setCommandAsync(std::function<QString()> build) {
+    pendingBuild = std::move(build);
+    if (!buildWatcher->isRunning()) {
+        startPendingBuild();
+    }
+}
+
+void CommandViewWindow::startPendingBuild() {
+    auto build = std::move(pendingBuild);
+    pendingBuild = nullptr;
+    
+    // Highlight with the rules this window's highlighter was loaded with
+    QString syntaxSource = highlighter->syntaxSource();
+    buildWatcher->setFuture(QtConcurrent::run([build, syntaxSource]() {
+        return render(build(), syntaxSource);
+    }));
+}
+
+CommandViewWindow::Rendering CommandViewWindow::render(const QString& command, const QString& syntaxSource) {
+    Rendering result;
+    result.rawCommand = command;
+    if (!command.isEmpty()) {
+        result.formatted = FFmpegFormatter::format(command);
+        result.spans = FFmpegHighlighter::computeSpans(result.formatted, syntaxSource);
+    }
+    return result;
 }
 
 void CommandViewWindow::toggleFormatting() {
@@ -82,22 +115,24 @@ void CommandViewWindow::toggleFormatting() {
 }
 
 void CommandViewWindow::updateDisplay() {
-    if (rawCommand.isEmpty()) {
+    if (rendering.rawCommand.isEmpty()) {
         commandText->clear();
         return;
     }
     
     if (formattingEnabled) {
+        // Line breaks and highlight spans were computed by render()
+        highlighter->setLineSpans(rendering.spans);
+        commandText->setPlainText(rendering.formatted);
         // Enable syntax highlighting
-        highlighter->setDocument(commandText->document());
-        // Apply line break formatting
-        QString formatted = FFmpegFormatter::format(rawCommand);
-        commandText->setPlainText(formatted);
+        if (highlighter->document() != commandText->document()) {
+            highlighter->setDocument(commandText->document());
+        }
     } else {
         // Disable syntax highlighting - plain white text
         highlighter->setDocument(nullptr);
         // Raw single-line command
-        commandText->setPlainText(rawCommand);
+        commandText->setPlainText(rendering.rawCommand);
     }
 }
 
@@ -2,10 +2,12 @@
 
 #include <QWidget>
 #include <QString>
+#include <QFutureWatcher>
+#include <functional>
+#include "Core/FFmpegSyntax.h"
 
 class QTextEdit;
 class QCloseEvent;
-class FFmpegHighlighter;
 
 /**
  * CommandViewWindow - Displays the current FFmpeg command
@@ -14,6 +16,9 @@ class FFmpegHighlighter;
  * - Syntax highlighting for FFmpeg commands
  * - Toggle between raw/formatted view with \ key
  * - Intelligent line breaking for readability
+ * - setCommandAsync(): command build, line breaking and highlight spans run
+ *   on a worker thread; only the newest pending request runs next, and the
+ *   result is applied to the view in one step
  * 
  * Color scheme:
  *   - Blue (#3F7D9C):   Input stream labels [0:a], [XXXX]
@@ -28,19 +33,33 @@ public:
     explicit CommandViewWindow(QWidget* parent = nullptr);
     ~CommandViewWindow() override = default;
     
-    void setCommand(const QString& command);
     QString getCommand() const;
+    
+    // build() runs on a worker thread — it must only use what it captured
+    void setCommandAsync(std::function<QString()> build);
 
 protected:
     bool eventFilter(QObject* obj, QEvent* event) override;
     void closeEvent(QCloseEvent* event) override;
 
 private:
+    // Everything updateDisplay() needs, computable off the UI thread
+    struct Rendering {
+        QString rawCommand;
+        QString formatted;
+        SyntaxLineSpans spans;  // for formatted
+    };
+    static Rendering render(const QString& command, const QString& syntaxSource);
+    
+    void startPendingBuild();
     void toggleFormatting();
     void updateDisplay();
     
     QTextEdit* commandText = nullptr;
     FFmpegHighlighter* highlighter = nullptr;
-    QString rawCommand;
+    Rendering rendering;
     bool formattingEnabled = true;  // Start with formatting ON
+    
+    QFutureWatcher<Rendering>* buildWatcher = nullptr;
+    std::function<QString()> pendingBuild;
 };
@@ -10,6 +10,7 @@
 #include <QMimeData>
 #include <QDirIterator>
 #include <QFileInfo>
+#include <QHash>
 #include <QStyle>
 #include <algorithm>
 
@@ -67,6 +68,11 @@ void FileListWidget::setupUI() {
         if (col == 0) return;  // Ignore checkbox column
         emit previewRequested();
     });
+
+    connect(tableWidget, &QTableWidget::currentCellChanged, this,
+            [this](int row, int /*col*/, int previousRow, int /*prevCol*/) {
+        if (row >= 0 && row != previousRow) emit currentFileChanged();
+    });
     
     layout->addWidget(tableWidget);
 }
@@ -156,6 +162,44 @@ int FileListWidget::addFiles(const QList<AudioFileInfo>& newFiles) {
     return skipped;
 }
 
+void FileListWidget::updateMetadata(const QList<AudioFileInfo>& scanned) {
+    if (scanned.isEmpty()) return;
+    
+    QHash<QString, int> indexByPath;
+    indexByPath.reserve(files.size());
+    for (int i = 0; i < files.size(); ++i) {
+        indexByPath.insert(files[i].filePath, i);
+    }
+    
+    QSet<int> changed;
+    for (const auto& info : scanned) {
+        auto it = indexByPath.constFind(info.filePath);
+        if (it == indexByPath.constEnd()) continue;
+        bool enabled = files[it.value()].enabled;
+        files[it.value()] = info;
+        files[it.value()].enabled = enabled;
+        changed.insert(it.value());
+    }
+    if (changed.isEmpty()) return;
+    
+    // Rewrite only the metadata cells of the changed rows; rows may be
+    // sorted, so map through the original index on the filename item
+    tableWidget->setSortingEnabled(false);
+    tableWidget->setUpdatesEnabled(false);
+    
+    for (int row = 0; row < tableWidget->rowCount(); ++row) {
+        QTableWidgetItem* filenameItem = tableWidget->item(row, 1);
+        if (!filenameItem) continue;
+        int originalIndex = filenameItem->data(Qt::UserRole).toInt();
+        if (changed.contains(originalIndex)) {
+            populateMetadataCells(row, files[originalIndex]);
+        }
+    }
+    
+    tableWidget->setUpdatesEnabled(true);
+    tableWidget->setSortingEnabled(true);
+}
+
 void FileListWidget::clearFiles() {
     files.clear();
     fileNameSet.clear();
@@ -369,40 +413,44 @@ void FileListWidget::populateSingleRow(int i) {
     filenameItem->setFlags(filenameItem->flags() & ~Qt::ItemIsEditable);
     tableWidget->setItem(i, 1, filenameItem);
     
+    populateMetadataCells(i, file);
+}
+
+void FileListWidget::populateMetadataCells(int row, const AudioFileInfo& file) {
     // Format
     auto formatItem = new QTableWidgetItem(file.format);
     formatItem->setFlags(formatItem->flags() & ~Qt::ItemIsEditable);
-    tableWidget->setItem(i, 2, formatItem);
+    tableWidget->setItem(row, 2, formatItem);
     
     // Duration
     auto durationItem = new QTableWidgetItem(file.duration);
     durationItem->setFlags(durationItem->flags() & ~Qt::ItemIsEditable);
-    tableWidget->setItem(i, 3, durationItem);
+    tableWidget->setItem(row, 3, durationItem);
     
     // Sample Rate (store integer for proper sorting)
     auto sampleRateItem = new QTableWidgetItem(QString("%1 Hz").arg(file.sampleRate));
     sampleRateItem->setData(Qt::UserRole, file.sampleRate);  // Store actual number
     sampleRateItem->setFlags(sampleRateItem->flags() & ~Qt::ItemIsEditable);
-    tableWidget->setItem(i, 4, sampleRateItem);
+    tableWidget->setItem(row, 4, sampleRateItem);
 
     // Bits Per Sample (store integer for proper sorting)
     auto bitsPerSampleItem = new QTableWidgetItem(file.bitsPerSample > 0 ? QString("%1 bit").arg(file.bitsPerSample) : "Lossy");
     bitsPerSampleItem->setData(Qt::UserRole, file.bitsPerSample);  // Store actual number
     bitsPerSampleItem->setFlags(bitsPerSampleItem->flags() & ~Qt::ItemIsEditable);
-    tableWidget->setItem(i, 5, bitsPerSampleItem);
+    tableWidget->setItem(row, 5, bitsPerSampleItem);
     
     // Channels (store integer for proper sorting)
     QString channelStr = file.channels == 1 ? "Mono" : file.channels == 2 ? "Stereo" : file.channels >= 3 ? "Multi" : QString::number(file.channels);
     auto channelsItem = new QTableWidgetItem(channelStr);
     channelsItem->setData(Qt::UserRole, file.channels);  // Store actual number
     channelsItem->setFlags(channelsItem->flags() & ~Qt::ItemIsEditable);
-    tableWidget->setItem(i, 6, channelsItem);
+    tableWidget->setItem(row, 6, channelsItem);
     
     // Bitrate (store integer for proper sorting)
     auto bitrateItem = new QTableWidgetItem(file.bitrate > 0 ? QString("%1 kbps").arg(file.bitrate) : "N/A");
     bitrateItem->setData(Qt::UserRole, file.bitrate);  // Store actual number
     bitrateItem->setFlags(bitrateItem->flags() & ~Qt::ItemIsEditable);
-    tableWidget->setItem(i, 7, bitrateItem);
+    tableWidget->setItem(row, 7, bitrateItem);
 }
 
 void FileListWidget::populateTable() {
@@ -428,6 +476,22 @@ QList<FileListWidget::AudioFileInfo> FileListWidget::getEnabledFiles() const {
     return enabledFiles;
 }
 
+QStringList FileListWidget::previewPrefetchPaths(int lookahead) const {
+    QStringList paths;
+    int currentRow = tableWidget->currentRow();
+    if (currentRow < 0) return paths;
+
+    for (int row = currentRow; row <= currentRow + lookahead && row < tableWidget->rowCount(); ++row) {
+        QTableWidgetItem* filenameItem = tableWidget->item(row, 1);
+        if (!filenameItem) continue;
+        int originalIndex = filenameItem->data(Qt::UserRole).toInt();
+        if (originalIndex >= 0 && originalIndex < files.size()) {
+            paths << files[originalIndex].filePath;
+        }
+    }
+    return paths;
+}
+
 QList<FileListWidget::AudioFileInfo> FileListWidget::getSelectedFiles() const {
     QList<AudioFileInfo> selectedFiles;
     QModelIndexList selectedRows = tableWidget->selectionModel()->selectedRows();
@@ -42,6 +42,10 @@ public:
     bool addFile(const AudioFileInfo& fileInfo);    // returns false if duplicate
     int addFiles(const QList<AudioFileInfo>& files); // returns count of skipped duplicates
     
+    // Replace the metadata of files already in the list (matched by path,
+    // enabled state kept) — re-probing part of a list without a rebuild
+    void updateMetadata(const QList<AudioFileInfo>& scanned);
+    
     // Clear all files
     void clearFiles();
     
@@ -59,6 +63,10 @@ public:
     
     // Get all files
     QList<AudioFileInfo> getAllFiles() const;
+
+    // Paths of the highlighted row and the next `lookahead` rows in display
+    // order — what the user is likely to preview next
+    QStringList previewPrefetchPaths(int lookahead = 1) const;
     
     // Update background colors (public so MainWindow can call on theme change)
     void updateBackground();
@@ -67,6 +75,7 @@ signals:
     void fileSelectionChanged();  // Emitted when checkboxes change
     void rescanRequested();  // Emitted when user clicks Rescan Metadata button
     void previewRequested();  // Emitted on double-click: generate preview + auto-play
+    void currentFileChanged();  // Emitted when the highlighted row moves (for preview prefetch)
     void filesDropped(const QStringList& paths);  // Emitted when files/folders are dropped onto the widget
     
 protected:
@@ -76,6 +85,7 @@ private:
     void setupUI();
     void populateTable();
     void populateSingleRow(int index);
+    void populateMetadataCells(int row, const AudioFileInfo& file);
     static QStringList audioNameFilters();
     
     QTableWidget* tableWidget;
@@ -4,6 +4,7 @@
 #include "AsplitRowWidget.h"
 #include "Core/FilterChain.h"
 #include "Core/AppConfig.h"
+#include "Core/FilterRegistry.h"
 #include "Filters/BaseFilter.h"
 #include "Filters/MultiOutputFilter.h"
 #include "Filters/AudioInputFilter.h"
@@ -42,6 +43,14 @@ static QPushButton* createCompactButton(const QString& text) {
     return btn;
 }
 
+// Row bookkeeping for FilterChainWidget::refreshChain(), after the
+// Qt::UserRole .. Qt::UserRole + 3 row data read by the delegate
+enum FilterRowRole {
+    RowKeyRole = Qt::UserRole + 4,
+    RowSignatureRole,
+    RowFlowLabelRole
+};
+
 // ========== DRAGGABLE FILTER LIST ==========
 // Custom QListView subclass that handles drag-and-drop reordering
 
@@ -433,35 +442,42 @@ public:
         
         if (!filter) return new QWidget(parent);
         
+        // Rows are kept across refreshChain() while filters above them move,
+        // so handlers read the row's current position at click time
+        QPersistentModelIndex row(index);
+        auto currentPosition = [row, isSubChainFilter]() {
+            return row.data(isSubChainFilter ? Qt::UserRole + 3 : Qt::UserRole).toInt();
+        };
+        
         // Check if this is an asplit filter - use custom widget (only in main chain view)
         if (!isSubChainFilter && filter->filterType() == "asplit") {
             auto* asplitFilter = dynamic_cast<AsplitFilter*>(filter.get());
             if (asplitFilter) {
-                auto* asplitWidget = new AsplitRowWidget(asplitFilter, filterChain, position, chainWidget, parent);
+                auto* asplitWidget = new AsplitRowWidget(asplitFilter, filterChain, chainWidget, parent);
                 asplitWidget->setFixedWidth(372);
                 
                 connect(asplitWidget, &AsplitRowWidget::moveUpRequested, 
-                        [this, position]() { chainWidget->moveFilterUp(position); });
+                        [this, currentPosition]() { chainWidget->moveFilterUp(currentPosition()); });
                 connect(asplitWidget, &AsplitRowWidget::moveDownRequested,
-                        [this, position]() { chainWidget->moveFilterDown(position); });
+                        [this, currentPosition]() { chainWidget->moveFilterDown(currentPosition()); });
                 connect(asplitWidget, &AsplitRowWidget::deleteRequested,
-                        [this, position]() {
+                        [this, currentPosition]() {
                             if (QApplication::keyboardModifiers() & Qt::AltModifier) {
-                                chainWidget->deleteFilter(position);
+                                chainWidget->deleteFilter(currentPosition());
                             } else {
-                                chainWidget->confirmDeleteFilter(position);
+                                chainWidget->confirmDeleteFilter(currentPosition());
                             }
                         });
                 connect(asplitWidget, &AsplitRowWidget::muteToggled,
-                        [this, position]() { chainWidget->handleMuteToggle(position); });
+                        [this, currentPosition]() { chainWidget->handleMuteToggle(currentPosition()); });
                 connect(asplitWidget, &AsplitRowWidget::soloToggled,
-                        [this, position]() { chainWidget->handleSoloToggle(position); });
+                        [this, currentPosition]() { chainWidget->handleSoloToggle(currentPosition()); });
                 connect(asplitWidget, &AsplitRowWidget::customOutputToggled,
-                        [this, position]() { chainWidget->handleCustomOutputToggle(position); });
+                        [this, currentPosition]() { chainWidget->handleCustomOutputToggle(currentPosition()); });
                 connect(asplitWidget, &AsplitRowWidget::streamButtonClicked,
-                        [this, position](int streamIndex) {
-                            qDebug() << "Stream button clicked:" << streamIndex << "for asplit at position" << position;
-                            chainWidget->showStreamView(position, streamIndex);
+                        [this, currentPosition](int streamIndex) {
+                            qDebug() << "Stream button clicked:" << streamIndex << "for asplit at position" << currentPosition();
+                            chainWidget->showStreamView(currentPosition(), streamIndex);
                         });
                 
                 return asplitWidget;
@@ -527,49 +543,48 @@ public:
         blankBtn2->setStyleSheet(buttonBaseStyle.arg(""));
         blankBtn3->setStyleSheet(buttonBaseStyle.arg(""));
 
-        int effectivePosition = isSubChainFilter ? subChainIndex : position;
-        
-        connect(muteBtn, &QPushButton::clicked, [this, filterId, isSubChainFilter, effectivePosition]() {
+        connect(muteBtn, &QPushButton::clicked, [this, filterId, isSubChainFilter, currentPosition]() {
             if (QApplication::keyboardModifiers() & Qt::AltModifier) {
                 chainWidget->handleMuteAllToggle();
             } else if (isSubChainFilter) {
                 chainWidget->handleMuteToggleById(filterId);
             } else {
-                chainWidget->handleMuteToggle(effectivePosition);
+                chainWidget->handleMuteToggle(currentPosition());
             }
         });
         
-        connect(soloBtn, &QPushButton::clicked, [this, filterId, isSubChainFilter, effectivePosition]() {
+        connect(soloBtn, &QPushButton::clicked, [this, filterId, isSubChainFilter, currentPosition]() {
             if (QApplication::keyboardModifiers() & Qt::AltModifier) {
                 chainWidget->handleSoloAllClear();
             } else if (isSubChainFilter) {
                 chainWidget->handleSoloToggleById(filterId);
             } else {
-                chainWidget->handleSoloToggle(effectivePosition);
+                chainWidget->handleSoloToggle(currentPosition());
             }
         });
         
-        connect(customOutputBtn, &QPushButton::clicked, [this, filterId, isSubChainFilter, effectivePosition]() {
+        connect(customOutputBtn, &QPushButton::clicked, [this, filterId, isSubChainFilter, currentPosition]() {
             if (isSubChainFilter) {
                 chainWidget->handleCustomOutputToggleById(filterId);
             } else {
-                chainWidget->handleCustomOutputToggle(effectivePosition);
+                chainWidget->handleCustomOutputToggle(currentPosition());
             }
         });
 
-        connect(upBtn, &QPushButton::clicked, [this, isSubChainFilter, effectivePosition]() {
-            chainWidget->moveFilterUp(isSubChainFilter ? -(effectivePosition + 1) : effectivePosition);
+        connect(upBtn, &QPushButton::clicked, [this, isSubChainFilter, currentPosition]() {
+            chainWidget->moveFilterUp(isSubChainFilter ? -(currentPosition() + 1) : currentPosition());
         });
         
-        connect(downBtn, &QPushButton::clicked, [this, isSubChainFilter, effectivePosition]() {
-            chainWidget->moveFilterDown(isSubChainFilter ? -(effectivePosition + 1) : effectivePosition);
+        connect(downBtn, &QPushButton::clicked, [this, isSubChainFilter, currentPosition]() {
+            chainWidget->moveFilterDown(isSubChainFilter ? -(currentPosition() + 1) : currentPosition());
         });
         
-        connect(delBtn, &QPushButton::clicked, [this, isSubChainFilter, effectivePosition]() {
+        connect(delBtn, &QPushButton::clicked, [this, isSubChainFilter, currentPosition]() {
+            int target = isSubChainFilter ? -(currentPosition() + 1) : currentPosition();
             if (QApplication::keyboardModifiers() & Qt::AltModifier) {
-                chainWidget->deleteFilter(isSubChainFilter ? -(effectivePosition + 1) : effectivePosition);
+                chainWidget->deleteFilter(target);
             } else {
-                chainWidget->confirmDeleteFilter(isSubChainFilter ? -(effectivePosition + 1) : effectivePosition);
+                chainWidget->confirmDeleteFilter(target);
             }
         });
         
@@ -624,15 +639,8 @@ public:
         nameLabel->setStyleSheet("background: transparent; border: none; padding-left: 6px;");
         layout->addWidget(nameLabel, 1);
         
-        // Signal flow label (right side)
-        QString flowLabel;
-        if (isSubChainFilter) {
-            int multiOutputPos = chainWidget->getCurrentMultiOutputPosition();
-            int streamIndex = chainWidget->getCurrentStreamIndex();
-            flowLabel = chainWidget->getSubChainSignalFlowLabel(multiOutputPos, streamIndex, subChainIndex);
-        } else {
-            flowLabel = chainWidget->getFilterInputStreamLabel(position);
-        }
+        // Signal flow label (right side) — computed for all rows by refreshChain()
+        QString flowLabel = index.data(RowFlowLabelRole).toString();
         if (!flowLabel.isEmpty()) {
             auto* flowLabelWidget = new QLabel(flowLabel);
             flowLabelWidget->setStyleSheet("background: transparent; border: none; color: rgba(128, 128, 128, 0.7); padding-right: 6px;");
@@ -640,6 +648,28 @@ public:
             layout->addWidget(flowLabelWidget);
         }
 
+        // Profile cost label (after Profile Chain)
+        if (!isSubChainFilter && chainWidget->hasProfileResult(filterId)) {
+            FilterCost cost = chainWidget->profileResult(filterId);
+            QString costText = QString::number(cost.cpuSeconds, 'f', 2) + "s";
+            if (cost.realtimeFactor > 0.0) {
+                costText += QString(" · %1×").arg(cost.realtimeFactor, 0, 'f', cost.realtimeFactor < 10.0 ? 1 : 0);
+            }
+            auto* costLabel = new QLabel(costText);
+            bool costliest = chainWidget->isCostliestFilter(filterId);
+            costLabel->setStyleSheet(QString("background: transparent; border: none; padding-right: 6px; color: %1;%2")
+                .arg(costliest ? "rgb(230, 140, 40)" : "rgba(128, 128, 128, 0.9)",
+                     costliest ? " font-weight: bold;" : ""));
+            costLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            costLabel->setToolTip(QString("CPU time: %1 s (%2% of chain)\nSpeed: %3")
+                .arg(cost.cpuSeconds, 0, 'f', 3)
+                .arg(cost.share * 100.0, 0, 'f', 1)
+                .arg(cost.realtimeFactor > 0.0
+                     ? QString("%1× realtime").arg(cost.realtimeFactor, 0, 'f', 1)
+                     : QString("too fast to measure")));
+            layout->addWidget(costLabel);
+        }
+
         // INPUT and OUTPUT header styling
         bool isInputOrOutput = !isSubChainFilter && (position == 0 || position == filterChain->filterCount() - 1);
         if (isInputOrOutput) {
@@ -673,6 +703,10 @@ public:
         }
     }
     
+    void setEditorData(QWidget*, const QModelIndex&) const override {
+        // Row editors are rebuilt by refreshChain() when their content changes
+    }
+    
 private:
     FilterChain* filterChain;
     FilterChainWidget* chainWidget;
@@ -721,131 +755,253 @@ void FilterChainWidget::setupUI() {
 }
 
 void FilterChainWidget::refreshChain() {
-    model->clear();
+    const QList<RowSpec> rows = buildRowSpecs();
+    const int oldCount = model->rowCount();
+    const int newCount = rows.size();
+    
+    auto rowKey = [this](int row) { return model->item(row)->data(RowKeyRole).toString(); };
+    
+    // Rows keep their identity (filter ID, arrow slot, ...) across refreshes.
+    // Matching rows at both ends are kept; in between, the longest run of
+    // keys common to the old and new order is kept and only the rest are
+    // removed and inserted — a move, add or delete rebuilds just those rows
+    int head = 0;
+    while (head < oldCount && head < newCount && rowKey(head) == rows[head].key) {
+        ++head;
+    }
+    int tail = 0;
+    while (tail < oldCount - head && tail < newCount - head &&
+           rowKey(oldCount - 1 - tail) == rows[newCount - 1 - tail].key) {
+        ++tail;
+    }
+    
+    const int oldMiddle = oldCount - head - tail;
+    const int newMiddle = newCount - head - tail;
+    QVector<bool> keepOld(oldMiddle, false);
+    QVector<bool> keepNew(newMiddle, false);
+    
+    if (oldMiddle > 0 && newMiddle > 0) {
+        QStringList oldKeys;
+        for (int i = 0; i < oldMiddle; ++i) {
+            oldKeys.append(rowKey(head + i));
+        }
+        
+        QVector<QVector<int>> lcs(oldMiddle + 1, QVector<int>(newMiddle + 1, 0));
+        for (int i = oldMiddle - 1; i >= 0; --i) {
+            for (int j = newMiddle - 1; j >= 0; --j) {
+                lcs[i][j] = (oldKeys[i] == rows[head + j].key)
+                    ? lcs[i + 1][j + 1] + 1
+                    : qMax(lcs[i + 1][j], lcs[i][j + 1]);
+            }
+        }
+        for (int i = 0, j = 0; i < oldMiddle && j < newMiddle; ) {
+            if (oldKeys[i] == rows[head + j].key) {
+                keepOld[i++] = true;
+                keepNew[j++] = true;
+            } else if (lcs[i + 1][j] >= lcs[i][j + 1]) {
+                ++i;
+            } else {
+                ++j;
+            }
+        }
+    }
     
-    if (!filterChain) return;
+    for (int i = oldMiddle - 1; i >= 0; --i) {
+        if (!keepOld[i]) model->removeRow(head + i);
+    }
+    for (int j = 0; j < newMiddle; ++j) {
+        if (!keepNew[j]) model->insertRow(head + j, new QStandardItem());
+    }
+    
+    // Model rows now line up with the spec; rebuild editors whose content changed
+    for (int row = 0; row < newCount; ++row) {
+        QStandardItem* item = model->item(row);
+        const RowSpec& spec = rows[row];
+        
+        if (item->data(RowSignatureRole).toString() == spec.signature &&
+            listView->isPersistentEditorOpen(item->index())) {
+            // Same content, maybe shifted — editors read their position from the item
+            item->setData(spec.position, Qt::UserRole);
+            item->setData(spec.subChainIndex, Qt::UserRole + 3);
+            continue;
+        }
+        
+        listView->closePersistentEditor(item->index());
+        applyRowSpec(item, spec);
+        listView->openPersistentEditor(item->index());
+    }
+    
+    addFilterButton->setText("+ Add Filter");
+    
+    updateAsplitButtonStates();
+}
+
+QList<FilterChainWidget::RowSpec> FilterChainWidget::buildRowSpecs() const {
+    QList<RowSpec> rows;
+    
+    if (!filterChain) return rows;
     
     int filterCount = filterChain->filterCount();
-    if (filterCount == 0) return;
+    if (filterCount == 0) return rows;
     
     // SUB-CHAIN VIEW
     if (currentViewMode == StreamView && currentMultiOutputPos >= 0 && currentStreamIndex > 0) {
         // Back button row
-        auto backItem = new QStandardItem();
-        backItem->setData(-2, Qt::UserRole);
-        backItem->setData(false, Qt::UserRole + 1);
-        backItem->setFlags(Qt::ItemIsEnabled);
-        model->appendRow(backItem);
+        RowSpec back;
+        back.key = "back";
+        back.signature = back.key;
+        back.position = -2;
+        rows.append(back);
         
-        addSubChainHeader();
-        addArrowSeparator();
+        addSubChainHeader(rows);
+        addArrowSeparator(rows, "arrow:in");
         
         // Get filters from the multi-output filter's stream
         const auto& subChain = filterChain->getSubChain(currentMultiOutputPos, currentStreamIndex);
         int streamFilterCount = subChain.size();
+        bool anySoloActive = isAnySoloActiveInSubChain();
         
         for (int i = 0; i < streamFilterCount; ++i) {
-            addSubChainFilterRow(subChain[i], i);
+            addSubChainFilterRow(rows, subChain[i], i, anySoloActive);
         }
         
         // Only add arrow before footer if there are filters
         if (streamFilterCount > 0) {
-            addArrowSeparator();
+            addArrowSeparator(rows, "arrow:out");
         }
-        addSubChainFooter();
+        addSubChainFooter(rows);
         
-        addFilterButton->setText(QString("+ Add Filter"));
-        
-        for (int i = 0; i < model->rowCount(); ++i) {
-            listView->openPersistentEditor(model->index(i, 0));
-        }
-        
-        return;
+        return rows;
     }
     
     // MAIN CHAIN VIEW
+    const QStringList flowLabels = getFilterInputStreamLabels();
+    bool anySoloActive = isAnySoloActive();
     bool addedAnyFilters = false;
     
-    addFilterRow(0);  // INPUT
-    addArrowSeparator();
+    addFilterRow(rows, 0, QString(), anySoloActive);  // INPUT
+    addArrowSeparator(rows, "arrow:in");
     
     for (int i = 1; i < filterCount - 1; ++i) {
-        addFilterRow(i);
+        addFilterRow(rows, i, flowLabels.value(i), anySoloActive);
         addedAnyFilters = true;
     }
     
     if (addedAnyFilters) {
-        addArrowSeparator();
+        addArrowSeparator(rows, "arrow:out");
     }
     
     if (filterCount > 1) {
-        addFilterRow(filterCount - 1);  // OUTPUT
-    }
-    
-    addFilterButton->setText("+ Add Filter");
-    
-    for (int i = 0; i < model->rowCount(); ++i) {
-        listView->openPersistentEditor(model->index(i, 0));
+        addFilterRow(rows, filterCount - 1, QString(), anySoloActive);  // OUTPUT
     }
     
-    updateAsplitButtonStates();
+    return rows;
 }
 
-void FilterChainWidget::addFilterRow(int position) {
+void FilterChainWidget::addFilterRow(QList<RowSpec>& rows, int position, const QString& flowLabel,
+                                     bool anySoloActive) const {
     auto filter = filterChain->getFilter(position);
     if (!filter) return;
     
-    auto item = new QStandardItem();
-    item->setData(position, Qt::UserRole);
-    item->setData(false, Qt::UserRole + 1);  // Not an arrow
-    item->setData(false, Qt::UserRole + 2);  // Not a sub-chain filter
-    item->setData(0, Qt::UserRole + 3);      // Sub-chain index (unused)
-    item->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
+    RowSpec row;
+    if (position == 0) {
+        row.key = "input";
+    } else if (position == filterChain->filterCount() - 1) {
+        row.key = "output";
+    } else {
+        row.key = QString("f:%1").arg(filter->getFilterId());
+    }
+    row.position = position;
+    row.flowLabel = flowLabel;
+    row.selectable = true;
+    
+    if (filter->filterType() == "asplit") {
+        // AsplitRowWidget restyles itself (updateAsplitButtonStates) but
+        // holds the filter pointer
+        row.signature = QString("%1|asplit@%2").arg(row.key).arg(quintptr(filter.get()), 0, 16);
+    } else {
+        row.signature = row.key + "|" + filterStateSignature(filter.get(), anySoloActive, true) + "|" + flowLabel;
+    }
     
-    model->appendRow(item);
+    rows.append(row);
 }
 
-void FilterChainWidget::addSubChainFilterRow(std::shared_ptr<BaseFilter> filter, int indexInSubChain) {
+void FilterChainWidget::addSubChainFilterRow(QList<RowSpec>& rows, std::shared_ptr<BaseFilter> filter,
+                                             int indexInSubChain, bool anySoloActive) const {
     if (!filter) return;
     
-    auto item = new QStandardItem();
-    item->setData(-1, Qt::UserRole);          // Position -1 = not in main chain
-    item->setData(false, Qt::UserRole + 1);   // Not an arrow
-    item->setData(true, Qt::UserRole + 2);    // IS a sub-chain filter
-    item->setData(indexInSubChain, Qt::UserRole + 3);  // Index within sub-chain
-    item->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
+    RowSpec row;
+    row.key = QString("s:%1").arg(filter->getFilterId());
+    row.position = -1;                    // Position -1 = not in main chain
+    row.isSubChainFilter = true;
+    row.subChainIndex = indexInSubChain;  // Index within sub-chain
+    row.flowLabel = getSubChainSignalFlowLabel(currentMultiOutputPos, currentStreamIndex, indexInSubChain);
+    row.selectable = true;
+    row.signature = row.key + "|" + filterStateSignature(filter.get(), anySoloActive, false) + "|" + row.flowLabel;
+    
+    rows.append(row);
+}
+
+void FilterChainWidget::addArrowSeparator(QList<RowSpec>& rows, const QString& key) const {
+    RowSpec row;
+    row.key = key;
+    row.signature = key;
+    row.isArrow = true;
     
-    model->appendRow(item);
+    rows.append(row);
 }
 
-void FilterChainWidget::addArrowSeparator() {
-    auto item = new QStandardItem();
-    item->setData(-1, Qt::UserRole);
-    item->setData(true, Qt::UserRole + 1);  // Is an arrow
-    item->setData(false, Qt::UserRole + 2);
-    item->setFlags(Qt::ItemIsEnabled);
+void FilterChainWidget::addSubChainHeader(QList<RowSpec>& rows) const {
+    auto* multiOutput = filterChain->getMultiOutputFilter(currentMultiOutputPos);
     
-    model->appendRow(item);
+    RowSpec row;
+    row.key = "header";
+    row.signature = QString("header|%1|%2")
+        .arg(multiOutput ? multiOutput->getFilterId() : -1)
+        .arg(currentStreamIndex);
+    row.position = -3;
+    
+    rows.append(row);
 }
 
-void FilterChainWidget::addSubChainHeader() {
-    auto item = new QStandardItem();
-    item->setData(-3, Qt::UserRole);
-    item->setData(false, Qt::UserRole + 1);
-    item->setData(false, Qt::UserRole + 2);
-    item->setFlags(Qt::ItemIsEnabled);
+void FilterChainWidget::addSubChainFooter(QList<RowSpec>& rows) const {
+    RowSpec row;
+    row.key = "footer";
+    row.signature = row.key;
+    row.position = -4;
     
-    model->appendRow(item);
+    rows.append(row);
+}
+
+void FilterChainWidget::applyRowSpec(QStandardItem* item, const RowSpec& spec) {
+    item->setData(spec.position, Qt::UserRole);
+    item->setData(spec.isArrow, Qt::UserRole + 1);
+    item->setData(spec.isSubChainFilter, Qt::UserRole + 2);
+    item->setData(spec.subChainIndex, Qt::UserRole + 3);
+    item->setData(spec.key, RowKeyRole);
+    item->setData(spec.signature, RowSignatureRole);
+    item->setData(spec.flowLabel, RowFlowLabelRole);
+    item->setFlags(spec.selectable ? (Qt::ItemIsEnabled | Qt::ItemIsSelectable) : Qt::ItemIsEnabled);
 }
 
-void FilterChainWidget::addSubChainFooter() {
-    auto item = new QStandardItem();
-    item->setData(-4, Qt::UserRole);
-    item->setData(false, Qt::UserRole + 1);
-    item->setData(false, Qt::UserRole + 2);
-    item->setFlags(Qt::ItemIsEnabled);
+// Everything a standard row editor shows for a filter, flattened for comparison
+QString FilterChainWidget::filterStateSignature(BaseFilter* filter, bool anySoloActive, bool showProfile) const {
+    auto flag = [](bool on) { return on ? QLatin1Char('1') : QLatin1Char('0'); };
+    int filterId = filter->getFilterId();
+    
+    QString signature = filter->filterType() + "|" + filter->displayName() + "|";
+    signature += flag(isFilterExplicitMuteById(filterId));
+    signature += flag(isFilterImpliedMuteById(filterId));
+    signature += flag(isFilterSoloedById(filterId));
+    signature += flag(anySoloActive);
+    signature += flag(filter->usesCustomOutputStream());
     
-    model->appendRow(item);
+    if (showProfile && profileResults.contains(filterId)) {
+        FilterCost cost = profileResults.value(filterId);
+        signature += QString("|%1|%2").arg(cost.cpuSeconds).arg(cost.realtimeFactor);
+        signature += flag(filterId == costliestFilterId);
+    }
+    return signature;
 }
 
 // ========== DRAG AND DROP HANDLER ==========
@@ -1188,14 +1344,7 @@ QSet<int> FilterChainWidget::computeSoloProtectedFilters() const {
 }
 
 static bool isMultiInputFilterType(BaseFilter* f) {
-    return dynamic_cast<FFAfir*>(f) ||
-           dynamic_cast<FFSidechaincompress*>(f) ||
-           dynamic_cast<FFSidechaingate*>(f) ||
-           dynamic_cast<FFAcrossfade*>(f) ||
-           dynamic_cast<FFAmerge*>(f) ||
-           dynamic_cast<FFAmix*>(f) ||
-           dynamic_cast<FFAxcorrelate*>(f) ||
-           dynamic_cast<FFJoin*>(f);
+    return FilterRegistry::kindOf(f) == DAG::FilterKind::MultiInput;
 }
 
 void FilterChainWidget::recomputeImpliedMutes() {
@@ -1505,28 +1654,14 @@ void FilterChainWidget::onAddFilterClicked() {
     if (addFilterMenuOpen) return;
     addFilterMenuOpen = true;
 
-    QMenu* menu = FilterMenuBuilder::createFilterMenu(this);
-
+    // Submenus are populated on first open, so pass the exclusions in
+    // rather than walking the actions afterwards
+    QStringList disabledTypes;
     if (currentViewMode == StreamView) {
-        for (QAction* action : menu->actions()) {
-            QString filterType = action->data().toString();
-            if (filterType == "asplit" || filterType == "channelsplit" || 
-                filterType == "asegment" || filterType == "acrossover") {
-                action->setEnabled(false);
-                action->setToolTip("Multi-output filters cannot be nested inside sub-chains");
-            }
-            if (action->menu()) {
-                for (QAction* subAction : action->menu()->actions()) {
-                    QString subType = subAction->data().toString();
-                    if (subType == "asplit" || subType == "channelsplit" || 
-                        subType == "asegment" || subType == "acrossover") {
-                        subAction->setEnabled(false);
-                        subAction->setToolTip("Multi-output filters cannot be nested inside sub-chains");
-                    }
-                }
-            }
-        }
+        disabledTypes = {"asplit", "channelsplit", "asegment", "acrossover"};
     }
+    QMenu* menu = FilterMenuBuilder::createFilterMenu(
+        this, disabledTypes, "Multi-output filters cannot be nested inside sub-chains");
     
     connect(menu, &QMenu::triggered, [this](QAction* action) {
         QString filterType = action->data().toString();
@@ -1679,80 +1814,22 @@ void FilterChainWidget::setSoloFilterIds(const QList<int>& filterIds) {
     refreshChain();
 }
 
-QString FilterChainWidget::getFilterInputStreamLabel(int targetPosition) const {
-    if (targetPosition <= 0 || targetPosition >= filterChain->filterCount() - 1) {
-        return "";
-    }
-    
-    QString mainChainInput = "[0:a]";
-    QMap<int, QString> sidechainOutputs;
-    AudioInputFilter* currentAudioInput = nullptr;
-    
-    for (int i = 1; i < targetPosition; ++i) {
-        auto filter = filterChain->getFilter(i);
-        if (!filter) continue;
-        
-        if (auto* audioInput = dynamic_cast<AudioInputFilter*>(filter.get())) {
-            currentAudioInput = audioInput;
-            int idx = audioInput->getInputIndex();
-            sidechainOutputs[idx] = QString("[%1:a]").arg(idx);
-            continue;
-        }
-        
-        if (filter->buildFFmpegFlags().isEmpty()) continue;
-        
-        bool isMultiInputOrAux = (dynamic_cast<FFAfir*>(filter.get()) ||
-                                  dynamic_cast<FFSidechaincompress*>(filter.get()) ||
-                                  dynamic_cast<FFSidechaingate*>(filter.get()) ||
-                                  dynamic_cast<FFAcrossfade*>(filter.get()) ||
-                                  dynamic_cast<FFAmerge*>(filter.get()) ||
-                                  dynamic_cast<FFAmix*>(filter.get()) ||
-                                  dynamic_cast<FFJoin*>(filter.get()) ||
-                                  dynamic_cast<SmartAuxReturn*>(filter.get()));
-        
-        if (isMultiInputOrAux) {
-            currentAudioInput = nullptr;
-            sidechainOutputs.clear();
-            
-            if (!filter->usesCustomOutputStream()) {
-                int filterId = filter->getFilterId();
-                mainChainInput = QString("[%1]").arg(
-                    QString("%1").arg(filterId, 4, 16, QChar('0')).toUpper()
-                );
-            }
-        } else if (currentAudioInput) {
-            int idx = currentAudioInput->getInputIndex();
-            int filterId = filter->getFilterId();
-            sidechainOutputs[idx] = QString("[%1]").arg(
-                QString("%1").arg(filterId, 4, 16, QChar('0')).toUpper()
-            );
-        } else {
-            if (!filter->usesCustomOutputStream()) {
-                int filterId = filter->getFilterId();
-                mainChainInput = QString("[%1]").arg(
-                    QString("%1").arg(filterId, 4, 16, QChar('0')).toUpper()
-                );
-            }
-        }
-    }
-    
-    auto targetFilter = filterChain->getFilter(targetPosition);
-    if (!targetFilter) return "";
-
-    if (auto* audioInput = dynamic_cast<AudioInputFilter*>(targetFilter.get())) {
+// Label for one main chain row, given the AudioInput (if any) feeding it
+static QString inputStreamLabel(BaseFilter* targetFilter, AudioInputFilter* currentAudioInput) {
+    if (auto* audioInput = dynamic_cast<AudioInputFilter*>(targetFilter)) {
         return QString("→ [%1:a]").arg(audioInput->getInputIndex());
     }
 
-    if (auto* afir = dynamic_cast<FFAfir*>(targetFilter.get())) {
+    if (auto* afir = dynamic_cast<FFAfir*>(targetFilter)) {
         return QString("← [%1:a]").arg(afir->getSidechainInputIndex());
     }
-    if (auto* sc = dynamic_cast<FFSidechaincompress*>(targetFilter.get())) {
+    if (auto* sc = dynamic_cast<FFSidechaincompress*>(targetFilter)) {
         return QString("← [%1:a]").arg(sc->getSidechainInputIndex());
     }
-    if (auto* sg = dynamic_cast<FFSidechaingate*>(targetFilter.get())) {
+    if (auto* sg = dynamic_cast<FFSidechaingate*>(targetFilter)) {
         return QString("← [%1:a]").arg(sg->getSidechainInputIndex());
     }
-    if (auto* acf = dynamic_cast<FFAcrossfade*>(targetFilter.get())) {
+    if (auto* acf = dynamic_cast<FFAcrossfade*>(targetFilter)) {
         return QString("← [%1:a]").arg(acf->getSidechainInputIndex());
     }
     if (targetFilter->isAnalysisTwoInputFilter()) {
@@ -1762,11 +1839,11 @@ QString FilterChainWidget::getFilterInputStreamLabel(int targetPosition) const {
         return "← [1:a]";
     }
 
-    if (dynamic_cast<FFAmix*>(targetFilter.get()) || dynamic_cast<FFAmerge*>(targetFilter.get()) || dynamic_cast<FFJoin*>(targetFilter.get())) {
+    if (dynamic_cast<FFAmix*>(targetFilter) || dynamic_cast<FFAmerge*>(targetFilter) || dynamic_cast<FFJoin*>(targetFilter)) {
         return "← [ ∀ ]";
     }
 
-    if (dynamic_cast<SmartAuxReturn*>(targetFilter.get())) {
+    if (dynamic_cast<SmartAuxReturn*>(targetFilter)) {
         return "← [∀∀∀]";
     }
 
@@ -1777,6 +1854,56 @@ QString FilterChainWidget::getFilterInputStreamLabel(int targetPosition) const {
     }
 }
 
+QString FilterChainWidget::getFilterInputStreamLabel(int targetPosition) const {
+    return getFilterInputStreamLabels().value(targetPosition);
+}
+
+QStringList FilterChainWidget::getFilterInputStreamLabels() const {
+    const int filterCount = filterChain->filterCount();
+    QStringList labels;
+    if (filterCount == 0) return labels;
+    
+    labels.reserve(filterCount);
+    labels.append("");  // INPUT
+    
+    // Single walk down the chain — each row's label only depends on the
+    // AudioInput routing state left by the filters above it
+    AudioInputFilter* currentAudioInput = nullptr;
+    
+    for (int i = 1; i < filterCount - 1; ++i) {
+        auto filter = filterChain->getFilter(i);
+        if (!filter) {
+            labels.append("");
+            continue;
+        }
+        
+        labels.append(inputStreamLabel(filter.get(), currentAudioInput));
+        
+        if (auto* audioInput = dynamic_cast<AudioInputFilter*>(filter.get())) {
+            currentAudioInput = audioInput;
+            continue;
+        }
+        
+        if (filter->buildFFmpegFlags().isEmpty()) continue;
+        
+        bool isMultiInputOrAux = (dynamic_cast<FFAfir*>(filter.get()) ||
+                                  dynamic_cast<FFSidechaincompress*>(filter.get()) ||
+                                  dynamic_cast<FFSidechaingate*>(filter.get()) ||
+                                  dynamic_cast<FFAcrossfade*>(filter.get()) ||
+                                  dynamic_cast<FFAmerge*>(filter.get()) ||
+                                  dynamic_cast<FFAmix*>(filter.get()) ||
+                                  dynamic_cast<FFJoin*>(filter.get()) ||
+                                  dynamic_cast<SmartAuxReturn*>(filter.get()));
+        
+        if (isMultiInputOrAux) {
+            currentAudioInput = nullptr;
+        }
+    }
+    
+    if (filterCount > 1) labels.append("");  // OUTPUT
+    return labels;
+}
+
 // ========== Stream View Switching ==========
 
 void FilterChainWidget::showStreamView(int multiOutputPos, int streamIndex) {
@@ -1810,24 +1937,37 @@ void FilterChainWidget::showMainChain() {
     qDebug() << "Switched to main chain view";
 }
 
+// ========== Profiling ==========
+
+void FilterChainWidget::setProfileResults(const QList<FilterCost>& costs) {
+    profileResults.clear();
+    costliestFilterId = -1;
+    
+    double maxCpu = 0.0;
+    for (const auto& cost : costs) {
+        profileResults.insert(cost.filterId, cost);
+        if (cost.cpuSeconds > maxCpu) {
+            maxCpu = cost.cpuSeconds;
+            costliestFilterId = cost.filterId;
+        }
+    }
+    
+    refreshChain();
+}
+
+void FilterChainWidget::clearProfileResults() {
+    if (profileResults.isEmpty()) return;
+    profileResults.clear();
+    costliestFilterId = -1;
+}
+
 void FilterChainWidget::updateAsplitButtonStates() {
-    for (int pos = 0; pos < filterChain->filterCount(); pos++) {
-        auto* multiOutput = filterChain->getMultiOutputFilter(pos);
-        if (!multiOutput) continue;
+    for (int row = 0; row < model->rowCount(); row++) {
+        QWidget* widget = listView->indexWidget(model->index(row, 0));
         
-        for (int row = 0; row < model->rowCount(); row++) {
-            QModelIndex idx = model->index(row, 0);
-            int position = idx.data(Qt::UserRole).toInt();
-            
-            if (position == pos) {
-                QWidget* widget = listView->indexWidget(idx);
-                
-                if (auto* asplitWidget = qobject_cast<AsplitRowWidget*>(widget)) {
-                    asplitWidget->updateButtonStates();
-                    asplitWidget->updateControlButtonStates();
-                }
-                break;
-            }
+        if (auto* asplitWidget = qobject_cast<AsplitRowWidget*>(widget)) {
+            asplitWidget->updateButtonStates();
+            asplitWidget->updateControlButtonStates();
         }
     }
 }
\ No newline at end of file
@@ -5,7 +5,9 @@
 #include <QStandardItemModel>
 #include <QPushButton>
 #include <QVBoxLayout>
+#include <QHash>
 #include <memory>
+#include "Core/ChainProfiler.h"
 
 class FilterChain;
 class BaseFilter;
@@ -29,6 +31,7 @@ public:
     explicit FilterChainWidget(FilterChain* chain, QWidget* parent = nullptr);
     ~FilterChainWidget() override;
     
+    // Sync the list with the chain: only rows whose content changed are rebuilt
     void refreshChain();
     
     // Public methods for delegate to call
@@ -70,6 +73,7 @@ public:
     
     QList<int> getMutedFilterPositions() const;
     QString getFilterInputStreamLabel(int position) const;
+    QStringList getFilterInputStreamLabels() const;  // all main chain positions, one pass
     
     // Get/Set mute/solo states for preset save/load
     QList<int> getMutedFilterIds() const;
@@ -92,6 +96,13 @@ public:
     int getCurrentStreamIndex() const { return currentStreamIndex; }
     int getCurrentMultiOutputPosition() const { return currentMultiOutputPos; }
     
+    // Per-filter cost from ChainProfiler, shown on each row until the chain changes
+    void setProfileResults(const QList<FilterCost>& costs);
+    void clearProfileResults();
+    bool hasProfileResult(int filterId) const { return profileResults.contains(filterId); }
+    FilterCost profileResult(int filterId) const { return profileResults.value(filterId); }
+    bool isCostliestFilter(int filterId) const { return filterId >= 0 && filterId == costliestFilterId; }
+    
 signals:
     void filterSelected(int position);
     void subChainFilterSelected(int filterId);  // For selecting filters in sub-chains
@@ -102,12 +113,28 @@ private slots:
     void onListItemClicked(const QModelIndex& index);
     
 private:
+    // One list row as refreshChain() wants it
+    struct RowSpec {
+        QString key;                // stable identity ("input", "f:<id>", "arrow:in", ...)
+        QString signature;          // everything the row editor displays
+        int position = -1;          // Qt::UserRole
+        bool isArrow = false;       // Qt::UserRole + 1
+        bool isSubChainFilter = false;  // Qt::UserRole + 2
+        int subChainIndex = 0;      // Qt::UserRole + 3
+        QString flowLabel;
+        bool selectable = false;
+    };
+    
     void setupUI();
-    void addFilterRow(int position);
-    void addSubChainFilterRow(std::shared_ptr<BaseFilter> filter, int indexInSubChain);
-    void addArrowSeparator();
-    void addSubChainHeader();   // INPUT-style row for sub-chain
-    void addSubChainFooter();   // OUTPUT-style row for sub-chain
+    QList<RowSpec> buildRowSpecs() const;
+    void addFilterRow(QList<RowSpec>& rows, int position, const QString& flowLabel, bool anySoloActive) const;
+    void addSubChainFilterRow(QList<RowSpec>& rows, std::shared_ptr<BaseFilter> filter,
+                              int indexInSubChain, bool anySoloActive) const;
+    void addArrowSeparator(QList<RowSpec>& rows, const QString& key) const;
+    void addSubChainHeader(QList<RowSpec>& rows) const;   // INPUT-style row for sub-chain
+    void addSubChainFooter(QList<RowSpec>& rows) const;   // OUTPUT-style row for sub-chain
+    void applyRowSpec(QStandardItem* item, const RowSpec& spec);
+    QString filterStateSignature(BaseFilter* filter, bool anySoloActive, bool showProfile) const;
     
     void recomputeImpliedMutes();
     void recomputeSubChainImpliedMutes();  // For sub-chain context
@@ -133,4 +160,8 @@ private:
     
     int currentSelection = -1;
     bool addFilterMenuOpen = false;
+    
+    // Profiling results (keyed by filter ID)
+    QHash<int, FilterCost> profileResults;
+    int costliestFilterId = -1;
 };
@@ -3,7 +3,7 @@
 #include <QMenu>
 #include <QWidget>
 #include <QString>
-#include <QMap>
+#include <QList>
 #include <QStringList>
 
 class FilterChain;
@@ -11,35 +11,37 @@ class FilterChain;
 /**
  * FilterMenuBuilder - Builds the "+ Add Filter" menu with categories
  * 
- * Organizes filters into logical categories:
- * - Volume & Dynamics
- * - Time & Pitch
- * - Visualization
- * - Custom Recipes
- * - Utility
+ * The category submenus and their entries come from FilterRegistry — each
+ * FilterTypeInfo's category and name, in registry order. A final
+ * "FFmpeg Filters (A-Z)" submenu lists every wrapped ffmpeg filter by its
+ * ffmpeg name, plus the ones FFAB does not wrap yet (shown disabled).
  * 
- * As more filters are added, just register them in buildFilterRegistry()
+ * As more filters are added, just register them in FilterRegistry
  */
 class FilterMenuBuilder {
 public:
-    struct FilterInfo {
+    // Create the complete filter menu. Category submenus are populated
+    // when first opened; disabledTypes are shown greyed out with the reason.
+    static QMenu* createFilterMenu(QWidget* parent,
+                                   const QStringList& disabledTypes = QStringList(),
+                                   const QString& disabledReason = QString());
+    
+private:
+    struct MenuEntry {
         QString type;           // e.g. "ff-volume"
         QString displayName;    // e.g. "Volume"
-        QString category;       // e.g. "Volume & Dynamics"
-        QString description;    // e.g. "Adjust audio volume in dB"
     };
     
-    // Create the complete filter menu
-    static QMenu* createFilterMenu(QWidget* parent);
-    
-    // Get all available filters organized by category
-    static QMap<QString, QList<FilterInfo>> getFiltersByCategory();
+    struct MenuCategory {
+        QString name;           // e.g. "Dynamics"
+        QList<MenuEntry> entries;
+    };
     
-private:
-    // Build the registry of all available filters
-    static QList<FilterInfo> buildFilterRegistry();
+    // Submenus in menu order (built once per session)
+    static const QList<MenuCategory>& cachedMenuCategories();
     
-    // Add filters from a category to a submenu
-    static void addCategoryToMenu(QMenu* parentMenu, const QString& category, 
-                                  const QList<FilterInfo>& filters);
+    // Add a category's filters to a submenu
+    static void addCategoryToMenu(QMenu* parentMenu, const MenuCategory& category,
+                                  const QStringList& disabledTypes,
+                                  const QString& disabledReason);
 };
@@ -1,5 +1,13 @@
 #include "FilterParamsPanel.h"
 #include <QLabel>
+#include <QAbstractSlider>
+#include <QAbstractButton>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QPlainTextEdit>
+#include <QTextEdit>
 
 FilterParamsPanel::FilterParamsPanel(QWidget* parent) : QWidget(parent) {
     mainLayout = new QVBoxLayout(this);
@@ -30,6 +38,37 @@ void FilterParamsPanel::setFilterWidget(QWidget* widget) {
     currentFilterWidget = widget;
     mainLayout->insertWidget(0, currentFilterWidget, 1);  // ← Add stretch factor 1
     currentFilterWidget->show();
+    
+    watchEditors(currentFilterWidget);
+}
+
+void FilterParamsPanel::watchEditors(QWidget* widget) {
+    // Editors are cached per filter and shown again later — UniqueConnection
+    // keeps one connection per control however often it is re-shown
+    for (auto* slider : widget->findChildren<QAbstractSlider*>()) {
+        connect(slider, &QAbstractSlider::valueChanged, this, &FilterParamsPanel::parametersEdited, Qt::UniqueConnection);
+    }
+    for (auto* spin : widget->findChildren<QSpinBox*>()) {
+        connect(spin, &QSpinBox::valueChanged, this, &FilterParamsPanel::parametersEdited, Qt::UniqueConnection);
+    }
+    for (auto* spin : widget->findChildren<QDoubleSpinBox*>()) {
+        connect(spin, &QDoubleSpinBox::valueChanged, this, &FilterParamsPanel::parametersEdited, Qt::UniqueConnection);
+    }
+    for (auto* combo : widget->findChildren<QComboBox*>()) {
+        connect(combo, &QComboBox::currentIndexChanged, this, &FilterParamsPanel::parametersEdited, Qt::UniqueConnection);
+    }
+    for (auto* button : widget->findChildren<QAbstractButton*>()) {
+        connect(button, &QAbstractButton::clicked, this, &FilterParamsPanel::parametersEdited, Qt::UniqueConnection);
+    }
+    for (auto* edit : widget->findChildren<QLineEdit*>()) {
+        connect(edit, &QLineEdit::textChanged, this, &FilterParamsPanel::parametersEdited, Qt::UniqueConnection);
+    }
+    for (auto* edit : widget->findChildren<QPlainTextEdit*>()) {
+        connect(edit, &QPlainTextEdit::textChanged, this, &FilterParamsPanel::parametersEdited, Qt::UniqueConnection);
+    }
+    for (auto* edit : widget->findChildren<QTextEdit*>()) {
+        connect(edit, &QTextEdit::textChanged, this, &FilterParamsPanel::parametersEdited, Qt::UniqueConnection);
+    }
 }
 
 void FilterParamsPanel::clearFilterWidget() {
@@ -8,6 +8,10 @@
  * 
  * When a filter is selected in FilterChainWidget, this panel shows
  * that filter's getParametersWidget() result.
+ * 
+ * parametersEdited() fires on any value change in the shown editor
+ * (sliders, spin boxes, combos, buttons, text fields), after the filter's
+ * own handlers have updated its members.
  */
 class FilterParamsPanel : public QWidget {
     Q_OBJECT
@@ -18,7 +22,13 @@ public:
     void setFilterWidget(QWidget* widget);
     void clearFilterWidget();
     
+signals:
+    void parametersEdited();
+    
 private:
+    void watchEditors(QWidget* widget);
+    
+
     QVBoxLayout* mainLayout;
     QWidget* currentFilterWidget = nullptr;
     QLabel* noSelectionLabel = nullptr;
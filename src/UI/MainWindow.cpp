@@ -17,6 +17,7 @@
 #include "Core/AudioFileScanner.h"
 #include "Core/BatchProcessor.h"
 #include "Core/PreviewGenerator.h"
+#include "Core/ChainProfiler.h"
 #include "Core/FFmpegRunner.h"
 #include "Core/FFmpegDetector.h"
 #include "Core/Preferences.h"
@@ -31,6 +32,7 @@
 #include "LogViewWindow.h"
 #include "Core/JobListBuilder.h"
 #include "Core/UpdateChecker.h"
+#include "Utils/StartupTrace.h"
 
 #include <QVBoxLayout>
 #include <QToolButton>
@@ -57,6 +59,7 @@
 #include <QCheckBox>
 #include <QDialogButtonBox>
 #include <QDesktopServices>
+#include <QPointer>
 #include <QUrl>
 #include <QPlainTextEdit>
 
@@ -69,18 +72,27 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
     batchProcessor = new BatchProcessor(this);
     batchSettingsWindow = new BatchSettingsWindow(this);
     commandViewWindow = new CommandViewWindow(this);
+    m_commandRefreshTimer = new QTimer(this);
+    m_commandRefreshTimer->setSingleShot(true);
+    m_commandRefreshTimer->setInterval(150);
+    connect(m_commandRefreshTimer, &QTimer::timeout, this, &MainWindow::refreshCommandView);
     previewGenerator = new PreviewGenerator(this);
+    chainProfiler = new ChainProfiler(this);
     presetManager = new PresetManager(this);
     filterPresetManager = new FilterPresetManager(this);
-    regionPreviewWindow = new RegionPreviewWindow(this);
-    logViewWindow = new LogViewWindow(this);
     m_updateChecker = new UpdateChecker(this);
+    // RegionPreviewWindow (QMediaPlayer backend) and LogViewWindow are
+    // built on first use — see regionPreview() / logView()
+    StartupTrace::mark("MainWindow: core objects");
 
     setupUI();
+    StartupTrace::mark("MainWindow: setupUI");
     createMenuBar();
     setupKeyCommands();
     connectSignals();
+    StartupTrace::mark("MainWindow: menus, keys, signals");
     checkFFmpegAvailability();
+    StartupTrace::mark("MainWindow: FFmpeg detection");
 
     // Update checker signals
     connect(m_updateChecker, &UpdateChecker::checkFinished, this, [this](bool available) {
@@ -426,28 +438,37 @@ void MainWindow::createMenuBar() {
     m_loopPreviewAction->setCheckable(true);
     connect(m_loopPreviewAction, &QAction::toggled, this, [this](bool checked) {
         waveformPreview->setLooping(checked);
-        regionPreviewWindow->setLooping(checked);
+        if (regionPreviewWindow) regionPreviewWindow->setLooping(checked);
+    });
+
+    // Stream Preview: start playback while the preview is still rendering
+    m_streamPreviewAction = playbackMenu->addAction("Stream Preview");
+    m_streamPreviewAction->setCheckable(true);
+    m_streamPreviewAction->setChecked(Preferences::instance().streamPreview());
+    previewGenerator->setStreamingEnabled(m_streamPreviewAction->isChecked());
+    connect(m_streamPreviewAction, &QAction::toggled, this, [this](bool checked) {
+        previewGenerator->setStreamingEnabled(checked);
+        Preferences::instance().setStreamPreview(checked);
     });
     
 
     viewMenu->addAction("View Command", [this]() {
         if (commandViewWindow) {
             commandViewWindow->show();
+            refreshCommandView();  // not kept current while hidden
             commandViewWindow->raise();
             commandViewWindow->activateWindow();
         }
     });
     
     viewMenu->addAction("View Log", [this]() {
-        if (logViewWindow) {
-            logViewWindow->show();
-            logViewWindow->raise();
-            logViewWindow->activateWindow();
-        }
+        logView()->show();
+        logViewWindow->raise();
+        logViewWindow->activateWindow();
     });
     
     viewMenu->addAction("Audio Preview", [this]() {
-            if (regionPreviewWindow) {
+            if (regionPreview()) {
                 waveformPreview->stop();    
                 regionPreviewWindow->show();
                 regionPreviewWindow->raise();
@@ -465,6 +486,8 @@ void MainWindow::createMenuBar() {
         }
     });
 
+    viewMenu->addAction("Profile Chain", this, &MainWindow::onProfileChain);
+
     viewMenu->addSeparator();
 
     m_filterPresetsAction = viewMenu->addAction("Filter Preset UI...");
@@ -584,6 +607,11 @@ void MainWindow::setupKeyCommands() {
 }
 
 void MainWindow::connectSignals() {
+    // Parameter edits only change the command — no chain refresh needed
+    connect(filterParamsPanel, &FilterParamsPanel::parametersEdited, this, [this]() {
+        m_commandRefreshTimer->start();
+    });
+    
     // Filter chain signals
     connect(filterChainWidget, &FilterChainWidget::filterSelected,
             this, &MainWindow::onFilterSelected);
@@ -620,6 +648,13 @@ void MainWindow::connectSignals() {
         onGeneratePreview();
     });
 
+    // Pre-decode the highlighted file and its neighbour so clicking through
+    // the list previews without decode latency
+    connect(inputPanel->getFileListWidget(), &FileListWidget::currentFileChanged, this, [this]() {
+        if (ffmpegPath.isEmpty()) return;
+        previewGenerator->prefetch(inputPanel->getFileListWidget()->previewPrefetchPaths(), ffmpegPath);
+    });
+
     // Drag & drop on main file list
     connect(inputPanel->getFileListWidget(), &FileListWidget::filesDropped,
             this, &MainWindow::onFilesDropped);
@@ -628,33 +663,18 @@ void MainWindow::connectSignals() {
     connect(waveformPreview, &WaveformPreviewWidget::generatePreviewRequested,
             this, &MainWindow::onGeneratePreview);
 
-    connect(regionPreviewWindow, &RegionPreviewWindow::generatePreviewRequested, 
-            this, &MainWindow::onGeneratePreview);        
-    
     connect(waveformPreview, &WaveformPreviewWidget::viewCommandRequested,
             this, &MainWindow::onViewCommand);
 
     connect(waveformPreview, &WaveformPreviewWidget::regionPreviewRequested, this, [this]() {
         waveformPreview->stop();    
-        regionPreviewWindow->show();
+        regionPreview()->show();
         regionPreviewWindow->raise();
         regionPreviewWindow->activateWindow();
         waveformPreview->setCanvasVisible(false);
         onGeneratePreview();
     });        
     
-    // Restore small waveform when region window closes
-    connect(regionPreviewWindow, &RegionPreviewWindow::windowClosed, this, [this]() {
-        waveformPreview->stop();
-        waveformPreview->setCanvasVisible(true);
-    });
-    
-    // Cross-stop: when either player starts, stop the other
-    connect(regionPreviewWindow, &RegionPreviewWindow::playbackStarted,
-            waveformPreview, &WaveformPreviewWidget::stop);
-    connect(waveformPreview, &WaveformPreviewWidget::playbackStarted,
-            regionPreviewWindow, &RegionPreviewWindow::stopPlayback);
-    
     connect(previewGenerator, &PreviewGenerator::started,
             this, &MainWindow::onPreviewStarted);
     
@@ -666,6 +686,53 @@ void MainWindow::connectSignals() {
     
     connect(previewGenerator, &PreviewGenerator::error,
             this, &MainWindow::onPreviewError);
+
+    // Profile Chain: per-filter cost shown on the chain rows
+    connect(chainProfiler, &ChainProfiler::progress, this, [this](int stage, int stageCount, const QString& filterName) {
+        scanProgressBar->setVisible(true);
+        scanProgressBar->setRange(0, stageCount);
+        scanProgressBar->setValue(stage - 1);
+        statusLabel->setText(QString("Profiling %1 (%2/%3)...").arg(filterName).arg(stage).arg(stageCount));
+    });
+    connect(chainProfiler, &ChainProfiler::finished, this, [this](const QList<FilterCost>& costs, double durationSec) {
+        scanProgressBar->setVisible(false);
+        filterChainWidget->setProfileResults(costs);
+
+        double total = 0.0;
+        const FilterCost* costliest = nullptr;
+        for (const auto& cost : costs) {
+            total += cost.cpuSeconds;
+            if (!costliest || cost.cpuSeconds > costliest->cpuSeconds) costliest = &cost;
+        }
+        QString summary = QString("Profile: %1 s CPU for %2 s of audio")
+            .arg(total, 0, 'f', 2).arg(durationSec, 0, 'f', 1);
+        if (costliest && costliest->cpuSeconds > 0.0) {
+            auto filter = filterChain->getFilter(costliest->position);
+            if (filter) {
+                summary += QString(" — slowest: %1 (%2%)")
+                    .arg(filter->displayName()).arg(costliest->share * 100.0, 0, 'f', 0);
+            }
+        }
+        statusLabel->setText(summary);
+    });
+    connect(chainProfiler, &ChainProfiler::error, this, [this](const QString& message) {
+        scanProgressBar->setVisible(false);
+        statusLabel->setText("Profiling failed");
+        QMessageBox::warning(this, "Profile Chain", message);
+    });
+
+    // Streaming preview feeds the small waveform player only; the Audio Preview
+    // window keeps loading the finished file.
+    // If the stream can't play, autoplay stays armed for the finished file.
+    connect(previewGenerator, &PreviewGenerator::streamStarted, this,
+            [this](int sampleRate, int channels, const QString& pcmFile) {
+        if (!regionWindowIsActive() && waveformPreview->beginStream(sampleRate, channels, pcmFile)) {
+            m_autoPlayNextPreview = false;
+        }
+    });
+
+    connect(previewGenerator, &PreviewGenerator::streamData,
+            waveformPreview, &WaveformPreviewWidget::appendStreamData);
     
     // Process button
     connect(processButton, &QPushButton::clicked,
@@ -689,7 +756,10 @@ void MainWindow::connectSignals() {
             batchSettingsWindow, &BatchSettingsWindow::onFileFinished);
 
     connect(batchProcessor, &BatchProcessor::allFinished,
-            batchSettingsWindow, &BatchSettingsWindow::onBatchFinished);            
+            batchSettingsWindow, &BatchSettingsWindow::onBatchFinished);
+
+    connect(batchProcessor, &BatchProcessor::diskSpaceLow,
+            batchSettingsWindow, &BatchSettingsWindow::onDiskSpaceLow);            
     
     // Batch signals
     connect(batchProcessor, &BatchProcessor::started,
@@ -711,7 +781,7 @@ void MainWindow::connectSignals() {
     connect(batchProcessor, &BatchProcessor::logFileCreated, this, [this](const QString& path) {
         QSettings settings;
         if (settings.value("log/openViewLog", true).toBool()) {
-            logViewWindow->setLogFile(path);
+            logView()->setLogFile(path);
             logViewWindow->show();
             logViewWindow->raise();
         }
@@ -720,7 +790,7 @@ void MainWindow::connectSignals() {
     connect(previewGenerator, &PreviewGenerator::logFileCreated, this, [this](const QString& path) {
         QSettings settings;
         if (settings.value("log/openViewLog", true).toBool()) {
-            logViewWindow->setLogFile(path);
+            logView()->setLogFile(path);
             logViewWindow->show();
             logViewWindow->raise();
         }
@@ -1050,6 +1120,9 @@ void MainWindow::onSubChainFilterSelected(int filterId) {
 }
 
 void MainWindow::onChainModified() {
+    // Profile timings describe the old chain
+    filterChainWidget->clearProfileResults();
+
     // Update AudioInput filter indices whenever chain is modified
     if (filterChain) {
         filterChain->updateAudioInputIndices();
@@ -1058,52 +1131,9 @@ void MainWindow::onChainModified() {
         filterChainWidget->refreshChain();
     }
     
-    // Get muted filter positions
-    auto mutedPositions = filterChainWidget->getMutedFilterPositions();
-    
-    // Build example FFmpeg command for debugging
-    // Collect sidechain files from all AudioInput filters (main chain + sub-chains)
-    // IMPORTANT: Always include an entry for each AudioInput (even if empty) to keep indices stable
-    QStringList sidechainFiles;
-    for (auto* audioInput : filterChain->getAllAudioInputFilters()) {
-        auto files = audioInput->getEnabledFilePaths();
-        if (!files.isEmpty()) {
-            sidechainFiles.append(files.first());
-        } else {
-            // No files loaded - add empty placeholder
-            // FilterChain will warn about this
-            sidechainFiles.append("");
-        }
-    }
-    
-    auto logSettings = LogSettings::fromQSettings();
-    QString command;
-    if (!sidechainFiles.isEmpty()) {
-        command = filterChain->buildCompleteCommand(
-            "input.wav",
-            sidechainFiles,
-            "output.wav",
-            mutedPositions,
-            logSettings
-        );
-    } else {
-        command = filterChain->buildCompleteCommand(
-            "input.wav",
-            "output.wav",
-            mutedPositions,
-            logSettings
-        );
-    }
-    
-    qDebug() << "Filter chain modified";
-    qDebug() << "Muted positions:" << mutedPositions;
-    qDebug() << "Sidechain files:" << sidechainFiles;
-    qDebug() << "FFmpeg command:" << command;
-    
-    // Update command viewer if it's open
-    if (commandViewWindow && commandViewWindow->isVisible()) {
-        commandViewWindow->setCommand(buildPreviewCommand());
-    }
+    // The command preview is built lazily for an open viewer only, and a
+    // burst of edits (drags, mute sweeps, file drops) rebuilds it once
+    m_commandRefreshTimer->start();
 }
 
 // ========== INPUT & BATCH SLOTS ==========
@@ -1522,6 +1552,36 @@ void MainWindow::onRescanAudioInputFileList(AudioInputFilter* audioInput, FileLi
     }));
 }
 
+void MainWindow::reprobeFiles(FileListWidget* fileListWidget, const QStringList& filePaths) {
+    if (!fileListWidget || filePaths.isEmpty()) return;
+    
+    scanProgressBar->setVisible(true);
+    scanProgressBar->setRange(0, filePaths.size());
+    scanProgressBar->setValue(0);
+    statusLabel->setText(QString("Probing %1 changed files...").arg(filePaths.size()));
+    
+    QString probePath = ffprobePath;
+    QPointer<FileListWidget> target(fileListWidget);  // chain edits may delete an AudioInput's list
+    
+    // Per-file map — several lists can be re-probed at once after a preset load
+    auto* watcher = new QFutureWatcher<FileListWidget::AudioFileInfo>(this);
+    connect(watcher, &QFutureWatcher<FileListWidget::AudioFileInfo>::progressValueChanged,
+            scanProgressBar, &QProgressBar::setValue);
+    connect(watcher, &QFutureWatcher<FileListWidget::AudioFileInfo>::finished,
+            this, [this, target, watcher]() {
+        auto results = watcher->future().results();
+        if (target) target->updateMetadata(results);
+        
+        scanProgressBar->setVisible(false);
+        statusLabel->setText(QString("Probed %1 changed files").arg(results.size()));
+        watcher->deleteLater();
+    });
+    
+    watcher->setFuture(QtConcurrent::mapped(filePaths, [probePath](const QString& path) {
+        return AudioFileScanner::extractMetadata(path, probePath);
+    }));
+}
+
 // ========== PROCESS BUTTON ==========
 
 void MainWindow::onProcessFiles() {
@@ -1611,32 +1671,42 @@ void MainWindow::onFileStarted(const QString& fileName, int fileNumber, int tota
         .arg(fileNumber)
         .arg(totalFiles)
         .arg(fileName));
-    scanProgressBar->setRange(0, 0);  // Indeterminate / pulsing until a real percentage arrives
+    // Indeterminate / pulsing until the batch reports its first timing
+    if (batchProcessor->metrics()->snapshot().audioDoneSec <= 0.0) {
+        scanProgressBar->setRange(0, 0);
+    }
 
     qDebug() << "Processing file" << fileNumber << "/" << totalFiles << ":" << fileName;
 }
 
 void MainWindow::onFileProgress(const FFmpegRunner::ProgressInfo& info, int workerIndex) {
-    // MainWindow status bar tracks worker 0 only
-    if (workerIndex != 0) return;
+    Q_UNUSED(info);
+    Q_UNUSED(workerIndex);
+
+    // Status bar shows the whole batch, weighted by audio duration across all workers
+    // Until the first timing arrives, the bar stays in indeterminate (pulsing) mode
+    BatchMetricsSnapshot snapshot = batchProcessor->metrics()->snapshot();
+    if (snapshot.audioTotalSec <= 0.0 || snapshot.audioDoneSec <= 0.0) return;
+
+    if (scanProgressBar->maximum() == 0) scanProgressBar->setRange(0, 10000);
+    double fraction = snapshot.audioDoneSec / snapshot.audioTotalSec;
+    scanProgressBar->setValue(qBound(1, static_cast<int>(fraction * 10000), 10000));
+
+    auto hms = [](double seconds) {
+        int total = qMax(0, static_cast<int>(seconds));
+        return QString("%1:%2:%3").arg(total / 3600, 2, 10, QChar('0'))
+                                  .arg((total / 60) % 60, 2, 10, QChar('0'))
+                                  .arg(total % 60, 2, 10, QChar('0'));
+    };
 
-    if (info.totalTime > 0.0 && info.currentTime > 0.0) {
-        if (scanProgressBar->maximum() == 0) scanProgressBar->setRange(0, 10000);
-        scanProgressBar->setValue(qMax(1, static_cast<int>((info.currentTime / info.totalTime) * 10000)));
+    QString status = QString("Progress: %1 / %2 (Speed: %3x)")
+        .arg(hms(snapshot.audioDoneSec))
+        .arg(hms(snapshot.audioTotalSec))
+        .arg(QString::number(snapshot.realtimeFactor, 'f', 1));
+    if (snapshot.etaSec >= 0.0) {
+        status += " — " + hms(snapshot.etaSec) + " left";
     }
-    // If no valid timing data yet, the bar stays in indeterminate (pulsing) mode
-
-    QString speedStr    = QString::number(info.speed, 'f', 1) + "x";
-    QString totalTimeStr = info.totalTime > 0
-        ? QString::number(info.totalTime, 'f', 1) + "s"
-        : "unknown";
-
-    statusLabel->setText(
-        QString("Progress: %1 / %2 (Speed: %3)")
-        .arg(info.timeString)
-        .arg(totalTimeStr)
-        .arg(speedStr)
-    );
+    statusLabel->setText(status);
 }
 
 void MainWindow::onFileFinished(const QString& fileName, bool success, int /*workerIndex*/) {
@@ -1817,13 +1887,15 @@ void MainWindow::showAboutDialog() {
 
 // ========== PREVIEW GENERATION SLOTS ==========
 
-QString MainWindow::buildPreviewCommand() {
+std::function<QString()> MainWindow::previewCommandBuilder() {
+    auto message = [](const QString& text) { return [text]() { return text; }; };
+    
     // Get selected file from file list
     auto fileList = inputPanel->getFileListWidget();
     auto selectedFiles = fileList->getSelectedFiles();
     
     if (selectedFiles.size() > 1) {
-        return "# Multiple files selected - please highlight only one in the INPUT File List";
+        return message("# Multiple files selected - please highlight only one in the INPUT File List");
     }
 
     QString sourceFile;
@@ -1840,7 +1912,7 @@ QString MainWindow::buildPreviewCommand() {
     }
 
     if (sourceFile.isEmpty()) {
-        return "# No file available - please highlight or [✓] enable one from the INPUT File List";
+        return message("# No file available - please highlight or [✓] enable one from the INPUT File List");
     }
         
     // Get output file extension from OutputFilter
@@ -1852,7 +1924,7 @@ QString MainWindow::buildPreviewCommand() {
         }
     }
     
-    // Get muted filter positions
+    // Get muted filter positions (also stamps each filter's effective mute)
     auto mutedPositions = filterChainWidget->getMutedFilterPositions();
     
     // Update filter indices to ensure they're current
@@ -1871,20 +1943,36 @@ QString MainWindow::buildPreviewCommand() {
     // Build the command - output to a placeholder
     QString outputFile = "OUTPUT." + outputExtension;
     
-    // ========== USE FILTERCHAIN AS SOURCE OF TRUTH ==========
-    // Build complete command including all aux outputs
     // View Command respects user's log settings from Settings > Log Level
     auto logSettings = LogSettings::fromQSettings();
-    QString command = filterChain->buildCompleteCommand(
-        sourceFile,
-        sidechainFiles,
-        outputFile,
-        mutedPositions,
-        logSettings
-    );
+    
+    // ========== USE FILTERCHAIN AS SOURCE OF TRUTH ==========
+    // The builder works on a snapshot of the chain, so it can run on a
+    // worker thread while the chain is being edited
+    QJsonObject chainSnapshot = filterChain->toSnapshot();
+    QString ffmpeg = ffmpegPath;
+    
+    return [=]() {
+        auto chain = FilterChain::fromSnapshot(chainSnapshot);
+        
+        // Build complete command including all aux outputs
+        QString command = chain->buildCompleteCommand(
+            sourceFile,
+            sidechainFiles,
+            outputFile,
+            mutedPositions,
+            logSettings
+        );
+
+        // Format for display with ffmpeg path and pretty printing
+        return FilterChain::formatCommandForDisplay(command, ffmpeg);
+    };
+}
 
-    // Format for display with ffmpeg path and pretty printing
-    return FilterChain::formatCommandForDisplay(command, ffmpegPath);
+void MainWindow::refreshCommandView() {
+    if (commandViewWindow && commandViewWindow->isVisible()) {
+        commandViewWindow->setCommandAsync(previewCommandBuilder());
+    }
 }
 
 void MainWindow::onViewCommand() {
@@ -1893,21 +1981,18 @@ void MainWindow::onViewCommand() {
         commandViewWindow = new CommandViewWindow(this);
     }
     
-    // Build and display the command
-    QString command = buildPreviewCommand();
-    commandViewWindow->setCommand(command);
-    
     // Show the window
     commandViewWindow->show();
     commandViewWindow->raise();
     commandViewWindow->activateWindow();
+    
+    // Build and display the command
+    refreshCommandView();
 }
 
 void MainWindow::onGeneratePreview() {
     // Update command viewer if it's open
-    if (commandViewWindow && commandViewWindow->isVisible()) {
-        commandViewWindow->setCommand(buildPreviewCommand());
-    }
+    refreshCommandView();
     
    // Get selected file from file list
     auto fileList = inputPanel->getFileListWidget();
@@ -2015,12 +2100,18 @@ void MainWindow::onPreviewFinished(const QString& audioFile, const QString& wave
     statusLabel->setText(audioFile);
     statusLabel->setStyleSheet("QLabel { font-size: 9px ;}");
 
-    // Load preview into both waveform widgets
+    // Load preview into both waveform widgets (the region window picks it
+    // up when first opened)
+    m_lastPreviewAudioFile = audioFile;
+    m_lastPreviewWaveformFile = waveformFile;
     waveformPreview->setPreviewFile(audioFile, waveformFile);
-    regionPreviewWindow->setPreviewFile(audioFile, waveformFile);
+    if (regionPreviewWindow) regionPreviewWindow->setPreviewFile(audioFile, waveformFile);
 
     // Auto-play: loop mode active, or double-click triggered this generation
-    if ((m_loopPreviewAction && m_loopPreviewAction->isChecked()) || m_autoPlayNextPreview) {
+    // A streamed preview is already playing — don't toggle it off
+    if (waveformPreview->isStreaming()) {
+        m_autoPlayNextPreview = false;
+    } else if ((m_loopPreviewAction && m_loopPreviewAction->isChecked()) || m_autoPlayNextPreview) {
         m_autoPlayNextPreview = false;
         if (regionWindowIsActive()) {
             regionPreviewWindow->playFromRegionOrStart();
@@ -2035,6 +2126,10 @@ void MainWindow::onPreviewFinished(const QString& audioFile, const QString& wave
 void MainWindow::onPreviewError(const QString& message) {
     scanProgressBar->setVisible(false);
     statusLabel->setText("Preview generation failed");
+
+    if (waveformPreview->isStreaming()) {
+        waveformPreview->stop();
+    }
     
     QMessageBox::critical(this, "Preview Error", 
         "Failed to generate preview:\n\n" + message);
@@ -2042,12 +2137,89 @@ void MainWindow::onPreviewError(const QString& message) {
     qWarning() << "Preview error:" << message;
 }
 
+void MainWindow::onProfileChain() {
+    if (chainProfiler->isRunning()) {
+        chainProfiler->cancel();
+        scanProgressBar->setVisible(false);
+        statusLabel->setText("Profiling cancelled");
+        return;
+    }
+
+    // Same source as the preview: highlighted file, else first enabled file
+    auto fileList = inputPanel->getFileListWidget();
+    auto selectedFiles = fileList->getSelectedFiles();
+    QString sourceFile;
+    if (!selectedFiles.isEmpty()) {
+        sourceFile = selectedFiles.first().filePath;
+    } else {
+        auto enabledFiles = fileList->getEnabledFiles();
+        if (!enabledFiles.isEmpty()) {
+            sourceFile = enabledFiles.first().filePath;
+        }
+    }
+
+    if (sourceFile.isEmpty()) {
+        QMessageBox::warning(this, "No File Available",
+            "Please select or enable a file from the File List to profile.");
+        return;
+    }
+
+    filterChain->updateAudioInputIndices();
+    filterChain->updateMultiInputFilterIndices();
+
+    QStringList sidechainFiles;
+    for (auto* audioInput : filterChain->getAllAudioInputFilters()) {
+        sidechainFiles.append(audioInput->getSelectedFilePath());
+    }
+
+    auto mutedPositions = filterChainWidget->getMutedFilterPositions();
+    if (!chainProfiler->start(*filterChain, sourceFile, sidechainFiles, mutedPositions, ffmpegPath)) {
+        QMessageBox::information(this, "Profile Chain",
+            "There are no active filters in the chain to profile.");
+    }
+}
+
 // ========== FFMPEG DETECTION ==========
 
 bool MainWindow::regionWindowIsActive() const {
     return regionPreviewWindow && regionPreviewWindow->isVisible();
 }
 
+RegionPreviewWindow* MainWindow::regionPreview() {
+    if (regionPreviewWindow) return regionPreviewWindow;
+
+    regionPreviewWindow = new RegionPreviewWindow(this);
+
+    connect(regionPreviewWindow, &RegionPreviewWindow::generatePreviewRequested, 
+            this, &MainWindow::onGeneratePreview);
+    
+    // Restore small waveform when region window closes
+    connect(regionPreviewWindow, &RegionPreviewWindow::windowClosed, this, [this]() {
+        waveformPreview->stop();
+        waveformPreview->setCanvasVisible(true);
+    });
+    
+    // Cross-stop: when either player starts, stop the other
+    connect(regionPreviewWindow, &RegionPreviewWindow::playbackStarted,
+            waveformPreview, &WaveformPreviewWidget::stop);
+    connect(waveformPreview, &WaveformPreviewWidget::playbackStarted,
+            regionPreviewWindow, &RegionPreviewWindow::stopPlayback);
+
+    // Catch up on state from before the window existed
+    regionPreviewWindow->setLooping(m_loopPreviewAction && m_loopPreviewAction->isChecked());
+    if (!m_lastPreviewAudioFile.isEmpty()) {
+        regionPreviewWindow->setPreviewFile(m_lastPreviewAudioFile, m_lastPreviewWaveformFile);
+    }
+    return regionPreviewWindow;
+}
+
+LogViewWindow* MainWindow::logView() {
+    if (!logViewWindow) {
+        logViewWindow = new LogViewWindow(this);
+    }
+    return logViewWindow;
+}
+
 void MainWindow::checkFFmpegAvailability() {
     auto paths = FFmpegDetector::detect();
     
@@ -2178,17 +2350,21 @@ void MainWindow::onSaveAs() {
         QString defaultDir = Preferences::instance().lastPresetDirectory();
         QString defaultPath = defaultDir + "/" + presetName + ".ffabjson";
         
+        const QString projectFilter = "FFAB Compact Projects - large File Lists (*.ffabproj)";
+        QString selectedFilter;
         QString filepath = QFileDialog::getSaveFileName(
             this,
             "Save Preset As",
             defaultPath,
-            "FFAB Presets (*.ffabjson);;All Files (*)"
+            "FFAB Presets (*.ffabjson);;" + projectFilter + ";;All Files (*)",
+            &selectedFilter
         );
         
         if (!filepath.isEmpty()) {
-            // Ensure .ffabjson extension
-            if (!filepath.endsWith(".ffabjson", Qt::CaseInsensitive)) {
-                filepath += ".ffabjson";
+            // Ensure .ffabjson / .ffabproj extension
+            if (!filepath.endsWith(".ffabjson", Qt::CaseInsensitive)
+                && !filepath.endsWith(".ffabproj", Qt::CaseInsensitive)) {
+                filepath += selectedFilter == projectFilter ? ".ffabproj" : ".ffabjson";
             }
             
             bool includeFiles = includeFilesCheckbox->isChecked();
@@ -2217,7 +2393,7 @@ void MainWindow::onOpen() {
         this,
         "Load Preset",
         defaultDir,
-        "FFAB Presets (*.ffabjson);;All Files (*)"
+        "FFAB Presets (*.ffabjson *.ffabproj);;All Files (*)"
     );
     
     if (!filepath.isEmpty()) {
@@ -2229,29 +2405,34 @@ void MainWindow::onOpen() {
        scanProgressBar->setValue(0);
         statusLabel->setText("Loading preset...");
         
-        // Progress callback
+        // Progress callback — repaint so file lists visibly stream in
         auto progressCallback = [this](int current, int total, const QString& message) {
             if (total > 0) {
                 int percent = (current * 100) / total;
                scanProgressBar->setValue(percent);
             }
             statusLabel->setText(message);
+            QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
         };
         
-        if (presetManager->loadPreset(filepath, filterChain.get(), inputPanel, 
-                                      outputSettingsPanel, filterChainWidget, 
-                                      missingInfo, progressCallback)) {
-            currentPresetPath = filepath;
-            Preferences::instance().setLastPresetDirectory(QFileInfo(filepath).absolutePath());
-            Preferences::instance().addRecentPreset(filepath);
-            
-            // Refresh UI
+        // Show the chain as soon as it's restored, before the file lists
+        auto chainLoadedCallback = [this]() {
             filterChainWidget->refreshChain();
             
             // Update chain indices
             filterChain->updateAudioInputIndices();
             filterChain->updateMultiInputFilterIndices();
             
+            QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+        };
+        
+        if (presetManager->loadPreset(filepath, filterChain.get(), inputPanel, 
+                                      outputSettingsPanel, filterChainWidget, 
+                                      missingInfo, progressCallback, chainLoadedCallback)) {
+            currentPresetPath = filepath;
+            Preferences::instance().setLastPresetDirectory(QFileInfo(filepath).absolutePath());
+            Preferences::instance().addRecentPreset(filepath);
+            
             // Hide progress bar
            scanProgressBar->setVisible(false);
             statusLabel->setText("Ready");
@@ -2296,6 +2477,18 @@ void MainWindow::onOpen() {
                 QMessageBox::information(this, "Preset Loaded", message);
             }
             
+            // Files saved with matching size/mtime came back with their stored
+            // metadata — only probe the rest (changed, or never scanned)
+            if (inputPanel->shouldScanMetadata()) {
+                reprobeFiles(inputPanel->getFileListWidget(), missingInfo.staleMainFiles);
+            }
+            for (auto* audioInput : filterChain->getAllAudioInputFilters()) {
+                QStringList stale = missingInfo.staleAudioInputFiles.value(audioInput->getInputIndex());
+                if (!stale.isEmpty() && audioInput->shouldScanMetadata()) {
+                    reprobeFiles(audioInput->getFileListWidget(), stale);
+                }
+            }
+            
             qDebug() << "Preset loaded from:" << filepath;
         } else {
             // Hide progress bar on error
@@ -2444,42 +2637,43 @@ void MainWindow::onBatchProcessRequested(JobListBuilder::Algorithm algorithm,
     
     // Build jobs using JobListBuilder
     QList<BatchProcessor::JobInfo> jobs;
+    const OutputLayout layout = batchSettingsWindow->outputLayout();
     
     switch (algorithm) {
         case JobListBuilder::Algorithm::Sequential:
             jobs = JobListBuilder::buildSequential(
-                mainFiles, outputFolder, filterChain, mutedPositions, baseSidechainFiles);
+                mainFiles, outputFolder, filterChain, mutedPositions, baseSidechainFiles, layout);
             break;
             
         case JobListBuilder::Algorithm::Zip:
             jobs = JobListBuilder::buildZip(
                 mainFiles, aux1Files, aux1InputIndex, outputFolder,
-                filterChain, mutedPositions, baseSidechainFiles, zipMismatch);
+                filterChain, mutedPositions, baseSidechainFiles, zipMismatch, layout);
             break;
             
         case JobListBuilder::Algorithm::BroadcastFixed:
             jobs = JobListBuilder::buildBroadcastFixed(
                 mainFiles, aux1SelectedFile, aux1InputIndex, outputFolder,
-                filterChain, mutedPositions, baseSidechainFiles);
+                filterChain, mutedPositions, baseSidechainFiles, layout);
             break;
             
         case JobListBuilder::Algorithm::BroadcastRandom:
             jobs = JobListBuilder::buildBroadcastRandom(
                 mainFiles, aux1Files, aux1InputIndex, outputFolder,
-                filterChain, mutedPositions, baseSidechainFiles);
+                filterChain, mutedPositions, baseSidechainFiles, layout);
             break;
             
         case JobListBuilder::Algorithm::Cartesian:
             jobs = JobListBuilder::buildCartesian(
                 mainFiles, aux1Files, aux1InputIndex, outputFolder,
-                filterChain, mutedPositions, baseSidechainFiles);
+                filterChain, mutedPositions, baseSidechainFiles, layout);
             break;
             
         case JobListBuilder::Algorithm::CartesianTriple:
             jobs = JobListBuilder::buildCartesianTriple(
                 mainFiles, aux1Files, aux2Files,
                 aux1InputIndex, aux2InputIndex, outputFolder,
-                filterChain, mutedPositions, baseSidechainFiles);
+                filterChain, mutedPositions, baseSidechainFiles, layout);
             break;
             
         case JobListBuilder::Algorithm::Iterate:
@@ -2487,7 +2681,7 @@ void MainWindow::onBatchProcessRequested(JobListBuilder::Algorithm algorithm,
                 mainFiles,
                 batchSettingsWindow->iterateRepeatCount(),
                 batchSettingsWindow->iterateGainDb(),
-                outputFolder, filterChain, mutedPositions, baseSidechainFiles);
+                outputFolder, filterChain, mutedPositions, baseSidechainFiles, layout);
             break;
     }
     
@@ -2498,8 +2692,21 @@ void MainWindow::onBatchProcessRequested(JobListBuilder::Algorithm algorithm,
         return;
     }
     
-    // Validate output count
-    QString warning = JobListBuilder::validateOutputCount(jobs.size());
+    // Output size estimates for disk-space admission and preallocation
+    JobListBuilder::setExpectedOutputSizes(jobs, filterChain);
+    JobListBuilder::setBranchOutputPaths(jobs, filterChain, mutedPositions);
+    
+    // Two-pass loudnorm: measurement jobs ahead of their renders
+    jobs = JobListBuilder::addLoudnormMeasurePasses(jobs, filterChain, mutedPositions);
+    
+    // Validate output count (an in-process Iterate job writes several files,
+    // a loudnorm measurement writes none)
+    int outputCount = 0;
+    for (const auto& job : jobs) {
+        if (!job.isMeasurement) outputCount += 1 + job.extraOutputPaths.size();
+    }
+    
+    QString warning = JobListBuilder::validateOutputCount(outputCount);
     if (warning.contains("exceeds the hard limit")) {
         QMessageBox::critical(this, "Too Many Files", warning);
         return;
@@ -2530,7 +2737,7 @@ void MainWindow::onBatchProcessRequested(JobListBuilder::Algorithm algorithm,
         if (validCount > 0) avgDuration = totalDur / validCount;
     }
     
-    auto sizeEst = JobListBuilder::estimateSize(jobs.size(), avgDuration,
+    auto sizeEst = JobListBuilder::estimateSize(outputCount, avgDuration,
         formatInfo.isEmpty() ? "wav" : formatInfo.toLower());
     
     // Tier 1 confirmation
@@ -2540,7 +2747,7 @@ void MainWindow::onBatchProcessRequested(JobListBuilder::Algorithm algorithm,
         mainFiles.size(),
         aux1Files.size(),
         aux2Files.size(),
-        jobs.size(),
+        outputCount,
         sizeEst.formattedSize,
         outputFolder,
         formatInfo,
@@ -2550,9 +2757,9 @@ void MainWindow::onBatchProcessRequested(JobListBuilder::Algorithm algorithm,
     if (result != QDialog::Accepted) return;
     
     // Tier 2 confirmation for large batches
-    if (jobs.size() > JobListBuilder::TIER2_THRESHOLD) {
+    if (outputCount > JobListBuilder::TIER2_THRESHOLD) {
         // Rough time estimate: assume 2x realtime average
-        double estTimeSec = (avgDuration * jobs.size()) / 2.0;
+        double estTimeSec = (avgDuration * outputCount) / 2.0;
         int estMinutes = static_cast<int>(estTimeSec / 60);
         QString timeEst;
         if (estMinutes >= 60) {
@@ -2562,7 +2769,7 @@ void MainWindow::onBatchProcessRequested(JobListBuilder::Algorithm algorithm,
         }
         
         int result2 = BatchConfirmDialog::confirmLargeBatch(
-            this, jobs.size(), sizeEst.formattedSize, timeEst);
+            this, outputCount, sizeEst.formattedSize, timeEst);
         
         if (result2 != QDialog::Accepted) return;
     }
@@ -2574,7 +2781,8 @@ void MainWindow::onBatchProcessRequested(JobListBuilder::Algorithm algorithm,
     qDebug() << "Starting batch:" << jobs.size() << "jobs, algorithm"
              << static_cast<int>(algorithm);
     
-    batchProcessor->start(jobs, ffmpegPath);
+    batchProcessor->setAnalysisFilters(filterChain->hasAnalysisFilters(mutedPositions));
+    batchProcessor->start(jobs, ffmpegPath, outputFolder);
 }
 
 
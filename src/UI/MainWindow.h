@@ -10,6 +10,7 @@
 #include <QFutureWatcher>
 #include <QtConcurrent>
 #include <memory>
+#include <functional>
 #include "Core/AppConfig.h"
 #include "Core/FFmpegRunner.h"
 #include "RotatedLabel.h"
@@ -30,9 +31,11 @@ class FilterChain;
 class BatchProcessor;
 class CommandViewWindow;
 class PreviewGenerator;
+class ChainProfiler;
 class PresetManager;
 class RotatedLabel;
 class QHBoxLayout;
+class QTimer;
 class RotatedLabel;
 class BatchSettingsWindow;
 class RegionPreviewWindow;
@@ -78,6 +81,7 @@ private slots:
     void onPreviewProgress(int percent, const QString& stage);
     void onPreviewFinished(const QString& audioFile, const QString& waveformFile);
     void onPreviewError(const QString& message);
+    void onProfileChain();
     
     // Process button
     void onProcessFiles();
@@ -107,6 +111,7 @@ private:
     void setupKeyCommands();
     void connectSignals();
     void connectAudioInputButtons(class AudioInputFilter* audioInput);
+    void reprobeFiles(class FileListWidget* fileListWidget, const QStringList& filePaths);
     QWidget* showLicenseWindow(const QString& title, const QString& resourcePath);
     QFutureWatcher<QList<FileListWidget::AudioFileInfo>>* m_scanWatcher = nullptr;
 
@@ -114,6 +119,7 @@ private:
     std::shared_ptr<FilterChain> filterChain;
     BatchProcessor* batchProcessor;
     class PreviewGenerator* previewGenerator;
+    ChainProfiler* chainProfiler;
     PresetManager* presetManager;
 
     // Preset state
@@ -160,6 +166,7 @@ private:
     
     // Command viewer window
     CommandViewWindow* commandViewWindow = nullptr;
+    QTimer* m_commandRefreshTimer = nullptr;  // coalesces chain edits
 
     // View Waveform Window
     RegionPreviewWindow* regionPreviewWindow = nullptr;
@@ -176,12 +183,18 @@ private:
 
     // Playback menu
     QAction* m_loopPreviewAction = nullptr;
+    QAction* m_streamPreviewAction = nullptr;
     bool m_autoPlayNextPreview = false;
+    QString m_lastPreviewAudioFile;       // for a region window opened later
+    QString m_lastPreviewWaveformFile;
 
     // Helper
     void checkFFmpegAvailability();
     bool regionWindowIsActive() const;
-    QString buildPreviewCommand();  // Build FFmpeg command for preview
+    RegionPreviewWindow* regionPreview();  // created on first use
+    LogViewWindow* logView();              // created on first use
+    std::function<QString()> previewCommandBuilder();  // FFmpeg command for preview, thread-safe
+    void refreshCommandView();      // Rebuild the command, only while the viewer is open
 
     // License file text windows
     QWidget* lgplWindow = nullptr;
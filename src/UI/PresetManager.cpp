@@ -1,6 +1,7 @@
 // Complete PresetManager.cpp with proper file initialization
-// Files are loaded with default metadata (0 values)
-// User can click "Rescan Metadata" button to update if needed
+// Files are loaded with the metadata stored in the preset; files that changed
+// since (or were never probed) get default metadata and are listed as stale
+// so MainWindow can re-probe just those
 
 #include "PresetManager.h"
 #include "InputPanel.h"
@@ -10,6 +11,7 @@
 #include "../Core/FilterChain.h"
 #include "../Core/AppConfig.h"
 #include "../Filters/AudioInputFilter.h"
+#include "../Core/AudioFileScanner.h"
 
 #include <QFile>
 #include <QDir>
@@ -23,6 +25,7 @@
 #include <QUrl>
 #include <QFileInfo>
 #include <QTextStream>
+#include <QtConcurrent>
 
 PresetManager::PresetManager(QObject* parent) 
     : QObject(parent) 
@@ -54,6 +57,26 @@ bool PresetManager::savePreset(const QString& filepath,
         return false;
     }
     
+    // Compact project: file lists go into packed blocks, not the JSON
+    if (filepath.endsWith("." + ProjectArchive::fileExtension(), Qt::CaseInsensitive)) {
+        QJsonObject json = serializeToJson(presetName, filterChain, inputPanel,
+                                           outputPanel, filterChainWidget, false);
+        QList<ProjectArchive::FileListBlock> fileLists;
+        if (includeFileLists) {
+            QJsonObject fileListsObj;
+            fileListsObj["included"] = true;
+            json["file_lists"] = fileListsObj;
+            fileLists = serializeFileListBlocks(inputPanel, filterChain);
+        }
+        
+        if (!ProjectArchive::write(filepath, json, fileLists)) {
+            qWarning() << "PresetManager::savePreset - failed to write project:" << filepath;
+            return false;
+        }
+        qDebug() << "Project saved successfully:" << filepath;
+        return true;
+    }
+    
     QJsonObject json = serializeToJson(presetName, filterChain, inputPanel, 
                                        outputPanel, filterChainWidget, includeFileLists);
     
@@ -78,12 +101,19 @@ bool PresetManager::loadPreset(const QString& filepath,
                                OutputSettingsPanel* outputPanel,
                                FilterChainWidget* filterChainWidget,
                                MissingFilesInfo& missingInfo,
-                               ProgressCallback progressCallback) {
+                               ProgressCallback progressCallback,
+                               ChainLoadedCallback chainLoadedCallback) {
     if (!filterChain || !inputPanel || !outputPanel || !filterChainWidget) {
         qWarning() << "PresetManager::loadPreset - null pointer passed";
         return false;
     }
     
+    if (ProjectArchive::isArchive(filepath)) {
+        return loadProjectArchive(filepath, filterChain, inputPanel, outputPanel,
+                                  filterChainWidget, missingInfo, progressCallback,
+                                  chainLoadedCallback);
+    }
+    
     QFile file(filepath);
     if (!file.open(QIODevice::ReadOnly)) {
         qWarning() << "PresetManager::loadPreset - failed to open file:" << filepath;
@@ -100,7 +130,49 @@ bool PresetManager::loadPreset(const QString& filepath,
     }
     
     return deserializeFromJson(doc.object(), filterChain, inputPanel, 
-                              outputPanel, filterChainWidget, missingInfo, progressCallback);
+                              outputPanel, filterChainWidget, missingInfo, progressCallback,
+                              chainLoadedCallback);
+}
+
+bool PresetManager::loadProjectArchive(const QString& filepath,
+                                       FilterChain* filterChain,
+                                       InputPanel* inputPanel,
+                                       OutputSettingsPanel* outputPanel,
+                                       FilterChainWidget* filterChainWidget,
+                                       MissingFilesInfo& missingInfo,
+                                       ProgressCallback progressCallback,
+                                       ChainLoadedCallback chainLoadedCallback) {
+    ProjectArchive::Reader reader;
+    if (!reader.open(filepath)) {
+        qWarning() << "PresetManager::loadPreset -" << reader.errorString();
+        return false;
+    }
+    
+    // The document holds everything but the list entries — the chain is
+    // up (and chainLoadedCallback has run) before the first block is read
+    if (!deserializeFromJson(reader.document(), filterChain, inputPanel, outputPanel,
+                             filterChainWidget, missingInfo, progressCallback,
+                             chainLoadedCallback)) {
+        return false;
+    }
+    
+    const int listCount = reader.fileListCount();
+    int listsLoaded = 0;
+    ProjectArchive::FileListBlock block;
+    while (reader.hasNext()) {
+        if (!reader.readNext(&block)) {
+            qWarning() << "PresetManager::loadPreset -" << reader.errorString();
+            break;  // keep the lists already loaded
+        }
+        loadFileListBlock(block, inputPanel, filterChain, missingInfo);
+        
+        if (progressCallback) {
+            progressCallback(++listsLoaded, listCount,
+                             QString("Loading file lists... %1 files").arg(missingInfo.totalFiles));
+        }
+    }
+    
+    return true;
 }
 
 QJsonObject PresetManager::serializeToJson(const QString& presetName,
@@ -142,7 +214,8 @@ bool PresetManager::deserializeFromJson(const QJsonObject& json,
                                         OutputSettingsPanel* outputPanel,
                                         FilterChainWidget* filterChainWidget,
                                         MissingFilesInfo& missingInfo,
-                                        ProgressCallback progressCallback) {
+                                        ProgressCallback progressCallback,
+                                        ChainLoadedCallback chainLoadedCallback) {
     // Version check (warn if newer)
     QString presetVersion = json["ffab_version"].toString();
     if (presetVersion > VERSION_STR) {
@@ -171,6 +244,11 @@ bool PresetManager::deserializeFromJson(const QJsonObject& json,
         deserializeMuteSoloStates(json["mute_solo_states"].toObject(), filterChainWidget);
     }
     
+    // Chain is complete — let the UI show it while file lists load
+    if (chainLoadedCallback) {
+        chainLoadedCallback();
+    }
+    
     // Load file lists (if present)
     if (json.contains("file_lists")) {
         deserializeFileLists(json["file_lists"].toObject(), inputPanel, 
@@ -228,42 +306,47 @@ QJsonObject PresetManager::serializeFileLists(InputPanel* inputPanel, FilterChai
     QJsonObject obj;
     obj["included"] = true;
     
-    // Main file list
-    QJsonArray mainFiles;
-    FileListWidget* mainFileList = inputPanel->getFileListWidget();
-    if (mainFileList) {
-        QList<FileListWidget::AudioFileInfo> files = mainFileList->getAllFiles();
-        for (const auto& file : files) {
-            QJsonObject fileObj;
-            fileObj["path"] = file.filePath;
-            fileObj["enabled"] = file.enabled;
-            mainFiles.append(fileObj);
+    QJsonObject audioInputs;
+    for (const auto& block : serializeFileListBlocks(inputPanel, filterChain)) {
+        QJsonArray array;
+        for (const auto& entry : block.entries) {
+            array.append(entry);
+        }
+        
+        if (block.key == "main") {
+            obj["main_files"] = array;
+        } else {
+            audioInputs[block.key] = array;
         }
     }
-    obj["main_files"] = mainFiles;
+    obj["audio_inputs"] = audioInputs;
+    
+    return obj;
+}
+
+QList<ProjectArchive::FileListBlock> PresetManager::serializeFileListBlocks(InputPanel* inputPanel,
+                                                                          FilterChain* filterChain) {
+    QList<ProjectArchive::FileListBlock> blocks;
+    
+    // Main file list
+    FileListWidget* mainFileList = inputPanel->getFileListWidget();
+    blocks.append({ "main", mainFileList ? serializeFileEntries(mainFileList->getAllFiles())
+                                         : QList<QJsonObject>() });
     
     // AudioInput file lists (main chain + sub-chains)
-    QJsonObject audioInputs;
     for (auto* audioInput : filterChain->getAllAudioInputFilters()) {
-        int inputIndex = audioInput->getInputIndex();
-        QJsonArray inputFiles;
-        
         FileListWidget* inputFileList = audioInput->getFileListWidget();
-        if (inputFileList) {
-            QList<FileListWidget::AudioFileInfo> files = inputFileList->getAllFiles();
-            for (const auto& file : files) {
-                QJsonObject fileObj;
-                fileObj["path"] = file.filePath;
-                fileObj["enabled"] = file.enabled;
-                inputFiles.append(fileObj);
-            }
-        }
-        
-        audioInputs[QString::number(inputIndex)] = inputFiles;
+        blocks.append({ QString::number(audioInput->getInputIndex()),
+                        inputFileList ? serializeFileEntries(inputFileList->getAllFiles())
+                                      : QList<QJsonObject>() });
     }
-    obj["audio_inputs"] = audioInputs;
     
-    return obj;
+    return blocks;
+}
+
+QList<QJsonObject> PresetManager::serializeFileEntries(const QList<FileListWidget::AudioFileInfo>& files) {
+    // One stat per file for the size/mtime stamp — spread across cores
+    return QtConcurrent::blockingMapped(files, &AudioFileScanner::toPresetEntry);
 }
 
 bool PresetManager::deserializeInputSettings(const QJsonObject& json, InputPanel* inputPanel) {
@@ -352,125 +435,104 @@ bool PresetManager::deserializeFileLists(const QJsonObject& json,
     missingInfo.totalFiles = 0;
     missingInfo.foundFiles = 0;
     missingInfo.missingFiles.clear();
+    missingInfo.staleMainFiles.clear();
+    missingInfo.staleAudioInputFiles.clear();
+    
+    // Same blocks a .ffabproj archive stores
+    auto toBlock = [](const QString& key, const QJsonArray& array) {
+        ProjectArchive::FileListBlock block;
+        block.key = key;
+        block.entries.reserve(array.size());
+        for (const auto& val : array) {
+            block.entries.append(val.toObject());
+        }
+        return block;
+    };
     
-    // Count total files first for progress reporting
-    int totalFilesToLoad = 0;
+    QList<ProjectArchive::FileListBlock> blocks;
     if (json.contains("main_files")) {
-        totalFilesToLoad += json["main_files"].toArray().size();
+        blocks.append(toBlock("main", json["main_files"].toArray()));
     }
     if (json.contains("audio_inputs")) {
         QJsonObject audioInputs = json["audio_inputs"].toObject();
         for (const QString& key : audioInputs.keys()) {
-            totalFilesToLoad += audioInputs[key].toArray().size();
+            blocks.append(toBlock(key, audioInputs[key].toArray()));
         }
     }
     
-    int filesProcessed = 0;
+    // Count total files first for progress reporting
+    int totalFilesToLoad = 0;
+    for (const auto& block : blocks) {
+        totalFilesToLoad += block.entries.size();
+    }
     
-    // Load main file list
-    if (json.contains("main_files")) {
-        QJsonArray mainFiles = json["main_files"].toArray();
-        FileListWidget* mainFileList = inputPanel->getFileListWidget();
+    int filesProcessed = 0;
+    for (const auto& block : blocks) {
+        loadFileListBlock(block, inputPanel, filterChain, missingInfo);
         
-        if (mainFileList) {
-            mainFileList->clearFiles();
-            
-            for (const auto& fileVal : mainFiles) {
-                QJsonObject fileObj = fileVal.toObject();
-                QString path = fileObj["path"].toString();
-                bool enabled = fileObj["enabled"].toBool();
-                
-                missingInfo.totalFiles++;
-                
-                if (QFile::exists(path)) {
-                    // File exists - add it with proper default values
-                    FileListWidget::AudioFileInfo info;
-                    info.filePath = path;
-                    info.fileName = QFileInfo(path).fileName();
-                    info.enabled = enabled;
-                    info.format = QFileInfo(path).suffix().toUpper();
-                    info.duration = "00:00:00";
-                    info.sampleRate = 0;
-                    info.bitsPerSample = 0;
-                    info.channels = 0;
-                    info.bitrate = 0;
-                    mainFileList->addFile(info);
-                    missingInfo.foundFiles++;
-                } else {
-                    // File missing
-                    missingInfo.missingFiles.append(path);
-                }
-                
-                filesProcessed++;
-                
-                // Update progress every 10 files or at the end
-                if (progressCallback && (filesProcessed % 10 == 0 || filesProcessed == totalFilesToLoad)) {
-                    progressCallback(filesProcessed, totalFilesToLoad, 
-                                   QString("Loading files... %1/%2").arg(filesProcessed).arg(totalFilesToLoad));
-                    // QApplication::processEvents();  // Keep UI responsive
-                }
-            }
+        filesProcessed += block.entries.size();
+        if (progressCallback) {
+            progressCallback(filesProcessed, totalFilesToLoad,
+                           QString("Loading files... %1/%2").arg(filesProcessed).arg(totalFilesToLoad));
         }
     }
     
-    // Load AudioInput file lists (main chain + sub-chains)
-    if (json.contains("audio_inputs")) {
-        QJsonObject audioInputs = json["audio_inputs"].toObject();
-        
+    return true;
+}
+
+void PresetManager::loadFileListBlock(const ProjectArchive::FileListBlock& block,
+                                      InputPanel* inputPanel,
+                                      FilterChain* filterChain,
+                                      MissingFilesInfo& missingInfo) {
+    FileListWidget* fileList = nullptr;
+    QStringList* stalePaths = nullptr;
+    
+    if (block.key == "main") {
+        fileList = inputPanel->getFileListWidget();
+        stalePaths = &missingInfo.staleMainFiles;
+    } else {
+        // AudioInput file lists (main chain + sub-chains), keyed by input index
         for (auto* audioInput : filterChain->getAllAudioInputFilters()) {
             int inputIndex = audioInput->getInputIndex();
-            QString indexKey = QString::number(inputIndex);
+            if (QString::number(inputIndex) != block.key) continue;
+            
+            // CRITICAL: Ensure parameter widget is created before accessing FileListWidget
+            audioInput->getParametersWidget();
             
-            if (audioInputs.contains(indexKey)) {
-                QJsonArray inputFiles = audioInputs[indexKey].toArray();
-                
-                // CRITICAL: Ensure parameter widget is created before accessing FileListWidget
-                audioInput->getParametersWidget();
-                
-                FileListWidget* inputFileList = audioInput->getFileListWidget();
-                
-                if (inputFileList) {
-                    inputFileList->clearFiles();
-                    
-                    for (const auto& fileVal : inputFiles) {
-                        QJsonObject fileObj = fileVal.toObject();
-                        QString path = fileObj["path"].toString();
-                        bool enabled = fileObj["enabled"].toBool();
-                        
-                        missingInfo.totalFiles++;
-                        
-                        if (QFile::exists(path)) {
-                            FileListWidget::AudioFileInfo info;
-                            info.filePath = path;
-                            info.fileName = QFileInfo(path).fileName();
-                            info.enabled = enabled;
-                            info.format = QFileInfo(path).suffix().toUpper();
-                            info.duration = "00:00:00";
-                            info.sampleRate = 0;
-                            info.bitsPerSample = 0;
-                            info.channels = 0;
-                            info.bitrate = 0;
-                            inputFileList->addFile(info);
-                            missingInfo.foundFiles++;
-                        } else {
-                            missingInfo.missingFiles.append(path);
-                        }
-                        
-                        filesProcessed++;
-                        
-                        // Update progress every 10 files or at the end
-                        if (progressCallback && (filesProcessed % 10 == 0 || filesProcessed == totalFilesToLoad)) {
-                            progressCallback(filesProcessed, totalFilesToLoad, 
-                                           QString("Loading files... %1/%2").arg(filesProcessed).arg(totalFilesToLoad));
-                            // QApplication::processEvents();  // Keep UI responsive
-                        }
-                    }
-                }
-            }
+            fileList = audioInput->getFileListWidget();
+            stalePaths = &missingInfo.staleAudioInputFiles[inputIndex];
+            break;
         }
     }
     
-    return true;
+    if (!fileList) return;  // List has no AudioInput in this chain
+    
+    auto files = resolveFileEntries(block.entries, missingInfo, stalePaths);
+    fileList->clearFiles();
+    fileList->addFiles(files);
+}
+
+QList<FileListWidget::AudioFileInfo> PresetManager::resolveFileEntries(const QList<QJsonObject>& entries,
+                                                                       MissingFilesInfo& missingInfo,
+                                                                       QStringList* stalePaths) {
+    // Existence + size/mtime checks are independent stats — on network
+    // volumes the latency dominates, so run them in parallel
+    const QList<AudioFileScanner::PresetEntry> resolved =
+        QtConcurrent::blockingMapped(entries, &AudioFileScanner::fromPresetEntry);
+    
+    QList<FileListWidget::AudioFileInfo> files;
+    files.reserve(resolved.size());
+    for (const auto& entry : resolved) {
+        missingInfo.totalFiles++;
+        if (!entry.exists) {
+            missingInfo.missingFiles.append(entry.info.filePath);
+            continue;
+        }
+        missingInfo.foundFiles++;
+        files.append(entry.info);
+        if (!entry.fresh && stalePaths) stalePaths->append(entry.info.filePath);
+    }
+    return files;
 }
 
 void PresetManager::writeMissingFilesReport(const MissingFilesInfo& info) {
@@ -3,8 +3,12 @@
 #include <QString>
 #include <QJsonObject>
 #include <QStringList>
+#include <QJsonArray>
+#include <QHash>
 #include <QWidget>
 #include <functional>
+#include "FileListWidget.h"
+#include "Core/ProjectArchive.h"
 
 class FilterChain;
 class InputPanel;
@@ -19,9 +23,13 @@ class FilterChainWidget;
  * - Output settings (format, bitrate, bit depth, etc.)
  * - Complete filter chain with all parameters
  * - Mute/Solo button states (position-based)
- * - File lists (main + all AudioInput file lists) - optional
+ * - File lists (main + all AudioInput file lists) - optional, with probe
+ *   metadata and size/mtime so unchanged files load without ffprobe
  * 
- * File format: .ffabjson (JSON format, human-readable)
+ * File formats: .ffabjson (JSON format, human-readable)
+ *               .ffabproj (ProjectArchive — compact, file lists packed and
+ *                          compressed; loads the chain before the lists)
+ * Loading detects the format from the file contents.
  * Default location: ~/Documents/FFAB/Presets/
  */
 class PresetManager : public QObject {
@@ -33,6 +41,10 @@ public:
     // Progress callback: (current, total, message)
     using ProgressCallback = std::function<void(int, int, const QString&)>;
     
+    // Called once the chain and mute/solo states are restored, before any
+    // file list is loaded
+    using ChainLoadedCallback = std::function<void()>;
+    
     struct PresetData {
         QString version;
         QString presetName;
@@ -49,6 +61,11 @@ public:
         QStringList missingFiles;
         int totalFiles = 0;
         int foundFiles = 0;
+        
+        // Found files without usable stored metadata (changed on disk, or
+        // never probed) — candidates for a background re-probe
+        QStringList staleMainFiles;
+        QHash<int, QStringList> staleAudioInputFiles;  // by AudioInput index
     };
     
     // Save preset to file
@@ -67,7 +84,8 @@ public:
                    OutputSettingsPanel* outputPanel,
                    FilterChainWidget* filterChainWidget,
                    MissingFilesInfo& missingInfo,
-                   ProgressCallback progressCallback = nullptr);
+                   ProgressCallback progressCallback = nullptr,
+                   ChainLoadedCallback chainLoadedCallback = nullptr);
     
     // Get default presets directory (creates if needed)
     static QString getDefaultPresetsDirectory();
@@ -97,7 +115,18 @@ private:
                             OutputSettingsPanel* outputPanel,
                             FilterChainWidget* filterChainWidget,
                             MissingFilesInfo& missingInfo,
-                            ProgressCallback progressCallback);
+                            ProgressCallback progressCallback,
+                            ChainLoadedCallback chainLoadedCallback);
+    
+    // .ffabproj: document first, then file list blocks one at a time
+    bool loadProjectArchive(const QString& filepath,
+                            FilterChain* filterChain,
+                            InputPanel* inputPanel,
+                            OutputSettingsPanel* outputPanel,
+                            FilterChainWidget* filterChainWidget,
+                            MissingFilesInfo& missingInfo,
+                            ProgressCallback progressCallback,
+                            ChainLoadedCallback chainLoadedCallback);
     
     // Helper methods
     QJsonObject serializeInputSettings(InputPanel* inputPanel);
@@ -113,4 +142,17 @@ private:
                              FilterChain* filterChain,
                              MissingFilesInfo& missingInfo,
                              ProgressCallback progressCallback);
+    
+    // File list entries ↔ JSON, with cached probe metadata (see
+    // AudioFileScanner::toPresetEntry). Loading checks all files in
+    // parallel and fills each list with a single bulk insert.
+    QList<ProjectArchive::FileListBlock> serializeFileListBlocks(InputPanel* inputPanel, FilterChain* filterChain);
+    static QList<QJsonObject> serializeFileEntries(const QList<FileListWidget::AudioFileInfo>& files);
+    void loadFileListBlock(const ProjectArchive::FileListBlock& block,
+                           InputPanel* inputPanel,
+                           FilterChain* filterChain,
+                           MissingFilesInfo& missingInfo);
+    static QList<FileListWidget::AudioFileInfo> resolveFileEntries(const QList<QJsonObject>& entries,
+                                                                   MissingFilesInfo& missingInfo,
+                                                                   QStringList* stalePaths);
 };
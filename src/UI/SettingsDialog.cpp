@@ -15,6 +15,7 @@
 #include <QSettings>
 #include <QThread>
 #include <QCheckBox>
+#include <QComboBox>
 #include <QRadioButton>
 #include <QButtonGroup>
 #include <QFrame>
@@ -93,6 +94,82 @@ SettingsDialog::SettingsDialog(QWidget* parent, UpdateChecker* checker)
     pathForm->addRow(pathInfo);
 
     procLayout->addWidget(pathGroup);
+
+    // --- Output files ---
+    auto* outputGroup = new QGroupBox("Output Files");
+    auto* outputForm = new QFormLayout(outputGroup);
+
+    m_atomicOutputCheck = new QCheckBox("Write to a temp file, rename when done");
+    outputForm->addRow(m_atomicOutputCheck);
+
+    m_preallocateCheck = new QCheckBox("Preallocate WAV / AIFF / CAF outputs");
+    m_preallocateCheck->setContentsMargins(20, 0, 0, 0);
+    outputForm->addRow(m_preallocateCheck);
+
+    auto* outputInfo = new QLabel(
+        "<small>A cancelled or failed job leaves no partial file behind. "
+        "Preallocation reserves each file's estimated size up front to "
+        "reduce fragmentation on busy disks (macOS and Linux).</small>");
+    outputInfo->setStyleSheet("color: #808080;");
+    outputInfo->setWordWrap(true);
+    outputForm->addRow(outputInfo);
+
+    connect(m_atomicOutputCheck, &QCheckBox::toggled, m_preallocateCheck, &QCheckBox::setEnabled);
+
+    m_minFreeSpaceSpin = new QSpinBox();
+    m_minFreeSpaceSpin->setRange(0, 1024 * 1024);
+    m_minFreeSpaceSpin->setSingleStep(256);
+    m_minFreeSpaceSpin->setSuffix(" MB");
+    m_minFreeSpaceSpin->setSpecialValueText("Off");
+    m_minFreeSpaceSpin->setMinimumHeight(24);
+    outputForm->addRow("Pause when free space is below:", m_minFreeSpaceSpin);
+
+    m_adaptiveWritersCheck = new QCheckBox("Limit concurrent writers to what the disk sustains");
+    outputForm->addRow(m_adaptiveWritersCheck);
+
+    auto* admissionInfo = new QLabel(
+        "<small>Each job is checked against the estimated output size before it "
+        "starts. Writers per disk are capped where more of them stopped raising "
+        "the measured write speed.</small>");
+    admissionInfo->setStyleSheet("color: #808080;");
+    admissionInfo->setWordWrap(true);
+    outputForm->addRow(admissionInfo);
+
+    procLayout->addWidget(outputGroup);
+
+    // --- Input decoding ---
+    auto* inputGroup = new QGroupBox("Input Files");
+    auto* inputForm = new QFormLayout(inputGroup);
+
+    m_decodeCacheCheck = new QCheckBox("Decode shared compressed inputs once per batch");
+    inputForm->addRow(m_decodeCacheCheck);
+
+    auto* decodeCacheInfo = new QLabel(
+        "<small>Cartesian and Broadcast read the same MP3 / FLAC / M4A file in "
+        "many jobs. Each is decoded once to a temporary WAV, which is deleted "
+        "after its last job. Needs temp space for the decoded files.</small>");
+    decodeCacheInfo->setStyleSheet("color: #808080;");
+    decodeCacheInfo->setWordWrap(true);
+    inputForm->addRow(decodeCacheInfo);
+
+    procLayout->addWidget(inputGroup);
+
+    // --- Startup ---
+    auto* startupGroup = new QGroupBox("Startup");
+    auto* startupForm = new QFormLayout(startupGroup);
+
+    m_fastStartupCheck = new QCheckBox("Fast startup");
+    startupForm->addRow(m_fastStartupCheck);
+
+    auto* startupInfo = new QLabel(
+        "<small>Show the window first and load the Fira Code font afterwards. "
+        "Helps on slow machines; text briefly uses the system font. "
+        "Takes effect on next launch.</small>");
+    startupInfo->setStyleSheet("color: #808080;");
+    startupInfo->setWordWrap(true);
+    startupForm->addRow(startupInfo);
+
+    procLayout->addWidget(startupGroup);
     procLayout->addStretch();
 
     tabs->addTab(processingPage, "Processing");
@@ -223,6 +300,44 @@ SettingsDialog::SettingsDialog(QWidget* parent, UpdateChecker* checker)
     logSep2->setFrameShadow(QFrame::Sunken);
     logFileLayout->addWidget(logSep2);
 
+    // --- Analysis results CSV ---
+    m_analysisResultsCheck = new QCheckBox("Save analysis results to CSV");
+    logFileLayout->addWidget(m_analysisResultsCheck);
+
+    auto* analysisResultsInfo = new QLabel(
+        "<small>When the chain contains astats, volumedetect, silencedetect, "
+        "drmeter or replaygain, each batch writes one row per file "
+        "to _FFAB_analysis_*.csv in the OUTPUT folder. Independent of the log file.</small>");
+    analysisResultsInfo->setStyleSheet("color: #808080;");
+    analysisResultsInfo->setWordWrap(true);
+    logFileLayout->addWidget(analysisResultsInfo);
+
+    // --- Batch metrics export ---
+    auto* metricsRow = new QHBoxLayout();
+    metricsRow->addWidget(new QLabel("Batch metrics file:"));
+    m_metricsFormatCombo = new QComboBox();
+    m_metricsFormatCombo->addItem("Off", "off");
+    m_metricsFormatCombo->addItem("JSON lines", "jsonl");
+    m_metricsFormatCombo->addItem("Prometheus text", "prometheus");
+    metricsRow->addWidget(m_metricsFormatCombo);
+    metricsRow->addStretch();
+    logFileLayout->addLayout(metricsRow);
+
+    auto* metricsInfo = new QLabel(
+        "<small>Throughput telemetry sampled once a second: realtime factor, "
+        "files/min, queue depth, worker utilization and ETA. JSON lines append to "
+        "_FFAB_metrics_*.jsonl; Prometheus text replaces _FFAB_metrics.prom "
+        "(for a textfile collector). Written to the OUTPUT folder.</small>");
+    metricsInfo->setStyleSheet("color: #808080;");
+    metricsInfo->setWordWrap(true);
+    logFileLayout->addWidget(metricsInfo);
+
+    // Separator
+    auto* logSep3 = new QFrame();
+    logSep3->setFrameShape(QFrame::HLine);
+    logSep3->setFrameShadow(QFrame::Sunken);
+    logFileLayout->addWidget(logSep3);
+
     // Info labels
     auto* logFileInfo1 = new QLabel(
         "<small>Log files are saved as tab-separated TXT in the "
@@ -436,6 +551,13 @@ void SettingsDialog::loadSettings() {
         settings.value("processing/maxConcurrent", qMax(1, cpuCores / 2)).toInt());
     m_ffmpegPathEdit->setText(
         settings.value("processing/ffmpegPath", "/usr/local/bin/ffmpeg").toString());
+    m_atomicOutputCheck->setChecked(settings.value("processing/atomicOutput", true).toBool());
+    m_preallocateCheck->setChecked(settings.value("processing/preallocateOutput", false).toBool());
+    m_preallocateCheck->setEnabled(m_atomicOutputCheck->isChecked());
+    m_minFreeSpaceSpin->setValue(settings.value("processing/minFreeSpaceMB", 1024).toInt());
+    m_adaptiveWritersCheck->setChecked(settings.value("processing/adaptiveWriters", true).toBool());
+    m_decodeCacheCheck->setChecked(settings.value("processing/decodeCache", false).toBool());
+    m_fastStartupCheck->setChecked(settings.value("startup/fastStartup", false).toBool());
 
     // Log Level tab
     m_showBannerCheck->setChecked(settings.value("log/showBanner", false).toBool());
@@ -446,6 +568,9 @@ void SettingsDialog::loadSettings() {
     m_saveLogCheck->setChecked(settings.value("log/saveToFile", false).toBool());
     m_logPreviewCheck->setChecked(settings.value("log/logPreview", false).toBool());
     m_logViewWindowCheck->setChecked(settings.value("log/openViewLog", true).toBool());
+    m_analysisResultsCheck->setChecked(settings.value("log/analysisResults", true).toBool());
+    int metricsIndex = m_metricsFormatCombo->findData(settings.value("log/metricsFormat", "off").toString());
+    m_metricsFormatCombo->setCurrentIndex(qMax(0, metricsIndex));
 
     // Apply enabled state
     m_logPreviewCheck->setEnabled(m_saveLogCheck->isChecked());
@@ -473,6 +598,12 @@ void SettingsDialog::saveSettings() {
     // Processing tab
     settings.setValue("processing/maxConcurrent", m_concurrentSpin->value());
     settings.setValue("processing/ffmpegPath", m_ffmpegPathEdit->text().trimmed());
+    settings.setValue("processing/atomicOutput", m_atomicOutputCheck->isChecked());
+    settings.setValue("processing/preallocateOutput", m_preallocateCheck->isChecked());
+    settings.setValue("processing/minFreeSpaceMB", m_minFreeSpaceSpin->value());
+    settings.setValue("processing/adaptiveWriters", m_adaptiveWritersCheck->isChecked());
+    settings.setValue("processing/decodeCache", m_decodeCacheCheck->isChecked());
+    settings.setValue("startup/fastStartup", m_fastStartupCheck->isChecked());
 
     // Log Level tab
     settings.setValue("log/showBanner", m_showBannerCheck->isChecked());
@@ -483,6 +614,8 @@ void SettingsDialog::saveSettings() {
     settings.setValue("log/saveToFile", m_saveLogCheck->isChecked());
     settings.setValue("log/logPreview", m_logPreviewCheck->isChecked());
     settings.setValue("log/openViewLog", m_logViewWindowCheck->isChecked());
+    settings.setValue("log/analysisResults", m_analysisResultsCheck->isChecked());
+    settings.setValue("log/metricsFormat", m_metricsFormatCombo->currentData().toString());
 
     // Updates tab
     if (m_updateChecker) {
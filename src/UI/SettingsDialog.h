@@ -5,6 +5,7 @@
 class QSpinBox;
 class QLineEdit;
 class QCheckBox;
+class QComboBox;
 class QButtonGroup;
 class QTabWidget;
 class QLabel;
@@ -34,6 +35,12 @@ private:
     // Processing tab widgets
     QSpinBox* m_concurrentSpin = nullptr;
     QLineEdit* m_ffmpegPathEdit = nullptr;
+    QSpinBox* m_minFreeSpaceSpin = nullptr;
+    QCheckBox* m_adaptiveWritersCheck = nullptr;
+    QCheckBox* m_atomicOutputCheck = nullptr;
+    QCheckBox* m_preallocateCheck = nullptr;
+    QCheckBox* m_decodeCacheCheck = nullptr;
+    QCheckBox* m_fastStartupCheck = nullptr;
 
     // Log Level tab widgets
     QCheckBox* m_showBannerCheck = nullptr;
@@ -44,6 +51,8 @@ private:
     QCheckBox* m_saveLogCheck = nullptr;
     QCheckBox* m_logPreviewCheck = nullptr;
     QCheckBox* m_logViewWindowCheck = nullptr;
+    QCheckBox* m_analysisResultsCheck = nullptr;
+    QComboBox* m_metricsFormatCombo = nullptr;
 
     // Updates tab widgets
     QCheckBox* m_checkWeeklyCheck = nullptr;
@@ -5,7 +5,13 @@
 #include <QPainter>
 #include <QMouseEvent>
 #include <QStyle>
+#include <QMediaDevices>
+#include <QAudioDevice>
+#include <QAudioFormat>
+#include <QtMath>
+#include <cstring>
 #include "Utils/UnicodeSymbols.h"
+#include "Core/PreviewGenerator.h"
 
 WaveformPreviewWidget::WaveformPreviewWidget(QWidget* parent) 
     : QWidget(parent), duration(0) {
@@ -79,6 +85,11 @@ WaveformPreviewWidget::WaveformPreviewWidget(QWidget* parent)
     connect(mediaPlayer, &QMediaPlayer::positionChanged, this, &WaveformPreviewWidget::onPositionChanged);
     connect(mediaPlayer, &QMediaPlayer::durationChanged, this, &WaveformPreviewWidget::onDurationChanged);
     connect(mediaPlayer, &QMediaPlayer::playbackStateChanged, this, &WaveformPreviewWidget::onPlaybackStateChanged);
+
+    // Streaming preview: feed the sink and refresh the growing waveform
+    m_streamTimer = new QTimer(this);
+    m_streamTimer->setInterval(40);
+    connect(m_streamTimer, &QTimer::timeout, this, &WaveformPreviewWidget::feedStream);
 }
 
 void WaveformPreviewWidget::setPreviewFile(const QString& audioFilePath, const QString& waveformImagePath) {
@@ -90,6 +101,16 @@ void WaveformPreviewWidget::setPreviewFile(const QString& audioFilePath, const Q
     }
 
     waveformCanvas->setPixmap(waveformImage);
+
+    // Streaming playback in progress: keep it running and let the rendered
+    // file take over once the sink drains (see feedStream)
+    if (m_streamSink) {
+        mediaPlayer->setSource(QUrl::fromLocalFile(audioFilePath));
+        m_streamFileReady = true;
+        qDebug() << "Preview loaded (streaming):" << audioFilePath;
+        return;
+    }
+
     waveformCanvas->playheadProgress = -1.0;  // No playhead yet
 
     // Force reload
@@ -105,6 +126,7 @@ void WaveformPreviewWidget::setPreviewFile(const QString& audioFilePath, const Q
 }
 
 void WaveformPreviewWidget::clearPreview() {
+    stopStream();
     mediaPlayer->stop();
     mediaPlayer->setSource(QUrl());
     
@@ -130,6 +152,14 @@ void WaveformPreviewWidget::setCanvasVisible(bool visible) {
 }
 
 void WaveformPreviewWidget::onPlayClicked() {
+    if (m_streamSink) {
+        stopStream();
+        playButton->setIcon(Sym::playIcon());
+        waveformCanvas->playheadProgress = -1.0;
+        waveformCanvas->update();
+        return;
+    }
+
     if (mediaPlayer->playbackState() == QMediaPlayer::PlayingState) {
         mediaPlayer->stop();
         mediaPlayer->setPosition(0);
@@ -146,6 +176,12 @@ void WaveformPreviewWidget::onPlayClicked() {
 
 void WaveformPreviewWidget::stop() {
     // Always stop playback (not a toggle like onPlayClicked)
+    if (m_streamSink) {
+        stopStream();
+        playButton->setIcon(Sym::playIcon());
+        waveformCanvas->playheadProgress = -1.0;
+        waveformCanvas->update();
+    }
     if (mediaPlayer->playbackState() != QMediaPlayer::StoppedState) {
         mediaPlayer->stop();
         mediaPlayer->setPosition(0);
@@ -207,6 +243,11 @@ bool WaveformPreviewWidget::eventFilter(QObject* obj, QEvent* event) {
 }
 
 void WaveformPreviewWidget::onWaveformClicked(QMouseEvent* event) {
+    if (m_streamSink) {
+        // Can't seek within a stream — wait for the rendered file
+        if (!m_streamFileReady) return;
+        stopStream();
+    }
     if (duration == 0 || waveformImage.isNull()) return;
     
     // Calculate position from click
@@ -230,3 +271,208 @@ void WaveformPreviewWidget::onPlaybackStateChanged(QMediaPlayer::PlaybackState s
         waveformCanvas->update();
     }
 }
+
+// ========== STREAMING PREVIEW ==========
+
+bool WaveformPreviewWidget::beginStream(int sampleRate, int channels, const QString& pcmFile) {
+    stopStream();
+    mediaPlayer->stop();
+    mediaPlayer->setSource(QUrl());
+
+    QAudioFormat format;
+    format.setSampleRate(sampleRate);
+    format.setChannelCount(channels);
+    format.setSampleFormat(QAudioFormat::Float);
+
+    QAudioDevice device = QMediaDevices::defaultAudioOutput();
+    if (!device.isFormatSupported(format)) {
+        qWarning() << "Streaming preview: output device does not support"
+                   << sampleRate << "Hz" << channels << "ch float — falling back to file playback";
+        return false;
+    }
+
+    m_streamSampleRate = sampleRate;
+    m_streamChannels = channels;
+    m_streamPeakBlockFrames = qMax(1, sampleRate / 100);
+    m_streamBlockPeak = QVector<float>(channels, 0.0f);
+    m_streamSource.setFileName(pcmFile);
+
+    m_streamSink = new QAudioSink(device, format, this);
+    m_streamSink->setVolume(audioOutput->volume());
+
+    duration = 0;
+    waveformCanvas->playheadProgress = 0.0;
+    playButton->setEnabled(true);
+    playButton->setIcon(Sym::stopIcon());
+    emit playbackStarted();
+
+    m_streamTimer->start();
+    return true;
+}
+
+void WaveformPreviewWidget::appendStreamData(const QByteArray& pcm) {
+    if (!m_streamSink) return;
+
+    // ffmpeg renders far faster than realtime — past the cap, playback
+    // catches up from the file instead of buffering the whole render
+    const qint64 maxBufferBytes = static_cast<qint64>(m_streamSampleRate) * m_streamChannels
+                                  * static_cast<qint64>(sizeof(float)) * kStreamMaxBufferMs / 1000;
+    if (m_streamQueuedBytes == m_streamReceivedBytes
+        && m_streamPending.size() + pcm.size() <= maxBufferBytes) {
+        m_streamPending += pcm;
+        m_streamQueuedBytes += pcm.size();
+    }
+    m_streamReceivedBytes += pcm.size();
+
+    // Peaks from whole frames only; a split frame waits for the next chunk
+    const int frameBytes = m_streamChannels * static_cast<int>(sizeof(float));
+    QByteArray data = m_streamRemainder + pcm;
+    const qint64 frames = data.size() / frameBytes;
+    const char* ptr = data.constData();
+
+    for (qint64 f = 0; f < frames; ++f) {
+        for (int c = 0; c < m_streamChannels; ++c) {
+            float sample;
+            std::memcpy(&sample, ptr + f * frameBytes + c * sizeof(float), sizeof(float));
+            m_streamBlockPeak[c] = qMax(m_streamBlockPeak[c], qAbs(sample));
+        }
+        if (++m_streamBlockFrames == m_streamPeakBlockFrames) {
+            m_streamPeaks += m_streamBlockPeak;
+            m_streamBlockPeak.fill(0.0f);
+            m_streamBlockFrames = 0;
+            m_streamDirty = true;
+        }
+    }
+    m_streamRemainder = data.mid(frames * frameBytes);
+    m_streamReceivedFrames += frames;
+
+    // Start the sink once a short buffer is in hand
+    if (!m_streamDevice &&
+        m_streamReceivedFrames >= static_cast<qint64>(m_streamSampleRate) * kStreamPrebufferMs / 1000) {
+        m_streamDevice = m_streamSink->start();
+        feedStream();
+    }
+}
+
+void WaveformPreviewWidget::feedStream() {
+    if (!m_streamSink) return;
+
+    refillStreamFromFile();
+
+    if (m_streamDevice && !m_streamPending.isEmpty()) {
+        const int frameBytes = m_streamChannels * static_cast<int>(sizeof(float));
+        qint64 writable = qMin<qint64>(m_streamSink->bytesFree(), m_streamPending.size());
+        writable -= writable % frameBytes;
+        if (writable > 0) {
+            qint64 written = m_streamDevice->write(m_streamPending.constData(), writable);
+            if (written > 0) m_streamPending.remove(0, written);
+        }
+    }
+
+    if (m_streamDirty) {
+        redrawStreamWaveform();
+        m_streamDirty = false;
+    }
+
+    // Playhead + time label against what has been rendered so far
+    if (m_streamDevice && m_streamSampleRate > 0) {
+        qint64 playedMs = m_streamSink->processedUSecs() / 1000;
+        if (!m_streamFileReady) {
+            duration = m_streamReceivedFrames * 1000 / m_streamSampleRate;
+        }
+        onPositionChanged(qMin(playedMs, duration));
+    }
+
+    // Stream played out and the rendered file is loaded — hand off
+    if (m_streamFileReady && m_streamDevice && m_streamPending.isEmpty() &&
+        m_streamQueuedBytes == m_streamReceivedBytes &&
+        m_streamSink->state() == QAudio::IdleState) {
+        stopStream();
+        if (m_looping) {
+            mediaPlayer->setPosition(0);
+            mediaPlayer->play();
+        } else {
+            playButton->setIcon(Sym::playIcon());
+            waveformCanvas->playheadProgress = -1.0;
+            waveformCanvas->update();
+        }
+    }
+}
+
+void WaveformPreviewWidget::refillStreamFromFile() {
+    if (m_streamQueuedBytes == m_streamReceivedBytes) return;
+
+    // Top up to half the cap once the sink has drained below it
+    const qint64 maxBufferBytes = static_cast<qint64>(m_streamSampleRate) * m_streamChannels
+                                  * static_cast<qint64>(sizeof(float)) * kStreamMaxBufferMs / 1000;
+    if (m_streamPending.size() >= maxBufferBytes / 2) return;
+
+    if (!m_streamSource.isOpen() && !m_streamSource.open(QIODevice::ReadOnly)) {
+        qWarning() << "Streaming preview: cannot read back" << m_streamSource.fileName();
+        m_streamQueuedBytes = m_streamReceivedBytes;  // play what is buffered, then hand off
+        return;
+    }
+
+    const qint64 wanted = qMin(maxBufferBytes - m_streamPending.size(),
+                               m_streamReceivedBytes - m_streamQueuedBytes);
+    if (!m_streamSource.seek(PreviewGenerator::kStreamDataOffset + m_streamQueuedBytes)) return;
+    const QByteArray chunk = m_streamSource.read(wanted);
+    m_streamPending += chunk;
+    m_streamQueuedBytes += chunk.size();
+}
+
+void WaveformPreviewWidget::stopStream() {
+    if (m_streamTimer) m_streamTimer->stop();
+
+    if (m_streamSink) {
+        m_streamSink->stop();
+        m_streamSink->deleteLater();
+        m_streamSink = nullptr;
+    }
+    m_streamDevice = nullptr;
+
+    m_streamPending.clear();
+    m_streamSource.close();
+    m_streamReceivedBytes = 0;
+    m_streamQueuedBytes = 0;
+    m_streamRemainder.clear();
+    m_streamPeaks.clear();
+    m_streamBlockPeak.clear();
+    m_streamBlockFrames = 0;
+    m_streamReceivedFrames = 0;
+    m_streamDirty = false;
+    m_streamFileReady = false;
+}
+
+void WaveformPreviewWidget::redrawStreamWaveform() {
+    // The showwavespic PNG replaces this once the render finishes
+    if (m_streamFileReady || m_streamChannels <= 0) return;
+
+    const int blocks = m_streamPeaks.size() / m_streamChannels;
+    if (blocks == 0) return;
+
+    QPixmap pixmap(800, 120);
+    pixmap.fill(QColor(42, 42, 42));
+    QPainter painter(&pixmap);
+    painter.setPen(QColor("#838172"));
+
+    // One lane per channel (matches showwavespic split_channels=1, scale=sqrt)
+    const int laneHeight = pixmap.height() / m_streamChannels;
+    for (int x = 0; x < pixmap.width(); ++x) {
+        int first = static_cast<int>(static_cast<qint64>(x) * blocks / pixmap.width());
+        int last = qMax(first + 1, static_cast<int>(static_cast<qint64>(x + 1) * blocks / pixmap.width()));
+        for (int c = 0; c < m_streamChannels; ++c) {
+            float peak = 0.0f;
+            for (int b = first; b < last && b < blocks; ++b) {
+                peak = qMax(peak, m_streamPeaks[b * m_streamChannels + c]);
+            }
+            int half = static_cast<int>(qSqrt(qMin(peak, 1.0f)) * (laneHeight / 2));
+            int centre = c * laneHeight + laneHeight / 2;
+            painter.drawLine(x, centre - half, x, centre + half);
+        }
+    }
+    painter.end();
+
+    waveformImage = pixmap;
+    waveformCanvas->setPixmap(pixmap);
+}
@@ -6,6 +6,10 @@
 #include <QLabel>
 #include <QMediaPlayer>
 #include <QAudioOutput>
+#include <QAudioSink>
+#include <QTimer>
+#include <QFile>
+#include <QVector>
 #include <QPixmap>
 #include <QPainter>
 #include <QPainterPath>
@@ -62,6 +66,17 @@ public:
     void stop();
 
     void setLooping(bool loop) { m_looping = loop; mediaPlayer->setLoops(loop ? QMediaPlayer::Infinite : 1); }
+
+    // ========== Streaming Preview ==========
+    // Plays interleaved float PCM as PreviewGenerator renders it and draws the
+    // waveform progressively. When the rendered file arrives via setPreviewFile()
+    // it takes over for seeking/looping once the stream has played out.
+    // At most kStreamMaxBufferMs is held in memory; the rest is read back from
+    // pcmFile (the temp WAV the generator writes as it renders).
+    // Returns false if the output device can't play the format.
+    bool beginStream(int sampleRate, int channels, const QString& pcmFile);
+    void appendStreamData(const QByteArray& pcm);
+    bool isStreaming() const { return m_streamSink != nullptr; }
     
 signals:
     void generatePreviewRequested();
@@ -92,6 +107,33 @@ private:
 
     bool m_looping = false;
 
+    // Streaming state
+    void feedStream();
+    void refillStreamFromFile();
+    void stopStream();
+    void redrawStreamWaveform();
+
+    static constexpr int kStreamPrebufferMs = 150;     // Audio buffered before the sink starts
+    static constexpr int kStreamMaxBufferMs = 5000;    // Beyond this, PCM is read back from the file
+
+    QAudioSink* m_streamSink = nullptr;
+    QIODevice* m_streamDevice = nullptr;   // Push-mode device, owned by the sink
+    QTimer* m_streamTimer = nullptr;
+    QByteArray m_streamPending;            // Received but not yet written to the sink
+    QFile m_streamSource;                  // Temp WAV, read when the stream outran the buffer
+    qint64 m_streamReceivedBytes = 0;      // PCM bytes rendered so far
+    qint64 m_streamQueuedBytes = 0;        // ... of which went into m_streamPending
+    QByteArray m_streamRemainder;          // Partial frame carried into the next chunk
+    QVector<float> m_streamPeaks;          // Per-block peaks, interleaved by channel
+    QVector<float> m_streamBlockPeak;      // Peaks of the block being accumulated
+    int m_streamBlockFrames = 0;
+    int m_streamPeakBlockFrames = 0;       // One waveform peak per 10 ms
+    int m_streamSampleRate = 0;
+    int m_streamChannels = 0;
+    qint64 m_streamReceivedFrames = 0;
+    bool m_streamDirty = false;            // New peaks since last redraw
+    bool m_streamFileReady = false;        // setPreviewFile() arrived — hand off when drained
+
     bool eventFilter(QObject* obj, QEvent* event) override;
 };
 
@@ -0,0 +1,52 @@
+#include "StartupTrace.h"
+#include <QElapsedTimer>
+#include <QList>
+#include <QPair>
+#include <QDebug>
+
+namespace {
+struct TraceState {
+    bool enabled = false;
+    bool finished = false;
+    QElapsedTimer clock;
+    QList<QPair<QString, qint64>> marks;  // label, µs since start
+};
+
+TraceState& state() {
+    static TraceState s;
+    return s;
+}
+}
+
+void StartupTrace::start() {
+    TraceState& s = state();
+    s.enabled = !qEnvironmentVariableIsEmpty("FFAB_STARTUP_TRACE");
+    if (s.enabled) s.clock.start();
+}
+
+bool StartupTrace::enabled() {
+    return state().enabled;
+}
+
+void StartupTrace::mark(const QString& label) {
+    TraceState& s = state();
+    if (!s.enabled || s.finished) return;
+    s.marks.append({label, s.clock.nsecsElapsed() / 1000});
+}
+
+void StartupTrace::finish() {
+    TraceState& s = state();
+    if (!s.enabled || s.finished) return;
+    mark("first event loop turn");
+    s.finished = true;
+
+    // qInfo — QT_NO_DEBUG_OUTPUT silences qDebug in release builds
+    qint64 previous = 0;
+    for (const auto& m : s.marks) {
+        qInfo().noquote() << QString("[startup] %1 ms  (+%2 ms)  %3")
+                                 .arg(m.second / 1000.0, 8, 'f', 1)
+                                 .arg((m.second - previous) / 1000.0, 7, 'f', 1)
+                                 .arg(m.first);
+        previous = m.second;
+    }
+}
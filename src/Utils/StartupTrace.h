@@ -0,0 +1,18 @@
+#pragma once
+#include <QString>
+
+/**
+ * StartupTrace - Cold start timing, enabled with FFAB_STARTUP_TRACE=1
+ *
+ * main() starts the clock, startup phases call mark(), and finish() prints
+ * one line per phase (time since start and since the previous mark) once
+ * the first event loop turn has painted the window. Disabled, every call is
+ * a single flag check.
+ */
+class StartupTrace {
+public:
+    static void start();
+    static void mark(const QString& label);
+    static void finish();
+    static bool enabled();
+};
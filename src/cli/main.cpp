@@ -0,0 +1,598 @@
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLockFile>
+#include <QSet>
+#include <QTextStream>
+#include <QTimer>
+#include <atomic>
+#include <csignal>
+#include <memory>
+#include "Core/AppConfig.h"
+#include "Core/AudioFileScanner.h"
+#include "Core/BatchProcessor.h"
+#include "Core/FFmpegDetector.h"
+#include "Core/FilterChain.h"
+#include "Core/JobListBuilder.h"
+#include "Core/ProjectArchive.h"
+#include "Filters/AudioInputFilter.h"
+#include "Filters/MultiOutputFilter.h"
+#include "Filters/OutputFilter.h"
+
+/**
+ * ffab-cli - Command-line batch runner
+ *
+ * Loads a .ffabjson preset or .ffabproj project (the files PresetManager
+ * saves), expands it with JobListBuilder and runs the jobs through
+ * BatchProcessor — the same commands, worker pool, log file, analysis CSV
+ * and metrics export as a batch started from the app.
+ *
+ *   ffab-cli preset.ffabjson -i ~/in -o ~/out -a cartesian --aux1 ~/irs -j 8
+ *
+ * Needs the Qt Widgets libraries like the app, since filters still build
+ * their parameter widgets; it never opens a window (offscreen platform).
+ *
+ * Cron-friendly: never prompts, holds a lock file in the output folder so
+ * overlapping runs exit early, and --shard i/N splits the main files across
+ * machines (files sorted by path, every N-th file from i). --subfolders
+ * spreads one run's outputs over subfolders of the output folder.
+ *
+ * Exit codes: 0 all jobs succeeded, 1 usage / preset error, 2 some jobs
+ * failed, 3 another run holds the lock, 4 stopped on low disk space
+ * (outputs finished so far are kept), 130 interrupted.
+ */
+
+namespace {
+
+enum ExitCode {
+    ExitOk = 0,
+    ExitUsage = 1,
+    ExitJobsFailed = 2,
+    ExitLocked = 3,
+    ExitDiskSpace = 4,
+    ExitInterrupted = 130
+};
+
+std::atomic<bool> g_interrupted{false};
+
+void onSignal(int) {
+    g_interrupted = true;
+}
+
+QTextStream& out() {
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+QTextStream& err() {
+    static QTextStream stream(stderr);
+    return stream;
+}
+
+bool parseSharding(const QString& name, OutputLayout::Sharding* sharding) {
+    static const QHash<QString, OutputLayout::Sharding> names = {
+        {"none",  OutputLayout::Sharding::None},
+        {"main",  OutputLayout::Sharding::MainName},
+        {"aux",   OutputLayout::Sharding::AuxName},
+        {"hash",  OutputLayout::Sharding::HashPrefix},
+        {"count", OutputLayout::Sharding::Count},
+    };
+    auto it = names.constFind(name.toLower());
+    if (it == names.constEnd()) return false;
+    *sharding = it.value();
+    return true;
+}
+
+bool parseAlgorithm(const QString& name, JobListBuilder::Algorithm* algorithm) {
+    static const QHash<QString, JobListBuilder::Algorithm> names = {
+        {"sequential",       JobListBuilder::Algorithm::Sequential},
+        {"iterate",          JobListBuilder::Algorithm::Iterate},
+        {"zip",              JobListBuilder::Algorithm::Zip},
+        {"broadcast-fixed",  JobListBuilder::Algorithm::BroadcastFixed},
+        {"broadcast-random", JobListBuilder::Algorithm::BroadcastRandom},
+        {"cartesian",        JobListBuilder::Algorithm::Cartesian},
+        {"cartesian-triple", JobListBuilder::Algorithm::CartesianTriple},
+    };
+    auto it = names.constFind(name.toLower());
+    if (it == names.constEnd()) return false;
+    *algorithm = it.value();
+    return true;
+}
+
+FileListWidget::AudioFileInfo fileInfoFor(const QString& path, bool probe, const QString& ffprobePath) {
+    if (probe) return AudioFileScanner::extractMetadata(path, ffprobePath);
+
+    // Same defaults PresetManager uses for unscanned files
+    FileListWidget::AudioFileInfo info;
+    info.filePath = path;
+    info.fileName = QFileInfo(path).fileName();
+    info.format = QFileInfo(path).suffix().toUpper();
+    info.duration = "00:00:00";
+    info.sampleRate = 0;
+    info.bitsPerSample = 0;
+    info.channels = 0;
+    info.bitrate = 0;
+    info.enabled = true;
+    return info;
+}
+
+// Files and folders given on the command line. Folders are scanned
+// recursively and sorted so shards are stable between runs.
+QList<FileListWidget::AudioFileInfo> collectFiles(const QStringList& paths, bool probe,
+                                                  const QString& ffprobePath) {
+    QStringList filePaths;
+    for (const QString& path : paths) {
+        QFileInfo fi(path);
+        if (fi.isDir()) {
+            QStringList found;
+            QDirIterator it(path, AudioFileScanner::getSupportedExtensions(),
+                            QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext()) found.append(it.next());
+            found.sort();
+            filePaths.append(found);
+        } else if (fi.exists()) {
+            filePaths.append(fi.absoluteFilePath());
+        } else {
+            err() << "ffab-cli: Skipping missing file " << path << "\n";
+        }
+    }
+
+    QList<FileListWidget::AudioFileInfo> files;
+    for (const QString& path : filePaths) {
+        files.append(fileInfoFor(path, probe, ffprobePath));
+    }
+    return files;
+}
+
+// Enabled files of a preset "file_lists" array. Entries whose stored
+// metadata still matches the file on disk are not probed again.
+QList<FileListWidget::AudioFileInfo> presetFiles(const QJsonArray& array, bool probe,
+                                                 const QString& ffprobePath) {
+    QList<FileListWidget::AudioFileInfo> files;
+    for (const auto& val : array) {
+        QJsonObject fileObj = val.toObject();
+        if (!fileObj["enabled"].toBool()) continue;
+        AudioFileScanner::PresetEntry entry = AudioFileScanner::fromPresetEntry(fileObj);
+        if (!entry.exists) {
+            err() << "ffab-cli: Skipping missing file " << entry.info.filePath << "\n";
+            continue;
+        }
+        files.append(entry.fresh ? entry.info : fileInfoFor(entry.info.filePath, probe, ffprobePath));
+    }
+    return files;
+}
+
+// Explicit mutes from the preset → main chain positions, and stamp every
+// filter (sub-chains included) the way FilterChainWidget does
+QList<int> applyMutes(FilterChain& chain, const QJsonObject& muteSolo) {
+    QJsonArray mutedArray = muteSolo.contains("muted_filter_ids")
+        ? muteSolo["muted_filter_ids"].toArray()
+        : muteSolo["muted_positions"].toArray();  // legacy key, also holds IDs
+    QSet<int> mutedIds;
+    for (const auto& val : mutedArray) mutedIds.insert(val.toInt());
+
+    if (!muteSolo["solo_filter_ids"].toArray().isEmpty()) {
+        err() << "ffab-cli: Solo states are ignored — only explicit mutes apply\n";
+    }
+
+    QList<int> mutedPositions;
+    for (int pos = 0; pos < chain.filterCount(); ++pos) {
+        auto filter = chain.getFilter(pos);
+        if (!filter) continue;
+
+        bool muted = mutedIds.contains(filter->getFilterId());
+        filter->setEffectivelyMuted(muted);
+        if (muted) mutedPositions.append(pos);
+
+        if (auto* multiOut = dynamic_cast<MultiOutputFilter*>(filter.get())) {
+            for (int s = 1; s <= multiOut->getNumOutputStreams(); s++) {
+                for (const auto& subFilter : multiOut->getSubChain(s)) {
+                    if (subFilter) subFilter->setEffectivelyMuted(mutedIds.contains(subFilter->getFilterId()));
+                }
+            }
+        }
+    }
+    return mutedPositions;
+}
+
+QString formatSeconds(double seconds) {
+    if (seconds < 0) return "--:--:--";
+    int total = static_cast<int>(seconds + 0.5);
+    return QString("%1:%2:%3")
+        .arg(total / 3600, 2, 10, QChar('0'))
+        .arg((total / 60) % 60, 2, 10, QChar('0'))
+        .arg(total % 60, 2, 10, QChar('0'));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    // Filters still create QWidgets for their parameter panels; nothing is
+    // ever shown, so run without a display server
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    // Same settings scope as the app: concurrency, log and metrics options
+    app.setOrganizationDomain("disuye");
+    app.setOrganizationName("disuye");
+    app.setApplicationName("FFAB");
+    app.setApplicationVersion(VERSION_STR);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("FFAB command-line batch runner");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("preset", "Preset (.ffabjson) or project (.ffabproj) with the filter chain.");
+
+    QCommandLineOption inputOption({"i", "input"},
+        "Main input file or folder (repeatable). Default: the preset's main file list.", "path");
+    QCommandLineOption aux1Option("aux1",
+        "Files for the first AudioInput (repeatable). Default: the preset's list.", "path");
+    QCommandLineOption aux2Option("aux2",
+        "Files for the second AudioInput (repeatable). Default: the preset's list.", "path");
+    QCommandLineOption outputOption({"o", "output"},
+        "Output folder. Default: the preset's OUTPUT folder.", "folder");
+    QCommandLineOption algorithmOption({"a", "algorithm"},
+        "sequential, iterate, zip, broadcast-fixed, broadcast-random, cartesian, "
+        "cartesian-triple. Default: sequential.", "name", "sequential");
+    QCommandLineOption zipOption("zip-mismatch",
+        "Zip with unequal lists: truncate, cycle or random. Default: truncate.", "mode", "truncate");
+    QCommandLineOption repeatsOption("repeats",
+        "Iterate: passes per file.", "count", QString::number(JobListBuilder::ITERATE_DEFAULT_REPEATS));
+    QCommandLineOption gainOption("gain",
+        "Iterate: gain per pass in dB.", "dB", QString::number(JobListBuilder::ITERATE_DEFAULT_GAIN_DB));
+    QCommandLineOption subfoldersOption("subfolders",
+        "Output subfolders: none, main (per main file), aux (per aux file), hash "
+        "(256 by name hash) or count (--files-per-folder each). Default: none.", "mode", "none");
+    QCommandLineOption filesPerFolderOption("files-per-folder",
+        "Outputs per subfolder with --subfolders count.", "count", "1000");
+    QCommandLineOption jobsOption({"j", "jobs"},
+        "Parallel FFmpeg processes. Default: the app's Max Concurrent setting.", "count");
+    QCommandLineOption shardOption("shard",
+        "Process only shard i of N (1-based) of the main files.", "i/N");
+    QCommandLineOption ffmpegOption("ffmpeg", "Path to ffmpeg. Default: auto-detect.", "path");
+    QCommandLineOption noProbeOption("no-probe",
+        "Don't read durations with ffprobe (faster start, no duration-based ETA).");
+    QCommandLineOption dryRunOption({"n", "dry-run"}, "Print the FFmpeg commands and exit.");
+    QCommandLineOption quietOption({"q", "quiet"}, "Only print failures and the summary.");
+
+    parser.addOptions({inputOption, aux1Option, aux2Option, outputOption, algorithmOption,
+                       zipOption, repeatsOption, gainOption, subfoldersOption, filesPerFolderOption,
+                       jobsOption, shardOption,
+                       ffmpegOption, noProbeOption, dryRunOption, quietOption});
+    parser.process(app);
+
+    const QStringList positional = parser.positionalArguments();
+    if (positional.size() != 1) {
+        err() << "ffab-cli: Expected exactly one preset file\n";
+        parser.showHelp(ExitUsage);
+    }
+
+    JobListBuilder::Algorithm algorithm;
+    if (!parseAlgorithm(parser.value(algorithmOption), &algorithm)) {
+        err() << "ffab-cli: Unknown algorithm " << parser.value(algorithmOption) << "\n";
+        return ExitUsage;
+    }
+
+    JobListBuilder::ZipMismatch zipMismatch = JobListBuilder::ZipMismatch::Truncate;
+    const QString zipMode = parser.value(zipOption).toLower();
+    if (zipMode == "cycle") {
+        zipMismatch = JobListBuilder::ZipMismatch::Cycle;
+    } else if (zipMode == "random") {
+        zipMismatch = JobListBuilder::ZipMismatch::Random;
+    } else if (zipMode != "truncate") {
+        err() << "ffab-cli: Unknown zip mismatch mode " << zipMode << "\n";
+        return ExitUsage;
+    }
+
+    OutputLayout layout;
+    if (!parseSharding(parser.value(subfoldersOption), &layout.sharding)) {
+        err() << "ffab-cli: Unknown subfolder mode " << parser.value(subfoldersOption) << "\n";
+        return ExitUsage;
+    }
+    layout.filesPerFolder = qMax(1, parser.value(filesPerFolderOption).toInt());
+
+    int shardIndex = 0;
+    int shardCount = 1;
+    if (parser.isSet(shardOption)) {
+        QStringList parts = parser.value(shardOption).split('/');
+        bool okIndex = false, okCount = false;
+        if (parts.size() == 2) {
+            shardIndex = parts[0].toInt(&okIndex) - 1;
+            shardCount = parts[1].toInt(&okCount);
+        }
+        if (!okIndex || !okCount || shardCount < 1 || shardIndex < 0 || shardIndex >= shardCount) {
+            err() << "ffab-cli: --shard expects i/N with 1 <= i <= N\n";
+            return ExitUsage;
+        }
+    }
+
+    const bool quiet = parser.isSet(quietOption);
+    const bool probe = !parser.isSet(noProbeOption);
+
+    // ========== FFMPEG ==========
+
+    QString ffmpegPath;
+    QString ffprobePath;
+    if (parser.isSet(ffmpegOption)) {
+        ffmpegPath = parser.value(ffmpegOption);
+        QString probeCandidate = QFileInfo(ffmpegPath).absolutePath() + "/ffprobe";
+        ffprobePath = QFile::exists(probeCandidate) ? probeCandidate : FFmpegDetector::findExecutable("ffprobe");
+    } else {
+        auto paths = FFmpegDetector::detect();
+        ffmpegPath = paths.ffmpeg;
+        ffprobePath = paths.ffprobe;
+    }
+    if (ffmpegPath.isEmpty() || !QFile::exists(ffmpegPath)) {
+        err() << "ffab-cli: FFmpeg not found — pass --ffmpeg\n";
+        return ExitUsage;
+    }
+    if (ffprobePath.isEmpty()) ffprobePath = "ffprobe";
+
+    // ========== PRESET ==========
+
+    QJsonObject preset;
+    if (ProjectArchive::isArchive(positional.first())) {
+        QString archiveError;
+        if (!ProjectArchive::readAsJson(positional.first(), &preset, &archiveError)) {
+            err() << "ffab-cli: Invalid project: " << archiveError << "\n";
+            return ExitUsage;
+        }
+    } else {
+        QFile presetFile(positional.first());
+        if (!presetFile.open(QIODevice::ReadOnly)) {
+            err() << "ffab-cli: Cannot open preset " << presetFile.fileName() << "\n";
+            return ExitUsage;
+        }
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(presetFile.readAll(), &parseError);
+        if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+            err() << "ffab-cli: Invalid preset: " << parseError.errorString() << "\n";
+            return ExitUsage;
+        }
+        preset = doc.object();
+    }
+
+    auto filterChain = std::make_shared<FilterChain>();
+    if (!preset.contains("filter_chain") || !filterChain->fromJSON(preset["filter_chain"].toObject())) {
+        err() << "ffab-cli: Preset has no usable filter chain\n";
+        return ExitUsage;
+    }
+    filterChain->updateAudioInputIndices();
+    filterChain->updateMultiInputFilterIndices();
+    const QList<int> mutedPositions = applyMutes(*filterChain, preset["mute_solo_states"].toObject());
+
+    auto* output = dynamic_cast<OutputFilter*>(filterChain->getFilter(filterChain->filterCount() - 1).get());
+    if (output && parser.isSet(outputOption)) {
+        output->setOutputFolder(QDir(parser.value(outputOption)).absolutePath());
+    }
+    const QString outputFolder = output ? output->getOutputFolder() : QString();
+    if (outputFolder.isEmpty()) {
+        err() << "ffab-cli: No output folder — set one in the preset or pass --output\n";
+        return ExitUsage;
+    }
+    if (!QDir().mkpath(outputFolder)) {
+        err() << "ffab-cli: Cannot create output folder " << outputFolder << "\n";
+        return ExitUsage;
+    }
+
+    // ========== FILE LISTS ==========
+
+    const QJsonObject fileLists = preset["file_lists"].toObject();
+    const QJsonObject presetAuxLists = fileLists["audio_inputs"].toObject();
+
+    QList<FileListWidget::AudioFileInfo> mainFiles = parser.isSet(inputOption)
+        ? collectFiles(parser.values(inputOption), probe, ffprobePath)
+        : presetFiles(fileLists["main_files"].toArray(), probe, ffprobePath);
+
+    if (shardCount > 1) {
+        QList<FileListWidget::AudioFileInfo> shard;
+        for (int i = shardIndex; i < mainFiles.size(); i += shardCount) shard.append(mainFiles[i]);
+        mainFiles = shard;
+    }
+    if (mainFiles.isEmpty()) {
+        err() << "ffab-cli: No main input files\n";
+        return ExitUsage;
+    }
+
+    auto audioInputs = filterChain->getAllAudioInputFilters();
+    QList<QList<FileListWidget::AudioFileInfo>> auxLists;
+    for (size_t n = 0; n < audioInputs.size(); ++n) {
+        const QCommandLineOption* auxOption = n == 0 ? &aux1Option : n == 1 ? &aux2Option : nullptr;
+        if (auxOption && parser.isSet(*auxOption)) {
+            auxLists.append(collectFiles(parser.values(*auxOption), probe, ffprobePath));
+        } else {
+            QString key = QString::number(audioInputs[n]->getInputIndex());
+            auxLists.append(presetFiles(presetAuxLists[key].toArray(), probe, ffprobePath));
+        }
+    }
+
+    // Baseline sidechain files: first enabled file of each AudioInput
+    QStringList baseSidechainFiles;
+    for (const auto& list : auxLists) {
+        baseSidechainFiles.append(list.isEmpty() ? QString() : list.first().filePath);
+    }
+
+    QList<FileListWidget::AudioFileInfo> aux1Files = auxLists.value(0);
+    QList<FileListWidget::AudioFileInfo> aux2Files = auxLists.value(1);
+    int aux1InputIndex = audioInputs.size() >= 1 ? audioInputs[0]->getInputIndex() : 1;
+    int aux2InputIndex = audioInputs.size() >= 2 ? audioInputs[1]->getInputIndex() : 2;
+
+    // ========== JOBS ==========
+
+    QList<BatchProcessor::JobInfo> jobs;
+    switch (algorithm) {
+        case JobListBuilder::Algorithm::Sequential:
+            jobs = JobListBuilder::buildSequential(
+                mainFiles, outputFolder, filterChain, mutedPositions, baseSidechainFiles, layout);
+            break;
+
+        case JobListBuilder::Algorithm::Zip:
+            jobs = JobListBuilder::buildZip(
+                mainFiles, aux1Files, aux1InputIndex, outputFolder,
+                filterChain, mutedPositions, baseSidechainFiles, zipMismatch, layout);
+            break;
+
+        case JobListBuilder::Algorithm::BroadcastFixed:
+            jobs = JobListBuilder::buildBroadcastFixed(
+                mainFiles, baseSidechainFiles.value(0), aux1InputIndex, outputFolder,
+                filterChain, mutedPositions, baseSidechainFiles, layout);
+            break;
+
+        case JobListBuilder::Algorithm::BroadcastRandom:
+            jobs = JobListBuilder::buildBroadcastRandom(
+                mainFiles, aux1Files, aux1InputIndex, outputFolder,
+                filterChain, mutedPositions, baseSidechainFiles, layout);
+            break;
+
+        case JobListBuilder::Algorithm::Cartesian:
+            jobs = JobListBuilder::buildCartesian(
+                mainFiles, aux1Files, aux1InputIndex, outputFolder,
+                filterChain, mutedPositions, baseSidechainFiles, layout);
+            break;
+
+        case JobListBuilder::Algorithm::CartesianTriple:
+            jobs = JobListBuilder::buildCartesianTriple(
+                mainFiles, aux1Files, aux2Files,
+                aux1InputIndex, aux2InputIndex, outputFolder,
+                filterChain, mutedPositions, baseSidechainFiles, layout);
+            break;
+
+        case JobListBuilder::Algorithm::Iterate:
+            jobs = JobListBuilder::buildIterate(
+                mainFiles,
+                qBound(JobListBuilder::ITERATE_MIN_REPEATS, parser.value(repeatsOption).toInt(),
+                       JobListBuilder::ITERATE_MAX_REPEATS),
+                qBound(JobListBuilder::ITERATE_MIN_GAIN_DB, parser.value(gainOption).toDouble(),
+                       JobListBuilder::ITERATE_MAX_GAIN_DB),
+                outputFolder, filterChain, mutedPositions, baseSidechainFiles, layout);
+            break;
+    }
+
+    if (jobs.isEmpty()) {
+        err() << "ffab-cli: No jobs — check the input and AudioInput file lists for this algorithm\n";
+        return ExitUsage;
+    }
+
+    JobListBuilder::setExpectedOutputSizes(jobs, filterChain);
+    JobListBuilder::setBranchOutputPaths(jobs, filterChain, mutedPositions);
+    jobs = JobListBuilder::addLoudnormMeasurePasses(jobs, filterChain, mutedPositions);
+
+    int outputCount = 0;
+    for (const auto& job : jobs) {
+        if (!job.isMeasurement) outputCount += 1 + job.extraOutputPaths.size();
+    }
+    QString warning = JobListBuilder::validateOutputCount(outputCount);
+    if (warning.contains("exceeds the hard limit")) {
+        err() << "ffab-cli: " << warning << "\n";
+        return ExitUsage;
+    }
+
+    if (parser.isSet(dryRunOption)) {
+        for (const auto& job : jobs) {
+            out() << ffmpegPath << " " << job.command << "\n";
+        }
+        return ExitOk;
+    }
+
+    // ========== RUN ==========
+
+    // One run per output folder and shard — a cron job that overruns its
+    // interval must not start a second pass over the same files
+    QString lockName = shardCount > 1
+        ? QString("_FFAB_cli_%1of%2.lock").arg(shardIndex + 1).arg(shardCount)
+        : QString("_FFAB_cli.lock");
+    QLockFile lock(QDir(outputFolder).filePath(lockName));
+    lock.setStaleLockTime(0);
+    if (!lock.tryLock(0)) {
+        err() << "ffab-cli: Another run is using " << outputFolder << "\n";
+        return ExitLocked;
+    }
+
+    BatchProcessor batch;
+    if (parser.isSet(jobsOption)) {
+        batch.setMaxConcurrentOverride(qMax(1, parser.value(jobsOption).toInt()));
+    }
+    batch.setAnalysisFilters(filterChain->hasAnalysisFilters(mutedPositions));
+
+    int exitCode = ExitOk;
+
+    QObject::connect(&batch, &BatchProcessor::fileFinished, &app,
+                     [&](const QString& fileName, bool success, int) {
+        int done = batch.getCompletedFiles() + batch.getFailedFiles();
+        if (!success) {
+            err() << "[" << done << "/" << batch.getTotalFiles() << "] FAILED " << fileName << "\n";
+            err().flush();
+        } else if (!quiet) {
+            out() << "[" << done << "/" << batch.getTotalFiles() << "] " << fileName << "\n";
+            out().flush();
+        }
+    });
+
+    QObject::connect(&batch, &BatchProcessor::logFileCreated, &app, [&](const QString& path) {
+        if (!quiet) out() << "Log: " << path << "\n";
+    });
+    QObject::connect(&batch, &BatchProcessor::analysisResultsCreated, &app, [&](const QString& path) {
+        if (!quiet) out() << "Analysis results: " << path << "\n";
+    });
+    QObject::connect(batch.metrics(), &BatchMetrics::exportFileCreated, &app, [&](const QString& path) {
+        if (!quiet) out() << "Metrics: " << path << "\n";
+    });
+
+    QObject::connect(&batch, &BatchProcessor::allFinished, &app, [&](int completed, int failed) {
+        BatchMetricsSnapshot s = batch.metrics()->snapshot();
+        out() << completed << " succeeded, " << failed << " failed in "
+              << formatSeconds(s.elapsedSec);
+        if (s.realtimeFactor > 0.0) out() << " (" << QString::number(s.realtimeFactor, 'f', 1) << "x realtime)";
+        out() << "\n";
+        out().flush();
+        if (exitCode == ExitOk && failed > 0) exitCode = ExitJobsFailed;
+        app.exit(exitCode);
+    });
+
+    QObject::connect(&batch, &BatchProcessor::diskSpaceLow, &app,
+                     [&](const QString& volumePath, qint64 freeBytes, qint64 remainingBytes) {
+        err() << "ffab-cli: Low disk space on " << volumePath << " ("
+              << JobListBuilder::formatBytes(freeBytes) << " free, "
+              << JobListBuilder::formatBytes(remainingBytes) << " still to write) — stopping\n";
+        err().flush();
+        exitCode = ExitDiskSpace;
+    });
+
+    QObject::connect(&batch, &BatchProcessor::stateChanged, &app, [&](BatchProcessor::State state) {
+        // Nothing resumes a command-line run — stop once the running jobs are done
+        if (state == BatchProcessor::State::Paused) batch.cancel();
+        if (state == BatchProcessor::State::Cancelled) app.exit(exitCode);
+    });
+
+    // Signal handlers only set a flag; cancel from the event loop
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    QTimer signalPoll;
+    QObject::connect(&signalPoll, &QTimer::timeout, &app, [&]() {
+        if (!g_interrupted) return;
+        signalPoll.stop();
+        err() << "ffab-cli: Interrupted — cancelling\n";
+        exitCode = ExitInterrupted;
+        batch.cancel();
+        app.exit(exitCode);
+    });
+    signalPoll.start(200);
+
+    if (!quiet) {
+        out() << "FFAB " << VERSION_STR << " — " << jobs.size() << " jobs, "
+              << outputCount << " output files → " << outputFolder << "\n";
+        out().flush();
+    }
+
+    QTimer::singleShot(0, &app, [&]() { batch.start(jobs, ffmpegPath, outputFolder); });
+    return app.exec();
+}
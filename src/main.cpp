@@ -1,9 +1,14 @@
 #include <QApplication>
 #include <QFontDatabase>
+#include <QSettings>
+#include <QTimer>
 #include "UI/MainWindow.h"
+#include "Utils/StartupTrace.h"
 
 int main(int argc, char* argv[]) {
+    StartupTrace::start();
     QApplication app(argc, argv);
+    StartupTrace::mark("QApplication");
 
     app.setOrganizationDomain("disuye");
     app.setOrganizationName("disuye");
@@ -11,8 +16,13 @@ int main(int argc, char* argv[]) {
     app.setApplicationVersion(VERSION_STR);
     app.setApplicationDisplayName("FFmpeg Audio Batch");
 
-    // Register embedded Fira Code font with Qt
-    QFontDatabase::addApplicationFont(":/fonts/FiraCode-VariableFont_wght.ttf");
+    // Register embedded Fira Code font with Qt — in fast startup mode only
+    // once the window is up (see below)
+    const bool fastStartup = QSettings().value("startup/fastStartup", false).toBool();
+    if (!fastStartup) {
+        QFontDatabase::addApplicationFont(":/fonts/FiraCode-VariableFont_wght.ttf");
+        StartupTrace::mark("Fira Code font");
+    }
 
      // Global Fira Code styling
     QString styleSheet =
@@ -99,9 +109,21 @@ int main(int argc, char* argv[]) {
         "   max-width: 44px;"
         "}";
         app.setStyleSheet(styleSheet);
+    StartupTrace::mark("global stylesheet");
 
     MainWindow window;
+    StartupTrace::mark("MainWindow constructed");
     window.show();
+    StartupTrace::mark("MainWindow shown");
+
+    QTimer::singleShot(0, &app, [&app, fastStartup]() {
+        if (fastStartup) {
+            QFontDatabase::addApplicationFont(":/fonts/FiraCode-VariableFont_wght.ttf");
+            app.setStyleSheet(app.styleSheet());  // re-polish with the real font
+            StartupTrace::mark("Fira Code font (deferred)");
+        }
+        StartupTrace::finish();
+    });
     
     return app.exec();
 }